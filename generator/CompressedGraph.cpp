@@ -1,9 +1,15 @@
 #include "CompressedGraph.hpp"
 
+#include "BaseStates.hpp"
+
 #include <algorithm>
 
 namespace generator {
 size_t CompressedGraph::numClasses() const {
     return std::ranges::max(class_) + 1;
 }
+
+size_t CompressedGraph::inSpace() const {
+    return graph.at(Start).at(class_[space()]).toState;
+}
 } // namespace generator
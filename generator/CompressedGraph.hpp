@@ -21,6 +21,9 @@ struct CompressedGraph {
     std::vector<std::unordered_map<uint8_t, Action>> graph;
 
     size_t numClasses() const;
+    // the state a space takes Start to.  InSpace in a graph from build_graph,
+    // this is where it ended up after minimize_graph.
+    size_t inSpace() const;
 };
 } // namespace generator
 
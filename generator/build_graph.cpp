@@ -49,29 +49,66 @@ void validate_terminator(std::string const& terminator) {
     }
 }
 
+// field keys are words without ':', which ends them, and the terminator has to
+// be a line end twice.
+void validate_fields(Words const& fields, std::string const& terminator) {
+    if (fields.empty()) {
+        return;
+    }
+    for (auto const& [text, info] : fields) {
+        try {
+            validate_words({{text, info}});
+        } catch (InvalidWord const&) {
+            throw InvalidField{text};
+        }
+        if (text.find(':') != std::string::npos) {
+            throw InvalidField{text};
+        }
+    }
+    size_t const half = terminator.size() / 2;
+    if (terminator.size() % 2 != 0 ||
+        terminator.compare(0, half, terminator, half) != 0) {
+        throw InvalidTerminator{terminator};
+    }
+}
+
 // validate all of the inputs
 void validate_inputs(Words const&          words,
                      std::set<char> const& startsGenericWord,
-                     std::string const&    terminator) {
+                     std::string const&    terminator,
+                     Words const&          fields) {
     auto const startsWord = validate_words(words);
     validate_starts_generic_word(startsGenericWord, startsWord);
     validate_terminator(terminator);
+    validate_fields(fields, terminator);
 }
 } // namespace
 
 Graph build_graph(Words const&          words,
                   std::set<char> const& startsGenericWord,
-                  std::string const&    terminator) {
-    validate_inputs(words, startsGenericWord, terminator);
+                  std::string const&    terminator,
+                  bool const            numbers,
+                  Words const&          fields) {
+    validate_inputs(words, startsGenericWord, terminator, fields);
+
+    bool const genericWords = !startsGenericWord.empty();
 
     Graph graph{NumBaseStates};
 
-    graph[Start][space()]         = Action{InSpace, true, {}};
-    graph[InSpace][space()]       = Action{InSpace, true, {}};
-    graph[InDigits][space()]      = Action{InSpace, false, {Number{}}};
-    graph[InGenericWord][space()] = Action{InSpace, false, {GenericWord{}}};
+    graph[Start][space()]   = Action{InSpace, true, {}};
+    graph[InSpace][space()] = Action{InSpace, true, {}};
+    if (numbers) {
+        graph[InDigits][space()] = Action{InSpace, false, {Number{}}};
+    }
+    if (genericWords) {
+        graph[InGenericWord][space()] =
+            Action{InSpace, false, {GenericWord{}}};
+    }
 
     for (auto const d : digit_characters()) {
+        if (!numbers) {
+            break;
+        }
         // get into InDigits
         graph[Start][d]   = Action{InDigits, true, {}};
         graph[InSpace][d] = Action{InDigits, true, {}};
@@ -87,6 +124,9 @@ Graph build_graph(Words const&          words,
 
     // stay in InGenericWord
     for (auto const c : word_characters()) {
+        if (!genericWords) {
+            break;
+        }
         graph[InGenericWord][c] = Action{InGenericWord, false, {}};
     }
 
@@ -134,10 +174,14 @@ Graph build_graph(Words const&          words,
         // except a token may appear immediately before the terminator so we
         // need to get from all of the token states to the terminator state
         graph[InSpace][terminator[0]] = Action{startStemState, true, {}};
-        graph[InDigits][terminator[0]] =
-            Action{startStemState, false, {Number{}}};
-        graph[InGenericWord][terminator[0]] =
-            Action{startStemState, false, {GenericWord{}}};
+        if (numbers) {
+            graph[InDigits][terminator[0]] =
+                Action{startStemState, false, {Number{}}};
+        }
+        if (genericWords) {
+            graph[InGenericWord][terminator[0]] =
+                Action{startStemState, false, {GenericWord{}}};
+        }
         for (auto const& [text, info] : words) {
             graph[stemStates.at(text)][terminator[0]] =
                 Action{startStemState, true, {info}};
@@ -156,10 +200,50 @@ Graph build_graph(Words const&          words,
         graph[previousStemState][terminator.back()] =
             Action{Finished, true, {}};
     }
+
+    if (!fields.empty()) {
+        // after the first line end, either the rest of the terminator or a
+        // key.  the key stems start with the line end so they can't be
+        // confused with the words'.
+        auto const lineEnd   = terminator.substr(0, terminator.size() / 2);
+        auto const lineStart = stemStates.at(lineEnd);
+        // after the ':', skipping spaces
+        size_t const separator = graph.size();
+        graph.emplace_back();
+        size_t const inValue = graph.size();
+        graph.emplace_back();
+
+        for (auto const& [text, info] : fields) {
+            std::string stem          = lineEnd;
+            size_t      previousState = lineStart;
+            for (auto const c : text) {
+                stem += c;
+                size_t const thisStemState = stemState(stem);
+                graph[previousState][c]    = Action{thisStemState, true, {}};
+                previousState              = thisStemState;
+            }
+            graph[previousState][':'] = Action{separator, true, {info}};
+        }
+
+        graph[separator][space()] = Action{separator, true, {}};
+        for (auto const c : word_characters()) {
+            graph[separator][c] = Action{inValue, true, {}};
+            graph[inValue][c]   = Action{inValue, false, {}};
+        }
+        // the value is the rest of the line, spaces and all
+        graph[inValue][space()] = Action{inValue, false, {}};
+        graph[inValue][terminator[0]] = Action{
+            stemStates.at(terminator.substr(0, 1)), false, {GenericWord{}}};
+        graph[inValue]['\0'] = Action{Finished, false, {GenericWord{}}};
+    }
     // and so does null character
-    graph[InSpace]['\0']       = Action{Finished, true, {}};
-    graph[InDigits]['\0']      = Action{Finished, false, {Number{}}};
-    graph[InGenericWord]['\0'] = Action{Finished, false, {GenericWord{}}};
+    graph[InSpace]['\0'] = Action{Finished, true, {}};
+    if (numbers) {
+        graph[InDigits]['\0'] = Action{Finished, false, {Number{}}};
+    }
+    if (genericWords) {
+        graph[InGenericWord]['\0'] = Action{Finished, false, {GenericWord{}}};
+    }
     for (auto const& [text, info] : words) {
         graph[stemStates.at(text)]['\0'] = Action{Finished, true, {info}};
     }
@@ -175,4 +259,7 @@ InvalidStartsGenericWordCharacter::InvalidStartsGenericWordCharacter(char c)
 
 InvalidTerminator::InvalidTerminator(std::string w)
     : BuildGraphInvalidArgument{"Invalid terminator: " + w} {}
+
+InvalidField::InvalidField(std::string w)
+    : BuildGraphInvalidArgument{"Invalid field: " + w} {}
 } // namespace generator
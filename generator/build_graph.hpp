@@ -19,9 +19,24 @@ namespace generator {
 ///
 /// Teminator must be non-empty and may not contain word characters or the
 /// space (32).
+///
+/// If numbers is false, digits don't start a Number token (they're invalid
+/// where a token would start).  Likewise, with no startsGenericWord
+/// characters, there are no GenericWord tokens.  Either way, the base state
+/// for it is left without any transitions.
+///
+/// fields are the keys of Key: value lines that may follow the first line,
+/// e.g., "GET /a\r\nRange: 0-99\r\n\r\n".  Each key follows the rules for
+/// words and may not contain ':'.  The key becomes a token of its own, like a
+/// word, and the value, everything after the ':' and any spaces up to the end
+/// of the line, a GenericWord token.  A value can't be empty.  Fields need a
+/// terminator that's the same line end twice, e.g., "\r\n\r\n", the first
+/// line end is the end of the line and the second the end of the header.
 Graph build_graph(Words const&          words,
                   std::set<char> const& startsGenericWord,
-                  std::string const&    terminator);
+                  std::string const&    terminator,
+                  bool                  numbers = true,
+                  Words const&          fields  = {});
 
 struct BuildGraphInvalidArgument : std::invalid_argument {
     using std::invalid_argument::invalid_argument;
@@ -38,6 +53,10 @@ struct InvalidStartsGenericWordCharacter : BuildGraphInvalidArgument {
 struct InvalidTerminator : BuildGraphInvalidArgument {
     InvalidTerminator(std::string);
 };
+
+struct InvalidField : BuildGraphInvalidArgument {
+    InvalidField(std::string);
+};
 } // namespace generator
 
 #endif // include guard
@@ -1,52 +1,197 @@
 #include "Graph.hpp"
 #include "build_graph.hpp"
 #include "compress_graph.hpp"
+#include "minimize_graph.hpp"
+#include "read_grammar.hpp"
+#include "time_layouts.hpp"
 #include "write_table.hpp"
 
+#include <algorithm>
+#include <cctype>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #ifndef TEST_MODE
+namespace {
+using namespace generator;
+
+// the grammar description in path
+GrammarDescription read_grammar_file(std::filesystem::path const& path) {
+    std::ifstream stream{path};
+    if (!stream) {
+        throw std::runtime_error{"cannot open: " + path.string()};
+    }
+    try {
+        return read_grammar(stream);
+    } catch (GrammarSyntaxError const& e) {
+        throw std::runtime_error{path.string() + ": " + e.what()};
+    }
+}
+
+// one header per line, without the terminator
+std::vector<std::string> read_corpus(std::filesystem::path const& path,
+                                     std::string const&           terminator) {
+    std::ifstream stream{path};
+    if (!stream) {
+        throw std::runtime_error{"cannot open: " + path.string()};
+    }
+    std::vector<std::string> out;
+    for (std::string line; std::getline(stream, line);) {
+        out.push_back(line + terminator);
+    }
+    return out;
+}
+
+// the layout named name.  nullopt means time them all.
+std::optional<TableLayout> parse_layout(std::string const& name) {
+    if (name == "fastest") {
+        return std::nullopt;
+    }
+    for (auto const layout : {TableLayout::Struct,
+                              TableLayout::Packed,
+                              TableLayout::Fused,
+                              TableLayout::Transposed}) {
+        if (name == layout_string(layout)) {
+            return layout;
+        }
+    }
+    throw std::runtime_error{"unknown layout: " + name};
+}
+} // namespace
+
+// generator [options] grammar output
+//
+// reads the grammar description in grammar (see read_grammar) and writes its
+// table to output.  the names of everything written start with grammar's stem
+// and an underscore, e.g., request_action_table_ for request.grammar.
+//
+// --direct: also write the direct coded backend, after the table and sharing
+//     its class map
+// --layout name: the table layout, struct, packed, fused, transposed (the
+//     default), or fastest to time them all against the corpus and write the
+//     fastest.  the header says which in <GRAMMAR>_TABLE_LAYOUT.
+// --corpus file: headers for --layout fastest, one per line.  the grammar's
+//     examples by default.
 int main(int argc, char** argv) try {
-    using namespace generator;
-    if (argc < 2) {
+    bool                                 direct = false;
+    std::optional<TableLayout>           layout = TableLayout::Transposed;
+    std::optional<std::filesystem::path> corpusFile;
+    std::vector<std::string>             args(argv + 1, argv + argc);
+    while (!args.empty() && args.front().starts_with("--")) {
+        std::string const option = args.front();
+        args.erase(args.begin());
+        if (option == "--direct") {
+            direct = true;
+            continue;
+        }
+        if (args.empty()) {
+            throw std::runtime_error{"missing value for " + option};
+        }
+        if (option == "--layout") {
+            layout = parse_layout(args.front());
+        } else if (option == "--corpus") {
+            corpusFile = args.front();
+        } else {
+            throw std::runtime_error{"unknown option: " + option};
+        }
+        args.erase(args.begin());
+    }
+    if (args.size() < 2) {
         throw std::runtime_error{"too few inputs"};
     }
-    if (argc > 2) {
+    if (args.size() > 2) {
         throw std::runtime_error{"too main inputs"};
     }
-    std::filesystem::path const outputFile{argv[1]};
+    std::filesystem::path const grammarFile{args[0]};
+    std::filesystem::path const outputFile{args[1]};
+    std::string const           grammarName = grammarFile.stem().string();
+
+    auto const spec       = read_grammar_file(grammarFile);
+    auto const compressed = compress_graph(build_graph(spec.words,
+                                                       spec.startsGenericWord,
+                                                       spec.terminator,
+                                                       spec.numbers,
+                                                       spec.fields));
+    auto const graph = minimize_graph(compressed);
+    // 2 bytes for each action in the table
+    auto const tableSize = [](CompressedGraph const& g) {
+        return g.graph.size() * g.numClasses() * 2;
+    };
+    std::cout << grammarName << " states: " << compressed.graph.size()
+              << " -> " << graph.graph.size()
+              << ", classes: " << compressed.numClasses() << " -> "
+              << graph.numClasses()
+              << ", table bytes: " << tableSize(compressed) << " -> "
+              << tableSize(graph) << std::endl;
 
-    auto const graph =
-        compress_graph(build_graph({{"GETFILE", {"GetfileToken"}},
-                                    {"GET", {"GetToken"}},
-                                    {"OK", {"OkToken"}},
-                                    {"FILE_NOT_FOUND", {"FileNotFoundToken"}},
-                                    {"ERROR", {"ErrorToken"}},
-                                    {"INVALID", {"InvalidToken"}}},
-                                   {'/'},
-                                   "\r\n\r\n"));
+    if (!layout) {
+        auto const corpus = corpusFile
+                                ? read_corpus(*corpusFile, spec.terminator)
+                                : spec.examples;
+        if (corpus.empty()) {
+            throw std::runtime_error{"nothing to time the layouts with"};
+        }
+        auto const times = time_layouts(graph, corpus);
+        for (auto const& [l, time] : times) {
+            std::cout << layout_string(l) << ": " << time.count() << "ns"
+                      << std::endl;
+        }
+        layout = fastest_layout(times);
+        std::cout << "writing " << layout_string(*layout) << std::endl;
+    }
 
     std::ofstream stream{outputFile};
     if (!stream) {
         throw std::runtime_error{"cannot open: " + outputFile.string()};
     }
 
-    write_table(stream,
-                {.fieldsToWrite     = {FieldNames::ToState,
-                                       FieldNames::RecordReset,
-                                       FieldNames::TokenId},
-                 .genericWordId     = "PathToken",
-                 .numberId          = "SizeToken",
-                 .noTokenId         = "UnknownToken",
-                 .tableType         = "struct Action const",
-                 .tableVariableName = "action_table_",
-                 .classMapType      = "const uint8_t",
-                 .classMapName      = "character_class_"},
-                graph);
+    stream << "// generated from " << grammarFile.filename().string()
+           << " by generator, do not edit" << std::endl;
+
+    std::string const prefix = grammarName + "_";
+    WriteTableConfig  config{.backend           = Backend::Table,
+                             .layout            = *layout,
+                             .fieldsToWrite     = {FieldNames::ToState,
+                                                   FieldNames::RecordReset,
+                                                   FieldNames::TokenId,
+                                                   FieldNames::Record},
+                             .genericWordId     = "PathToken",
+                             .numberId          = "SizeToken",
+                             .noTokenId         = "UnknownToken",
+                             .tableType         = "Action const",
+                             .tableVariableName = prefix + "action_table_",
+                             .classMapType      = "uint8_t const",
+                             .classMapName      = prefix + "character_class_",
+                             .packMacro         = "ACTION",
+                             .runHintType       = "RunHint const",
+                             .runHintName       = prefix + "run_hints_",
+                             .functionName      = prefix + "tok_direct_",
+                             .contextType       = "Tokenizer"};
+    write_table(stream, config, graph);
+    stream << std::endl;
+    // where a literal prefix leaves the tokenizer, as if it had read a space
+    stream << "static uint8_t const " << prefix
+           << "in_space_state_ = " << graph.inSpace() << ";" << std::endl
+           << std::endl;
+    // so the includer can check it reads the table the way it was written,
+    // TableLayout's value
+    std::string macroName = grammarName + "_TABLE_LAYOUT";
+    std::ranges::transform(macroName, macroName.begin(), [](char const c) {
+        return static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    });
+    stream << "#define " << macroName << " " << static_cast<int>(*layout)
+           << " // " << layout_string(*layout) << std::endl
+           << std::endl;
+    if (direct) {
+        config.backend       = Backend::Direct;
+        config.writeClassMap = config.layout == TableLayout::Fused;
+        write_table(stream, config, graph);
+    }
 
     stream.close();
 
@@ -0,0 +1,191 @@
+#include "minimize_graph.hpp"
+
+#include "BaseStates.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <set>
+#include <tuple>
+#include <utility>
+
+namespace generator {
+namespace {
+// every state has an action for every class, missing ones are the invalid
+// action like in the written table.
+Action const invalid{.toState = Invalid};
+
+Action const& action_for(CompressedGraph const& g,
+                         size_t const           state,
+                         uint8_t const          k) {
+    auto const iter = g.graph[state].find(k);
+    return iter == g.graph[state].end() ? invalid : iter->second;
+}
+
+// Token has no ordering so use its index and id to sort them
+std::string token_key(std::optional<Token> const& token) {
+    if (!token) {
+        return {};
+    }
+    std::string out = std::to_string(token->index());
+    if (auto const* word = std::get_if<WordInfo>(&*token)) {
+        out += word->id;
+    }
+    return out;
+}
+
+// what a state does on each class, apart from where it goes
+using Outputs = std::vector<std::pair<bool, std::string>>;
+
+Outputs outputs(CompressedGraph const& g, size_t const state) {
+    Outputs out;
+    for (uint8_t k = 0; k < g.numClasses(); ++k) {
+        auto const& action = action_for(g, state, k);
+        out.emplace_back(action.resetRecording, token_key(action.token));
+    }
+    return out;
+}
+
+// the block of each state after Hopcroft
+std::vector<size_t> equivalent_states(CompressedGraph const& g) {
+    size_t const numStates  = g.graph.size();
+    size_t const numClasses = g.numClasses();
+
+    // start with blocks of states that do the same thing on every class.
+    // Invalid and Finished do nothing at all but are not the same.
+    std::vector<size_t>              blockOf(numStates);
+    std::vector<std::vector<size_t>> blocks;
+    {
+        std::map<std::pair<size_t, Outputs>, size_t> initial;
+        for (size_t state = 0; state < numStates; ++state) {
+            size_t const special =
+                state == Invalid || state == Finished ? state + 1 : 0;
+            auto const [iter, added] = initial.emplace(
+                std::make_pair(special, outputs(g, state)), blocks.size());
+            if (added) {
+                blocks.emplace_back();
+            }
+            blockOf[state] = iter->second;
+            blocks[iter->second].push_back(state);
+        }
+    }
+
+    // the states that go to each state on each class
+    std::vector<std::vector<std::vector<size_t>>> inverse(
+        numClasses, std::vector<std::vector<size_t>>(numStates));
+    for (size_t state = 0; state < numStates; ++state) {
+        for (uint8_t k = 0; k < numClasses; ++k) {
+            inverse[k][action_for(g, state, k).toState].push_back(state);
+        }
+    }
+
+    std::set<std::pair<size_t, uint8_t>> work;
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        for (uint8_t k = 0; k < numClasses; ++k) {
+            work.emplace(b, k);
+        }
+    }
+    while (!work.empty()) {
+        auto const [splitter, k] = *work.begin();
+        work.erase(work.begin());
+
+        // the states that go into splitter on k, by their block
+        std::map<size_t, std::vector<size_t>> into;
+        for (auto const to : blocks[splitter]) {
+            for (auto const from : inverse[k][to]) {
+                into[blockOf[from]].push_back(from);
+            }
+        }
+        for (auto& [b, inside] : into) {
+            if (inside.size() == blocks[b].size()) {
+                continue;
+            }
+            // split b into the states that go into splitter (a new block) and
+            // the rest (b)
+            size_t const newBlock = blocks.size();
+            std::ranges::sort(inside);
+            std::vector<size_t> rest;
+            std::ranges::set_difference(
+                blocks[b], inside, std::back_inserter(rest));
+            blocks[b] = std::move(rest);
+            blocks.push_back(std::move(inside));
+            for (auto const state : blocks[newBlock]) {
+                blockOf[state] = newBlock;
+            }
+            for (uint8_t l = 0; l < numClasses; ++l) {
+                if (work.contains({b, l})) {
+                    work.emplace(newBlock, l);
+                } else if (blocks[newBlock].size() <= blocks[b].size()) {
+                    work.emplace(newBlock, l);
+                } else {
+                    work.emplace(b, l);
+                }
+            }
+        }
+    }
+    return blockOf;
+}
+} // namespace
+
+CompressedGraph minimize_graph(CompressedGraph const& g) {
+    auto const blockOf = equivalent_states(g);
+
+    // number the blocks by their first state so the states keep their order
+    std::vector<size_t>      newState(g.graph.size());
+    std::vector<size_t>      kept;
+    std::map<size_t, size_t> blockState;
+    for (size_t state = 0; state < g.graph.size(); ++state) {
+        auto const [iter, added] =
+            blockState.emplace(blockOf[state], blockState.size());
+        if (added) {
+            kept.push_back(state);
+        }
+        newState[state] = iter->second;
+    }
+    assert(newState[Invalid] == Invalid && newState[Finished] == Finished);
+
+    std::vector<std::unordered_map<uint8_t, Action>> states;
+    for (auto const state : kept) {
+        auto& m = states.emplace_back();
+        for (auto const& [k, action] : g.graph[state]) {
+            Action a  = action;
+            a.toState = newState[a.toState];
+            m.emplace(k, std::move(a));
+        }
+    }
+
+    // classes that now do the same thing from every state.  class 0 stays the
+    // class of characters that nothing uses.
+    using Column    = std::vector<std::tuple<size_t, bool, std::string>>;
+    auto const column = [&](uint8_t const k) {
+        Column out;
+        for (auto const& m : states) {
+            auto const  iter   = m.find(k);
+            auto const& action = iter == m.end() ? invalid : iter->second;
+            out.emplace_back(action.toState,
+                             action.resetRecording,
+                             token_key(action.token));
+        }
+        return out;
+    };
+    std::map<Column, uint8_t> newClasses{{column(0), 0}};
+    std::vector<uint8_t> newClass(g.numClasses());
+    for (uint8_t k = 0; k < g.numClasses(); ++k) {
+        auto const [iter, _] = newClasses.emplace(
+            column(k), static_cast<uint8_t>(newClasses.size()));
+        newClass[k] = iter->second;
+    }
+
+    CompressedGraph out;
+    for (auto const c : all_characters()) {
+        out.class_[c] = newClass[g.class_[c]];
+    }
+    for (auto const& m : states) {
+        auto& cm = out.graph.emplace_back();
+        for (auto const& [k, action] : m) {
+            cm.emplace(newClass[k], action);
+        }
+    }
+    return out;
+}
+} // namespace generator
@@ -0,0 +1,15 @@
+#ifndef generator_minimize_graph_hpp
+#define generator_minimize_graph_hpp
+
+#include "CompressedGraph.hpp"
+
+namespace generator {
+// Merge equivalent states in g (Hopcroft's algorithm) and then any character
+// classes that became the same.  Two states are equivalent if every class
+// resets and finishes the same tokens from both and goes on to equivalent
+// states.  Invalid and Finished are never merged with anything and the states
+// that are left keep their order, so the BaseStates keep their numbers.
+CompressedGraph minimize_graph(CompressedGraph const& g);
+} // namespace generator
+
+#endif // include guard
@@ -0,0 +1,104 @@
+#include "read_grammar.hpp"
+
+#include <sstream>
+
+namespace generator {
+namespace {
+std::string unescape(std::string const& text, size_t const line) {
+    std::string out;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] != '\\') {
+            out += text[i];
+            continue;
+        }
+        if (++i == text.size()) {
+            throw GrammarSyntaxError{line, "escape at the end of " + text};
+        }
+        switch (text[i]) {
+        case 'r':
+            out += '\r';
+            break;
+        case 'n':
+            out += '\n';
+            break;
+        case 't':
+            out += '\t';
+            break;
+        case '\\':
+            out += '\\';
+            break;
+        default:
+            throw GrammarSyntaxError{line, "unknown escape in " + text};
+        }
+    }
+    return out;
+}
+
+// the whitespace separated fields of stream, exactly n of them
+std::vector<std::string> arguments(std::istream&      stream,
+                                   size_t const       n,
+                                   std::string const& directive,
+                                   size_t const       line) {
+    std::vector<std::string> out;
+    for (std::string s; stream >> s;) {
+        out.push_back(s);
+    }
+    if (out.size() != n) {
+        throw GrammarSyntaxError{line,
+                                 directive + " takes " + std::to_string(n) +
+                                     " arguments"};
+    }
+    return out;
+}
+} // namespace
+
+GrammarDescription read_grammar(std::istream& stream) {
+    GrammarDescription       out;
+    bool                     haveTerminator = false;
+    std::vector<std::string> examples;
+    size_t                   lineNumber = 0;
+    for (std::string line; std::getline(stream, line);) {
+        ++lineNumber;
+        std::istringstream lineStream{line};
+        std::string        directive;
+        if (!(lineStream >> directive) || directive.starts_with('#')) {
+            continue;
+        }
+        if (directive == "terminator") {
+            auto const args = arguments(lineStream, 1, directive, lineNumber);
+            out.terminator = unescape(args[0], lineNumber);
+            haveTerminator = true;
+        } else if (directive == "word" || directive == "field") {
+            auto const args = arguments(lineStream, 2, directive, lineNumber);
+            auto& words = directive == "word" ? out.words : out.fields;
+            if (!words.emplace(args[0], WordInfo{args[1]}).second) {
+                throw GrammarSyntaxError{lineNumber, "repeated " + args[0]};
+            }
+        } else if (directive == "generic") {
+            auto const args = arguments(lineStream, 1, directive, lineNumber);
+            out.startsGenericWord.insert(args[0].begin(), args[0].end());
+        } else if (directive == "numbers") {
+            arguments(lineStream, 0, directive, lineNumber);
+            out.numbers = true;
+        } else if (directive == "example") {
+            std::string header;
+            std::getline(lineStream >> std::ws, header);
+            examples.push_back(header);
+        } else {
+            throw GrammarSyntaxError{lineNumber,
+                                     "unknown directive " + directive};
+        }
+    }
+    if (!haveTerminator) {
+        throw GrammarSyntaxError{lineNumber, "no terminator"};
+    }
+    for (auto const& example : examples) {
+        out.examples.push_back(example + out.terminator);
+    }
+    return out;
+}
+
+GrammarSyntaxError::GrammarSyntaxError(size_t const       line,
+                                       std::string const& message)
+    : std::runtime_error{"line " + std::to_string(line) + ": " + message} {}
+} // namespace generator
@@ -0,0 +1,44 @@
+#ifndef generator_read_grammar_hpp
+#define generator_read_grammar_hpp
+
+#include "Graph.hpp"
+
+#include <istream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace generator {
+// what build_graph needs for one grammar, and headers to time it with.
+struct GrammarDescription {
+    Words          words;
+    std::set<char> startsGenericWord;
+    std::string    terminator;
+    bool           numbers = false;
+    Words          fields;
+    // headers with the terminator, for --layout fastest
+    std::vector<std::string> examples;
+};
+
+// read a grammar description, one directive per line.  blank lines and lines
+// starting with # are skipped.
+//
+// terminator text: the terminator.  \r, \n, \t and \\ are escapes.  required.
+// word text id: a word and its token id.
+// generic characters: each of characters starts a generic word.
+// numbers: digits start Number tokens.
+// field key id: a Key: value field and the token id of the key (see
+//     build_graph).
+// example header: a header for timing, the rest of the line without the
+//     terminator.
+//
+// nothing is checked beyond the syntax, build_graph does that.
+GrammarDescription read_grammar(std::istream&);
+
+struct GrammarSyntaxError : std::runtime_error {
+    GrammarSyntaxError(size_t line, std::string const& message);
+};
+} // namespace generator
+
+#endif // include guard
@@ -0,0 +1,58 @@
+#include "run_hints.hpp"
+
+#include "BaseStates.hpp"
+
+namespace generator {
+namespace {
+template <typename T>
+bool finishes(Action const& action) {
+    return action.token && std::holds_alternative<T>(*action.token);
+}
+
+// a state's recording is used by T if it finishes a T or if it moves on
+// without a reset to a state whose recording is used.  go until nothing
+// changes.
+template <typename T>
+void mark_used(CompressedGraph const& g,
+               std::vector<RunHint>&  hints,
+               bool RunHint::*const   used) {
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t state = 0; state < g.graph.size(); ++state) {
+            if (hints[state].*used) {
+                continue;
+            }
+            for (auto const& [_, action] : g.graph[state]) {
+                if (finishes<T>(action) ||
+                    (!action.resetRecording && hints[action.toState].*used)) {
+                    hints[state].*used = true;
+                    changed            = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+} // namespace
+
+std::vector<RunHint> run_hints(CompressedGraph const& g) {
+    std::vector<RunHint> out(g.graph.size());
+    for (size_t state = 0; state < g.graph.size(); ++state) {
+        if (state == Invalid) {
+            continue;
+        }
+        for (auto const c : all_characters()) {
+            auto const iter = g.graph[state].find(g.class_[c]);
+            if (iter != g.graph[state].end() &&
+                iter->second.toState == state &&
+                !iter->second.resetRecording && !iter->second.token) {
+                out[state].characters.set(static_cast<uint8_t>(c));
+            }
+        }
+    }
+
+    mark_used<Number>(g, out, &RunHint::number);
+    mark_used<GenericWord>(g, out, &RunHint::word);
+    return out;
+}
+} // namespace generator
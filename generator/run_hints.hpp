@@ -0,0 +1,33 @@
+#ifndef generator_run_hints_hpp
+#define generator_run_hints_hpp
+
+#include "CompressedGraph.hpp"
+
+#include <bitset>
+#include <vector>
+
+namespace generator {
+// what a tokenizer needs to know to consume runs of characters in bulk instead
+// of going through the table one character at a time.
+struct RunHint {
+    // the characters that go straight back to the state without finishing a
+    // token or resetting recording.  a run of these only needs to be recorded.
+    std::bitset<num_characters> characters;
+
+    // true if the number recorded in this state can end up in a Number token
+    // so a run has to keep the number up to date.
+    bool number = false;
+
+    // true if the characters recorded in this state can end up in a
+    // GenericWord token.
+    bool word = false;
+
+    bool operator==(RunHint const&) const = default;
+};
+
+// one RunHint for each state in g.  Invalid never gets characters, there's
+// nothing to record once invalid.
+std::vector<RunHint> run_hints(CompressedGraph const& g);
+} // namespace generator
+
+#endif // include guard
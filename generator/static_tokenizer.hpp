@@ -0,0 +1,384 @@
+#ifndef generator_static_tokenizer_hpp
+#define generator_static_tokenizer_hpp
+
+#include "BaseStates.hpp"
+#include "build_graph.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A header only, compile time version of build_graph and compress_graph for
+// C++ callers, e.g., tools and tests.  The grammar is a type:
+//
+//     struct RequestGrammar {
+//         static constexpr StaticWord words[] = {{"GETFILE", GetfileToken},
+//                                                {"GET", GetToken}};
+//         static constexpr std::string_view startsGenericWord = "/";
+//         static constexpr std::string_view terminator        = "\r\n\r\n";
+//         static constexpr bool             numbers           = false;
+//         static constexpr int              genericWordId     = PathToken;
+//         static constexpr int              numberId          = SizeToken;
+//         // optional, headers without the terminator that must tokenize
+//         static constexpr std::string_view examples[] = {"GETFILE GET /a"};
+//     };
+//
+// with the same rules as build_graph's arguments, except that there are no
+// fields.  Breaking them, or an example that doesn't tokenize, is a compile
+// error.  static_table<Grammar> is the compressed table and
+// tokenize<Grammar>(text, onToken) runs it, inline.
+namespace generator {
+/// The text of a word and the token id to report for it.
+struct StaticWord {
+    std::string_view text;
+    int              id;
+};
+
+struct StaticAction {
+    uint8_t toState        = Invalid;
+    bool    resetRecording = false;
+    // 0 for none, 1 for a GenericWord, 2 for a Number and 3 + i for
+    // words[i].
+    uint8_t token = 0;
+
+    constexpr bool operator==(StaticAction const&) const = default;
+};
+
+/// actions[state][class_[c]] is what to do with c in state.
+template <size_t NumStates, size_t NumClasses>
+struct StaticTable {
+    std::array<uint8_t, 256>                                    class_;
+    std::array<std::array<StaticAction, NumClasses>, NumStates> actions;
+};
+
+/// A token's id and text.  Words have their word's text, generic words and
+/// numbers the characters they matched.
+struct StaticToken {
+    int              id;
+    std::string_view text;
+
+    constexpr bool operator==(StaticToken const&) const = default;
+};
+
+enum class TokenizeStatus { Unfinished, Finished, Invalid };
+
+struct TokenizeResult {
+    TokenizeStatus status;
+    // characters used, including the last of the terminator or the invalid
+    // one
+    size_t processed;
+
+    constexpr bool operator==(TokenizeResult const&) const = default;
+};
+
+namespace static_detail {
+constexpr uint8_t GenericWordAction = 1;
+constexpr uint8_t NumberAction      = 2;
+constexpr uint8_t FirstWordAction   = 3;
+
+// the constant evaluated versions of characters.hpp's, for the "C" locale
+constexpr bool is_word_character(char const c) {
+    return c > ' ' && c < 127;
+}
+
+constexpr bool is_digit(char const c) {
+    return c >= '0' && c <= '9';
+}
+
+// validate_inputs in build_graph.cpp, but these are compile errors
+template <typename G>
+constexpr void validate() {
+    if (std::size(G::words) > 255 - FirstWordAction) {
+        throw std::length_error{"too many words"};
+    }
+    for (auto const& word : G::words) {
+        if (word.text.empty() || is_digit(word.text[0]) ||
+            !std::ranges::all_of(word.text, is_word_character)) {
+            throw InvalidWord{std::string{word.text}};
+        }
+    }
+    for (auto const c : G::startsGenericWord) {
+        if (!is_word_character(c) || is_digit(c) ||
+            std::ranges::any_of(G::words, [c](StaticWord const& word) {
+                return word.text[0] == c;
+            })) {
+            throw InvalidStartsGenericWordCharacter{c};
+        }
+    }
+    if (G::terminator.empty() ||
+        std::ranges::any_of(G::terminator, is_word_character)) {
+        throw InvalidTerminator{std::string{G::terminator}};
+    }
+}
+
+// like Graph but with every character's action, missing ones go to Invalid
+using DenseGraph = std::vector<std::array<StaticAction, 256>>;
+
+// build_graph, step for step
+template <typename G>
+constexpr DenseGraph build_dense_graph() {
+    validate<G>();
+
+    bool const genericWords = !G::startsGenericWord.empty();
+
+    DenseGraph graph(NumBaseStates);
+    auto const set = [&graph](size_t const  state,
+                              char const    c,
+                              size_t const  toState,
+                              bool const    resetRecording,
+                              uint8_t const token = 0) {
+        graph[state][static_cast<uint8_t>(c)] = {
+            static_cast<uint8_t>(toState), resetRecording, token};
+    };
+
+    set(Start, ' ', InSpace, true);
+    set(InSpace, ' ', InSpace, true);
+    if (G::numbers) {
+        set(InDigits, ' ', InSpace, false, NumberAction);
+        for (char d = '0'; d <= '9'; ++d) {
+            set(Start, d, InDigits, true);
+            set(InSpace, d, InDigits, true);
+            set(InDigits, d, InDigits, false);
+        }
+    }
+    if (genericWords) {
+        set(InGenericWord, ' ', InSpace, false, GenericWordAction);
+        for (auto const c : G::startsGenericWord) {
+            set(Start, c, InGenericWord, true);
+            set(InSpace, c, InGenericWord, true);
+        }
+        for (char c = '!'; c < 127; ++c) {
+            set(InGenericWord, c, InGenericWord, false);
+        }
+    }
+
+    std::vector<std::pair<std::string, size_t>> stemStates;
+    auto const stemState = [&stemStates, &graph](std::string const& s) {
+        for (auto const& [stem, state] : stemStates) {
+            if (stem == s) {
+                return state;
+            }
+        }
+        stemStates.emplace_back(s, graph.size());
+        graph.emplace_back();
+        return graph.size() - 1;
+    };
+
+    std::vector<size_t> wordStates;
+    for (size_t w = 0; w < std::size(G::words); ++w) {
+        std::string_view const text = G::words[w].text;
+        std::string            stem{text[0]};
+        size_t                 previousState = stemState(stem);
+        set(Start, text[0], previousState, true);
+        set(InSpace, text[0], previousState, true);
+        for (size_t i = 1; i < text.size(); ++i) {
+            stem += text[i];
+            size_t const thisStemState = stemState(stem);
+            set(previousState, text[i], thisStemState, true);
+            previousState = thisStemState;
+        }
+        set(previousState, ' ', InSpace, true, FirstWordAction + w);
+        wordStates.push_back(previousState);
+    }
+
+    std::string_view const terminator = G::terminator;
+    std::string            stem{terminator[0]};
+    size_t const           startStemState = stemState(stem);
+    set(InSpace, terminator[0], startStemState, true);
+    if (G::numbers) {
+        set(InDigits, terminator[0], startStemState, false, NumberAction);
+    }
+    if (genericWords) {
+        set(InGenericWord,
+            terminator[0],
+            startStemState,
+            false,
+            GenericWordAction);
+    }
+    for (size_t w = 0; w < wordStates.size(); ++w) {
+        set(wordStates[w],
+            terminator[0],
+            startStemState,
+            true,
+            FirstWordAction + w);
+    }
+    size_t previousStemState = startStemState;
+    for (size_t i = 1; i < terminator.size() - 1; ++i) {
+        stem += terminator[i];
+        size_t const thisStemState = stemState(stem);
+        set(previousStemState, terminator[i], thisStemState, true);
+        previousStemState = thisStemState;
+    }
+    set(previousStemState, terminator.back(), Finished, true);
+
+    set(InSpace, '\0', Finished, true);
+    if (G::numbers) {
+        set(InDigits, '\0', Finished, false, NumberAction);
+    }
+    if (genericWords) {
+        set(InGenericWord, '\0', Finished, false, GenericWordAction);
+    }
+    for (size_t w = 0; w < wordStates.size(); ++w) {
+        set(wordStates[w], '\0', Finished, true, FirstWordAction + w);
+    }
+
+    if (graph.size() > 256) {
+        throw std::length_error{"too many states"};
+    }
+    return graph;
+}
+
+struct Classes {
+    std::array<uint8_t, 256> class_{};
+    // a character of each class
+    std::vector<uint8_t> representatives;
+};
+
+// compress_graph: characters that every state treats the same share a class,
+// numbered in order of their first character.
+constexpr Classes character_classes(DenseGraph const& graph) {
+    Classes    out;
+    auto const same = [&graph](size_t const a, size_t const b) {
+        return std::ranges::all_of(graph, [a, b](auto const& actions) {
+            return actions[a] == actions[b];
+        });
+    };
+    for (size_t c = 0; c < 256; ++c) {
+        auto const iter = std::ranges::find_if(
+            out.representatives, [&](uint8_t const r) { return same(r, c); });
+        out.class_[c]   = static_cast<uint8_t>(
+            iter - out.representatives.begin());
+        if (iter == out.representatives.end()) {
+            out.representatives.push_back(static_cast<uint8_t>(c));
+        }
+    }
+    return out;
+}
+
+template <typename G>
+constexpr size_t num_states = build_dense_graph<G>().size();
+
+template <typename G>
+constexpr size_t num_classes =
+    character_classes(build_dense_graph<G>()).representatives.size();
+
+template <typename G>
+constexpr auto make_table() {
+    auto const graph   = build_dense_graph<G>();
+    auto const classes = character_classes(graph);
+
+    StaticTable<num_states<G>, num_classes<G>> out{};
+    out.class_ = classes.class_;
+    for (size_t s = 0; s < graph.size(); ++s) {
+        for (size_t k = 0; k < classes.representatives.size(); ++k) {
+            out.actions[s][k] = graph[s][classes.representatives[k]];
+        }
+    }
+    return out;
+}
+} // namespace static_detail
+
+/// The compressed table for Grammar.
+template <typename Grammar>
+inline constexpr auto static_table = static_detail::make_table<Grammar>();
+
+namespace static_detail {
+template <typename G>
+constexpr StaticToken make_token(uint8_t const          token,
+                                 std::string_view const recorded) {
+    switch (token) {
+    case GenericWordAction:
+        return {G::genericWordId, recorded};
+    case NumberAction:
+        return {G::numberId, recorded};
+    default:
+        auto const& word = G::words[token - FirstWordAction];
+        return {word.id, word.text};
+    }
+}
+
+template <typename G, typename OnToken>
+constexpr TokenizeResult run(std::string_view const text, OnToken&& onToken) {
+    auto const& table       = static_table<G>;
+    size_t      state       = Start;
+    size_t      recordStart = 0;
+    auto const  actionAt    = [&table, text](size_t const s, size_t const i) {
+        return table.actions[s][table.class_[static_cast<uint8_t>(text[i])]];
+    };
+    for (size_t i = 0; i < text.size(); ++i) {
+        auto const action = actionAt(state, i);
+        if (action == StaticAction{static_cast<uint8_t>(state)}) {
+            // looping, e.g., in a path.  the characters that keep it looping
+            // don't depend on each other so skip them without the state.
+            while (i + 1 < text.size() && actionAt(state, i + 1) == action) {
+                ++i;
+            }
+            continue;
+        }
+        if (action.token != 0) {
+            onToken(make_token<G>(action.token,
+                                  text.substr(recordStart, i - recordStart)));
+        }
+        if (action.resetRecording) {
+            recordStart = i;
+        }
+        state = action.toState;
+        if (state == Finished) {
+            return {TokenizeStatus::Finished, i + 1};
+        }
+        if (state == Invalid) {
+            return {TokenizeStatus::Invalid, i + 1};
+        }
+    }
+    return {TokenizeStatus::Unfinished, text.size()};
+}
+
+// every example, with the terminator, finishes at its end
+template <typename G>
+consteval bool examples_tokenize() {
+    if constexpr (requires { G::examples; }) {
+        for (std::string_view const example : G::examples) {
+            std::string const header =
+                std::string{example} + std::string{G::terminator};
+            if (run<G>(header, [](StaticToken const&) {}) !=
+                TokenizeResult{TokenizeStatus::Finished, header.size()}) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+} // namespace static_detail
+
+/// Tokenize text with Grammar up to the end of its terminator or an invalid
+/// character, calling onToken(StaticToken) with each token.  A token still
+/// going at the end of text isn't reported.
+template <typename Grammar, typename OnToken>
+constexpr TokenizeResult tokenize(std::string_view const text,
+                                  OnToken&&              onToken) {
+    static_assert(static_detail::examples_tokenize<Grammar>(),
+                  "an example doesn't tokenize");
+    return static_detail::run<Grammar>(text, onToken);
+}
+
+struct StaticTokens {
+    TokenizeResult           result;
+    std::vector<StaticToken> tokens;
+};
+
+/// tokenize, collecting the tokens, e.g., for static_assert.
+template <typename Grammar>
+constexpr StaticTokens tokenize(std::string_view const text) {
+    StaticTokens out;
+    out.result = tokenize<Grammar>(
+        text, [&out](StaticToken const& t) { out.tokens.push_back(t); });
+    return out;
+}
+} // namespace generator
+
+#endif // include guard
@@ -137,3 +137,81 @@ TEST(Graph, WithWords) {
     };
     run_points(a, points);
 }
+
+TEST(Graph, NoNumbers) {
+    std::string const term{"\r\n\r\n"};
+    auto const        g = build_graph({{"GET", {"Get"}}}, {'/'}, term, false);
+    Automaton<Graph>  a{g};
+    EXPECT_TRUE(g[InDigits].empty());
+
+    check_invalidates(
+        a, word_characters() | skip('/') | skip('G') | skip(space()));
+
+    SimplePoint const points[]{
+        {"GET /a1/b2 \r\n\r\n", {{WordInfo{"Get"}, std::string{"/a1/b2"}}}},
+        {"/123\r\n\r\n", {{std::string{"/123"}}}},
+    };
+    run_points(a, points);
+}
+
+TEST(Graph, NoGenericWords) {
+    std::string const term{"\r\n\r\n"};
+    auto const        g = build_graph({{"OK", {"Ok"}}}, {}, term);
+    Automaton<Graph>  a{g};
+    EXPECT_TRUE(g[InGenericWord].empty());
+
+    check_invalidates(a, word_characters() | skip('O') | skip_digits());
+
+    SimplePoint const points[]{
+        {"OK 123\r\n\r\n", {{WordInfo{"Ok"}, size_t{123}}}},
+    };
+    run_points(a, points);
+}
+
+TEST(Graph, Fields) {
+    std::string const term{"\r\n\r\n"};
+    auto const        g = build_graph({{"GET", {"Get"}}},
+                                      {'/'},
+                                      term,
+                                      false,
+                                      {{"Range", {"Range"}}, {"R", {"R"}}});
+    Automaton<Graph>  a{g};
+
+    SimplePoint const points[]{
+        {"GET /a\r\n\r\n", {{WordInfo{"Get"}, std::string{"/a"}}}},
+        {"GET /a\r\nRange: 0-99\r\n\r\n",
+         {{WordInfo{"Get"},
+           std::string{"/a"},
+           WordInfo{"Range"},
+           std::string{"0-99"}}}},
+        // no space, spaces in the value, more than one field
+        {"GET /a\r\nR:x\r\nRange:   GET /b 12 \r\n\r\n",
+         {{WordInfo{"Get"},
+           std::string{"/a"},
+           WordInfo{"R"},
+           std::string{"x"},
+           WordInfo{"Range"},
+           std::string{"GET /b 12 "}}}},
+    };
+    run_points(a, points);
+
+    // unknown keys, a missing ':' or value, fields in the first line
+    for (std::string const input : {"GET /a\r\nRanges: 1\r\n\r\n",
+                                    "GET /a\r\nRange 1\r\n\r\n",
+                                    "GET /a\r\nRange:\r\n\r\n",
+                                    "GET /a\r\nRange: \r\n\r\n",
+                                    "GET Range: 1\r\n\r\n"}) {
+        EXPECT_THROW(tokenize(a, input), std::runtime_error)
+            << to_readable(input);
+    }
+}
+
+TEST(Graph, InvalidFields) {
+    EXPECT_THROW(build_graph({}, {}, "\r\n\r\n", true, {{"A:B", {"A"}}}),
+                 InvalidField);
+    EXPECT_THROW(build_graph({}, {}, "\r\n\r\n", true, {{"", {"A"}}}),
+                 InvalidField);
+    EXPECT_THROW(build_graph({}, {}, "\r\n\r", true, {{"A", {"A"}}}),
+                 InvalidTerminator);
+    EXPECT_NO_THROW(build_graph({}, {}, "\n\n", true, {{"A", {"A"}}}));
+}
@@ -0,0 +1,109 @@
+#include "../BaseStates.hpp"
+#include "../build_graph.hpp"
+#include "../compress_graph.hpp"
+#include "../minimize_graph.hpp"
+#include "Automaton.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace generator;
+using namespace generator::test;
+
+namespace generator {
+// for Automaton, defined in tcompress_graph.cpp
+Action const* action(CompressedGraph const& g, size_t state, char c);
+size_t        num_states(CompressedGraph const& g);
+} // namespace generator
+
+namespace {
+std::string const term{"\r\n\r\n"};
+
+// every step: the token, if any, and whether the automaton is still valid and
+// finished.
+using Trace =
+    std::vector<std::tuple<std::optional<AutomatonToken>, bool, bool>>;
+
+Trace trace(Automaton<CompressedGraph>& a, std::string const& input) {
+    a.reset();
+    Trace out;
+    for (auto const c : input) {
+        auto token = a(c);
+        out.emplace_back(std::move(token), a.valid(), a.finished());
+    }
+    return out;
+}
+
+// random strings of characters from the words, digits, space and the
+// terminator
+void expect_same(CompressedGraph const& original,
+                 CompressedGraph const& minimized,
+                 std::string const&     alphabet) {
+    Automaton<CompressedGraph>            a{original};
+    Automaton<CompressedGraph>            b{minimized};
+    std::mt19937                          gen{1234};
+    std::uniform_int_distribution<size_t> charDist{0, alphabet.size() - 1};
+    std::uniform_int_distribution<size_t> sizeDist{1, 40};
+    for (size_t i = 0; i < 20000; ++i) {
+        std::string input;
+        for (size_t n = sizeDist(gen); input.size() < n;) {
+            input += alphabet[charDist(gen)];
+        }
+        ASSERT_EQ(trace(a, input), trace(b, input)) << to_readable(input);
+    }
+}
+} // namespace
+
+TEST(MinimizeGraph, MergesEquivalentStems) {
+    // AB and CB do the same thing.  A and C don't, C can go on to D.
+    auto const g = compress_graph(build_graph(
+        {{"AB", {"X"}}, {"CB", {"X"}}, {"CD", {"Y"}}}, {'/'}, term));
+    auto const m = minimize_graph(g);
+    EXPECT_EQ(m.graph.size(), g.graph.size() - 1);
+    EXPECT_EQ(m.numClasses(), g.numClasses());
+    expect_same(g, m, "ABCD/ 09x" + term);
+
+    Automaton<CompressedGraph> a{m};
+    SimplePoint const          points[]{
+        {"AB CB CD /a 12" + term,
+                  {{WordInfo{"X"},
+                    WordInfo{"X"},
+                    WordInfo{"Y"},
+                    std::string{"/a"},
+                    size_t{12}}}},
+    };
+    run_points(a, points);
+}
+
+TEST(MinimizeGraph, MergesClasses) {
+    // A and C, and AB and CB, are the same states.  then A and C are the same
+    // class too.
+    auto const g = compress_graph(
+        build_graph({{"AB", {"X"}}, {"CB", {"X"}}}, {'/'}, term));
+    auto const m = minimize_graph(g);
+    EXPECT_EQ(m.graph.size(), g.graph.size() - 2);
+    EXPECT_EQ(m.numClasses(), g.numClasses() - 1);
+    EXPECT_EQ(m.class_['A'], m.class_['C']);
+    expect_same(g, m, "ABCD/ 09x" + term);
+}
+
+TEST(MinimizeGraph, Getfile) {
+    auto const g =
+        compress_graph(build_graph({{"GETFILE", {"Getfile"}},
+                                    {"GET", {"Get"}},
+                                    {"OK", {"Ok"}},
+                                    {"FILE_NOT_FOUND", {"FileNotFound"}},
+                                    {"ERROR", {"Error"}},
+                                    {"INVALID", {"Invalid"}}},
+                                   {'/'},
+                                   term));
+    auto const m = minimize_graph(g);
+    // already minimal, and nothing moves
+    EXPECT_EQ(m.graph.size(), g.graph.size());
+    EXPECT_EQ(m.class_, g.class_);
+    EXPECT_EQ(g.inSpace(), InSpace);
+    EXPECT_EQ(m.inSpace(), InSpace);
+    expect_same(g, m, "GETFILOKNDRV_/ 0129ax" + term);
+}
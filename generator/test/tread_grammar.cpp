@@ -0,0 +1,54 @@
+#include "../read_grammar.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+using namespace generator;
+
+namespace {
+GrammarDescription read(std::string const& text) {
+    std::istringstream stream{text};
+    return read_grammar(stream);
+}
+} // namespace
+
+TEST(ReadGrammar, Directives) {
+    auto const g = read("# a comment\n"
+                        "terminator \\r\\n\\r\\n\n"
+                        "\n"
+                        "word GETFILE GetfileToken\n"
+                        "  word GET GetToken\n"
+                        "generic /~\n"
+                        "numbers\n"
+                        "field Range RangeToken\n"
+                        "example GETFILE GET /a b\n");
+    EXPECT_EQ(g.terminator, "\r\n\r\n");
+    EXPECT_EQ(g.words,
+              (Words{{"GETFILE", {"GetfileToken"}}, {"GET", {"GetToken"}}}));
+    EXPECT_EQ(g.startsGenericWord, (std::set<char>{'/', '~'}));
+    EXPECT_TRUE(g.numbers);
+    EXPECT_EQ(g.fields, (Words{{"Range", {"RangeToken"}}}));
+    EXPECT_EQ(g.examples,
+              std::vector<std::string>{"GETFILE GET /a b\r\n\r\n"});
+
+    auto const bare = read("terminator \\n\n");
+    EXPECT_EQ(bare.terminator, "\n");
+    EXPECT_TRUE(bare.words.empty());
+    EXPECT_FALSE(bare.numbers);
+}
+
+TEST(ReadGrammar, Errors) {
+    for (std::string const text : {"",
+                                   "word GET GetToken\n",
+                                   "terminator\n",
+                                   "terminator \\q\n",
+                                   "terminator \\\n",
+                                   "terminator \\n\nword GET\n",
+                                   "terminator \\n\nword GET A\nword GET B\n",
+                                   "terminator \\n\nnumbers 1\n",
+                                   "terminator \\n\nwords GET A\n"}) {
+        EXPECT_THROW(read(text), GrammarSyntaxError) << text;
+    }
+}
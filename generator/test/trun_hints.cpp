@@ -0,0 +1,70 @@
+#include "../BaseStates.hpp"
+#include "../build_graph.hpp"
+#include "../characters.hpp"
+#include "../compress_graph.hpp"
+#include "../run_hints.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace generator;
+
+namespace {
+CompressedGraph make_graph() {
+    return compress_graph(build_graph({{"GETFILE", {"Getfile"}},
+                                       {"GET", {"Get"}},
+                                       {"OK", {"Ok"}}},
+                                      {'/'},
+                                      "\r\n\r\n"));
+}
+
+std::bitset<num_characters> characters(auto&& range) {
+    std::bitset<num_characters> out;
+    for (auto const c : range) {
+        out.set(static_cast<uint8_t>(c));
+    }
+    return out;
+}
+} // namespace
+
+TEST(RunHints, GenericWord) {
+    auto const hints = run_hints(make_graph());
+    EXPECT_EQ(hints[InGenericWord].characters, characters(word_characters()));
+    EXPECT_FALSE(hints[InGenericWord].number);
+    EXPECT_TRUE(hints[InGenericWord].word);
+}
+
+TEST(RunHints, Digits) {
+    auto const hints = run_hints(make_graph());
+    EXPECT_EQ(hints[InDigits].characters, characters(digit_characters()));
+    // the digits end up in a Number
+    EXPECT_TRUE(hints[InDigits].number);
+    EXPECT_FALSE(hints[InDigits].word);
+}
+
+TEST(RunHints, NoRuns) {
+    auto const hints = run_hints(make_graph());
+    for (auto const state : {Start, Invalid, Finished, InSpace}) {
+        EXPECT_TRUE(hints[state].characters.none()) << state_string(state);
+        EXPECT_FALSE(hints[state].number) << state_string(state);
+        EXPECT_FALSE(hints[state].word) << state_string(state);
+    }
+}
+
+TEST(RunHints, EveryLoop) {
+    auto const g     = make_graph();
+    auto const hints = run_hints(g);
+    ASSERT_EQ(hints.size(), g.graph.size());
+    for (size_t state = 0; state < g.graph.size(); ++state) {
+        for (auto const c : all_characters()) {
+            auto const iter  = g.graph[state].find(g.class_[c]);
+            bool const loops = state != Invalid &&
+                               iter != g.graph[state].end() &&
+                               iter->second.toState == state &&
+                               !iter->second.resetRecording &&
+                               !iter->second.token;
+            EXPECT_EQ(hints[state].characters[static_cast<uint8_t>(c)], loops)
+                << state_string(state) << " " << int{c};
+        }
+    }
+}
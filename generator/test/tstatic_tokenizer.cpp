@@ -0,0 +1,220 @@
+#include "../BaseStates.hpp"
+#include "../build_graph.hpp"
+#include "../compress_graph.hpp"
+#include "../static_tokenizer.hpp"
+#include "characters.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace generator;
+using namespace generator::test;
+
+namespace {
+struct Getfile {
+    enum Id { GetfileId, GetId, OkId, ErrorId, PathId, SizeId };
+
+    static constexpr StaticWord       words[] = {{"GETFILE", GetfileId},
+                                                 {"GET", GetId},
+                                                 {"OK", OkId},
+                                                 {"ERROR", ErrorId}};
+    static constexpr std::string_view startsGenericWord = "/";
+    static constexpr std::string_view terminator        = "\r\n\r\n";
+    static constexpr bool             numbers           = true;
+    static constexpr int              genericWordId     = PathId;
+    static constexpr int              numberId          = SizeId;
+    static constexpr std::string_view examples[]        = {
+        "GETFILE GET /a.txt", "GETFILE OK 2367811", "GETFILE ERROR"};
+};
+
+// no numbers or generic words
+struct Words {
+    static constexpr StaticWord       words[]           = {{"A", 1}, {"AB", 2}};
+    static constexpr std::string_view startsGenericWord = "";
+    static constexpr std::string_view terminator        = "\n";
+    static constexpr bool             numbers           = false;
+    static constexpr int              genericWordId     = -1;
+    static constexpr int              numberId          = -1;
+};
+
+// the checks run by the compiler
+static_assert(tokenize<Getfile>("GETFILE GET /a.txt\r\n\r\nxyz").tokens ==
+              std::vector<StaticToken>{{Getfile::GetfileId, "GETFILE"},
+                                       {Getfile::GetId, "GET"},
+                                       {Getfile::PathId, "/a.txt"}});
+static_assert(tokenize<Getfile>("GETFILE GET /a.txt\r\n\r\nxyz").result ==
+              TokenizeResult{TokenizeStatus::Finished, 22});
+static_assert(tokenize<Getfile>("GETFILE  OK 12\r\n\r\n").tokens ==
+              std::vector<StaticToken>{{Getfile::GetfileId, "GETFILE"},
+                                       {Getfile::OkId, "OK"},
+                                       {Getfile::SizeId, "12"}});
+static_assert(tokenize<Getfile>("GETFILE G0").result ==
+              TokenizeResult{TokenizeStatus::Invalid, 10});
+static_assert(tokenize<Getfile>("GETFILE OK").result ==
+              TokenizeResult{TokenizeStatus::Unfinished, 10});
+static_assert(tokenize<Words>("AB A\n").tokens ==
+              std::vector<StaticToken>{{2, "AB"}, {1, "A"}});
+static_assert(tokenize<Words>("1").result ==
+              TokenizeResult{TokenizeStatus::Invalid, 1});
+
+template <typename G>
+Graph runtime_graph() {
+    generator::Words words;
+    for (auto const& word : G::words) {
+        words.emplace(word.text, WordInfo{std::string{word.text}});
+    }
+    std::set<char> const startsGenericWord{G::startsGenericWord.begin(),
+                                           G::startsGenericWord.end()};
+    return build_graph(
+        words, startsGenericWord, std::string{G::terminator}, G::numbers);
+}
+
+struct Run {
+    TokenizeStatus           status;
+    size_t                   processed;
+    std::vector<std::string> tokens;
+
+    bool operator==(Run const&) const = default;
+};
+
+std::ostream& operator<<(std::ostream& stream, Run const& run) {
+    stream << static_cast<int>(run.status) << " " << run.processed << ":";
+    for (auto const& token : run.tokens) {
+        stream << " " << token;
+    }
+    return stream;
+}
+
+// run text through the runtime graph, like Automaton
+Run run_compressed(CompressedGraph const& g, std::string const& text) {
+    Run         out{TokenizeStatus::Unfinished, text.size(), {}};
+    size_t      state = Start;
+    std::string recorded;
+    for (size_t i = 0; i < text.size(); ++i) {
+        auto const& actions = g.graph[state];
+        auto const  c       = static_cast<uint8_t>(text[i]);
+        auto const  iter    = c < g.class_.size() ? actions.find(g.class_[c])
+                                                  : actions.end();
+        if (iter == actions.end()) {
+            return {TokenizeStatus::Invalid, i + 1, out.tokens};
+        }
+        auto const& action = iter->second;
+        if (action.token) {
+            auto const* info = std::get_if<WordInfo>(&*action.token);
+            out.tokens.push_back(info ? info->id : recorded);
+        }
+        if (action.resetRecording) {
+            recorded.clear();
+        }
+        recorded += text[i];
+        state = action.toState;
+        if (state == Finished) {
+            return {TokenizeStatus::Finished, i + 1, out.tokens};
+        }
+    }
+    return out;
+}
+
+// g's action for c in state like the static table's.  the token as
+// StaticAction::token, from the words' texts, which runtime_graph uses as ids.
+template <typename G>
+StaticAction runtime_action(CompressedGraph const& g,
+                            size_t const           state,
+                            uint8_t const          c) {
+    auto const& actions = g.graph[state];
+    auto const  iter =
+        c < g.class_.size() ? actions.find(g.class_[c]) : actions.end();
+    if (iter == actions.end()) {
+        return StaticAction{};
+    }
+    StaticAction out{
+        .toState        = static_cast<uint8_t>(iter->second.toState),
+        .resetRecording = iter->second.resetRecording};
+    if (auto const& token = iter->second.token; !token) {
+        out.token = 0;
+    } else if (std::holds_alternative<GenericWord>(*token)) {
+        out.token = 1;
+    } else if (std::holds_alternative<Number>(*token)) {
+        out.token = 2;
+    } else {
+        auto const& id = std::get<WordInfo>(*token).id;
+        for (size_t i = 0; i < std::size(G::words); ++i) {
+            if (G::words[i].text == id) {
+                out.token = static_cast<uint8_t>(3 + i);
+            }
+        }
+    }
+    return out;
+}
+
+// every base state does the same with every character in both.  the other
+// states are numbered as each builder goes, so only say whether it's one of
+// them.
+template <typename G>
+void expect_same_base_states() {
+    auto const  g     = compress_graph(runtime_graph<G>());
+    auto const& table = static_table<G>;
+    for (size_t state = 0; state < NumBaseStates; ++state) {
+        for (size_t c = 0; c < 256; ++c) {
+            auto const   expected = runtime_action<G>(g, state, c);
+            StaticAction actual   = table.actions[state][table.class_[c]];
+            if (expected.toState >= NumBaseStates &&
+                actual.toState >= NumBaseStates) {
+                actual.toState = expected.toState;
+            }
+            EXPECT_EQ(actual, expected)
+                << state_string(state) << " "
+                << to_readable(static_cast<char>(c)) << ": "
+                << state_string(actual.toState) << " "
+                << int{actual.token};
+        }
+    }
+}
+
+template <typename G>
+Run run_static(std::string const& text) {
+    Run out;
+    auto const result = tokenize<G>(text, [&out](StaticToken const& token) {
+        out.tokens.emplace_back(token.text);
+    });
+    out.status    = result.status;
+    out.processed = result.processed;
+    return out;
+}
+} // namespace
+
+TEST(StaticTokenizer, SameSizeAsCompressGraph) {
+    auto const g = compress_graph(runtime_graph<Getfile>());
+    EXPECT_EQ(static_table<Getfile>.actions.size(), g.graph.size());
+    EXPECT_EQ(static_table<Getfile>.actions[0].size(), g.numClasses());
+}
+
+TEST(StaticTokenizer, MatchesCompressGraph) {
+    auto const g = compress_graph(runtime_graph<Getfile>());
+
+    using namespace std::literals;
+    std::mt19937                          gen;
+    std::string const                     alphabet = "GETFILOKR/a0 \r\n\0\x80"s;
+    std::uniform_int_distribution<size_t> charDist{0, alphabet.size() - 1};
+    std::uniform_int_distribution<size_t> sizeDist{0, 24};
+    for (size_t i = 0; i < 10000; ++i) {
+        // mostly start right to get past the first token
+        std::string text = i % 2 ? "GETFILE " : "";
+        for (size_t n = sizeDist(gen); n > 0; --n) {
+            text += alphabet[charDist(gen)];
+        }
+        EXPECT_EQ(run_static<Getfile>(text), run_compressed(g, text))
+            << to_readable(text);
+    }
+    for (auto const example : Getfile::examples) {
+        std::string const text = std::string{example} + "\r\n\r\n";
+        EXPECT_EQ(run_static<Getfile>(text), run_compressed(g, text))
+            << to_readable(text);
+    }
+}
+
+TEST(StaticTokenizer, MatchesBuildGraphBaseStates) {
+    expect_same_base_states<Getfile>();
+}
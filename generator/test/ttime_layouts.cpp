@@ -0,0 +1,58 @@
+#include "../build_graph.hpp"
+#include "../compress_graph.hpp"
+#include "../time_layouts.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace generator;
+
+namespace {
+CompressedGraph make_graph() {
+    return compress_graph(build_graph({{"GETFILE", {"Getfile"}},
+                                       {"GET", {"Get"}},
+                                       {"OK", {"Ok"}}},
+                                      {'/'},
+                                      "\r\n\r\n"));
+}
+
+std::vector<std::string> const corpus{"GETFILE GET /a/b/c\r\n\r\n",
+                                      "GETFILE OK 1234\r\n\r\n",
+                                      "GETFILE GOT /a/b/c\r\n\r\n",
+                                      "GET\tOK\r\n\r\n",
+                                      ""};
+
+TableLayout const layouts[] = {TableLayout::Struct,
+                               TableLayout::Packed,
+                               TableLayout::Fused,
+                               TableLayout::Transposed};
+} // namespace
+
+TEST(TimeLayouts, SameRun) {
+    auto const   g        = make_graph();
+    size_t const expected = run_layout(g, TableLayout::Struct, corpus);
+    for (auto const layout : layouts) {
+        EXPECT_EQ(run_layout(g, layout, corpus), expected)
+            << layout_string(layout);
+    }
+    // and the checksum does see the input
+    EXPECT_NE(run_layout(g, TableLayout::Struct, {corpus[0]}),
+              run_layout(g, TableLayout::Struct, {corpus[1]}));
+}
+
+TEST(TimeLayouts, Fastest) {
+    auto const times = time_layouts(make_graph(), corpus, 3);
+    ASSERT_EQ(times.size(), std::size(layouts));
+    for (size_t i = 0; i < times.size(); ++i) {
+        EXPECT_EQ(times[i].layout, layouts[i]);
+    }
+    auto const fastest = fastest_layout(times);
+    for (auto const& [layout, time] : times) {
+        EXPECT_LE(std::ranges::find(times, fastest, &LayoutTime::layout)->time,
+                  time)
+            << layout_string(layout);
+    }
+    EXPECT_EQ(fastest_layout({{TableLayout::Packed, std::chrono::seconds{2}},
+                              {TableLayout::Fused, std::chrono::seconds{1}}}),
+              TableLayout::Fused);
+}
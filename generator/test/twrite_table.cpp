@@ -0,0 +1,68 @@
+#include "../build_graph.hpp"
+#include "../compress_graph.hpp"
+#include "../write_table.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+using namespace generator;
+using testing::HasSubstr;
+using testing::Not;
+
+namespace {
+CompressedGraph make_graph() {
+    return compress_graph(
+        build_graph({{"GET", {"Get"}}, {"OK", {"Ok"}}}, {'/'}, "\r\n\r\n"));
+}
+
+std::string write(TableLayout const layout, CompressedGraph const& g) {
+    std::ostringstream stream;
+    write_table(stream, {.layout = layout}, g);
+    return stream.str();
+}
+
+std::string dims(size_t const rows, size_t const columns) {
+    return "table[" + std::to_string(rows) + "][" + std::to_string(columns) +
+           "]";
+}
+} // namespace
+
+TEST(WriteTable, Layouts) {
+    auto const   g          = make_graph();
+    size_t const numStates  = g.graph.size();
+    size_t const numClasses = g.numClasses();
+
+    auto const byClass = write(TableLayout::Struct, g);
+    EXPECT_THAT(byClass, HasSubstr("class_[128]"));
+    EXPECT_THAT(byClass, HasSubstr(dims(numStates, numClasses)));
+    EXPECT_THAT(byClass, Not(HasSubstr("PACK(")));
+
+    auto const packed = write(TableLayout::Packed, g);
+    EXPECT_THAT(packed, HasSubstr(dims(numStates, numClasses)));
+    EXPECT_THAT(packed, HasSubstr("PACK("));
+
+    auto const fused = write(TableLayout::Fused, g);
+    EXPECT_THAT(fused, Not(HasSubstr("class_[")));
+    EXPECT_THAT(fused, HasSubstr(dims(numStates, 128)));
+
+    auto const transposed = write(TableLayout::Transposed, g);
+    EXPECT_THAT(transposed, HasSubstr("class_[128]"));
+    EXPECT_THAT(transposed, HasSubstr(dims(numClasses, numStates)));
+}
+
+// the direct backend can share the table's class map
+TEST(WriteTable, DirectWithoutClassMap) {
+    auto const         g = make_graph();
+    std::ostringstream stream;
+    write_table(stream, {.backend = Backend::Direct}, g);
+    EXPECT_THAT(stream.str(), HasSubstr("class_[128] = {"));
+    EXPECT_THAT(stream.str(), HasSubstr("class_[(size_t)c]"));
+
+    stream.str("");
+    write_table(
+        stream, {.backend = Backend::Direct, .writeClassMap = false}, g);
+    EXPECT_THAT(stream.str(), Not(HasSubstr("class_[128] = {")));
+    EXPECT_THAT(stream.str(), HasSubstr("class_[(size_t)c]"));
+}
@@ -0,0 +1,194 @@
+#include "time_layouts.hpp"
+
+#include "BaseStates.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <map>
+
+namespace generator {
+namespace {
+// what the Struct, Fused and Transposed layouts hold for each action, like the
+// tokenizer's Action.
+struct Entry {
+    uint8_t toState : 7;
+    uint8_t reset   : 1;
+    int8_t  token;
+};
+
+// and what Packed holds
+uint16_t pack(Entry const e) {
+    return static_cast<uint16_t>(e.toState | e.reset << 7 |
+                                 static_cast<uint8_t>(e.token) << 8);
+}
+
+Entry unpack(uint16_t const w) {
+    return {.toState = static_cast<uint8_t>(w & 0x7f),
+            .reset   = static_cast<uint8_t>((w >> 7) & 1),
+            .token   = static_cast<int8_t>(w >> 8)};
+}
+
+// each distinct token gets a small number, -1 for none
+class TokenNumbers {
+  public:
+    int8_t operator()(std::optional<Token> const& token) {
+        if (!token) {
+            return -1;
+        }
+        std::string key = std::to_string(token->index());
+        if (auto const* word = std::get_if<WordInfo>(&*token)) {
+            key += word->id;
+        }
+        return numbers_.emplace(key, numbers_.size()).first->second;
+    }
+
+  private:
+    std::map<std::string, int8_t> numbers_;
+};
+
+// the tables for every layout
+struct Tables {
+    size_t                numStates;
+    size_t                numClasses;
+    CharacterClass        class_;
+    std::vector<Entry>    byClass;
+    std::vector<uint16_t> packed;
+    std::vector<Entry>    fused;
+    std::vector<Entry>    transposed;
+
+    explicit Tables(CompressedGraph const& g)
+        : numStates{g.graph.size()}
+        , numClasses{g.numClasses()}
+        , class_{g.class_}
+        , byClass(numStates * numClasses)
+        , packed(numStates * numClasses)
+        , fused(numStates * num_characters)
+        , transposed(numStates * numClasses) {
+        assert(numStates <= 128);
+        TokenNumbers tokenNumbers;
+        for (size_t state = 0; state < numStates; ++state) {
+            for (uint8_t k = 0; k < numClasses; ++k) {
+                Entry      e{.toState = Invalid, .reset = 0, .token = -1};
+                auto const iter = g.graph[state].find(k);
+                if (iter != g.graph[state].end()) {
+                    e = {.toState = static_cast<uint8_t>(iter->second.toState),
+                         .reset   = iter->second.resetRecording,
+                         .token   = tokenNumbers(iter->second.token)};
+                }
+                byClass[state * numClasses + k]    = e;
+                packed[state * numClasses + k]     = pack(e);
+                transposed[k * numStates + state] = e;
+            }
+            for (size_t c = 0; c < num_characters; ++c) {
+                fused[state * num_characters + c] =
+                    byClass[state * numClasses + class_[c]];
+            }
+        }
+    }
+};
+
+template <typename Lookup>
+size_t run(Lookup const& lookup, std::vector<std::string> const& corpus) {
+    size_t checksum = 0;
+    for (auto const& header : corpus) {
+        size_t state = Start;
+        for (char const c : header) {
+            Entry const e = lookup(state, static_cast<uint8_t>(c) & 0x7f);
+            state         = e.toState;
+            checksum      = checksum * 31 + e.reset * 7 + e.token + state;
+            if (state == Invalid || state == Finished) {
+                break;
+            }
+        }
+    }
+    return checksum;
+}
+
+size_t run(Tables const&                   t,
+           TableLayout const               layout,
+           std::vector<std::string> const& corpus) {
+    switch (layout) {
+    case TableLayout::Struct:
+        return run(
+            [&t](size_t const s, uint8_t const c) {
+                return t.byClass[s * t.numClasses + t.class_[c]];
+            },
+            corpus);
+    case TableLayout::Packed:
+        return run(
+            [&t](size_t const s, uint8_t const c) {
+                return unpack(t.packed[s * t.numClasses + t.class_[c]]);
+            },
+            corpus);
+    case TableLayout::Fused:
+        return run(
+            [&t](size_t const s, uint8_t const c) {
+                return t.fused[s * num_characters + c];
+            },
+            corpus);
+    case TableLayout::Transposed:
+        return run(
+            [&t](size_t const s, uint8_t const c) {
+                return t.transposed[t.class_[c] * t.numStates + s];
+            },
+            corpus);
+    }
+    return 0;
+}
+
+TableLayout const all_layouts[] = {TableLayout::Struct,
+                                   TableLayout::Packed,
+                                   TableLayout::Fused,
+                                   TableLayout::Transposed};
+} // namespace
+
+std::vector<LayoutTime> time_layouts(CompressedGraph const&          g,
+                                     std::vector<std::string> const& corpus,
+                                     size_t const                    repeats) {
+    using Clock = std::chrono::steady_clock;
+    Tables const            tables{g};
+    std::vector<LayoutTime> out;
+    for (auto const layout : all_layouts) {
+        out.push_back({layout, std::chrono::nanoseconds::max()});
+    }
+    // take turns so that anything else going on hits every layout alike
+    volatile size_t sink = 0;
+    for (size_t i = 0; i < repeats; ++i) {
+        for (auto& [layout, best] : out) {
+            auto const start = Clock::now();
+            sink             = sink + run(tables, layout, corpus);
+            auto const time  = Clock::now() - start;
+            best = std::min(
+                best,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(time));
+        }
+    }
+    return out;
+}
+
+TableLayout fastest_layout(std::vector<LayoutTime> const& times) {
+    assert(!times.empty());
+    return std::ranges::min(times, {}, &LayoutTime::time).layout;
+}
+
+size_t run_layout(CompressedGraph const&          g,
+                  TableLayout const               layout,
+                  std::vector<std::string> const& corpus) {
+    return run(Tables{g}, layout, corpus);
+}
+
+char const* layout_string(TableLayout const layout) {
+    switch (layout) {
+    case TableLayout::Struct:
+        return "struct";
+    case TableLayout::Packed:
+        return "packed";
+    case TableLayout::Fused:
+        return "fused";
+    case TableLayout::Transposed:
+        return "transposed";
+    }
+    return "unknown";
+}
+} // namespace generator
@@ -0,0 +1,39 @@
+#ifndef generator_time_layouts_hpp
+#define generator_time_layouts_hpp
+
+#include "CompressedGraph.hpp"
+#include "write_table.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace generator {
+// how long the best pass over a corpus took with a layout
+struct LayoutTime {
+    TableLayout              layout;
+    std::chrono::nanoseconds time;
+};
+
+// run each of corpus's headers through g laid out with each TableLayout, the
+// way a tokenizer reading the written table would (the state, the reset and
+// the token of each action, no recording).  the best of repeats passes over
+// the whole corpus counts.
+std::vector<LayoutTime> time_layouts(CompressedGraph const&          g,
+                                     std::vector<std::string> const& corpus,
+                                     size_t repeats = 100);
+
+// the layout with the smallest time.  times must not be empty.
+TableLayout fastest_layout(std::vector<LayoutTime> const& times);
+
+// a checksum of the states, resets and tokens seen running corpus through g
+// laid out with layout.  the same for every layout.
+size_t run_layout(CompressedGraph const&          g,
+                  TableLayout                     layout,
+                  std::vector<std::string> const& corpus);
+
+// for printing
+char const* layout_string(TableLayout);
+} // namespace generator
+
+#endif // include guard
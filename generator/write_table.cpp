@@ -2,9 +2,13 @@
 #include "write_table.hpp"
 
 #include "BaseStates.hpp"
+#include "run_hints.hpp"
 
+#include <algorithm>
+#include <array>
 #include <functional>
 #include <iostream>
+#include <sstream>
 
 namespace generator {
 namespace {
@@ -51,9 +55,18 @@ void write_token_id(std::ostream& stream,
     }
 }
 
-void write_fields(std::ostream& stream,
-                  Config const& config,
-                  Action const& action) {
+// bit 0: the character goes into a generic word, bit 1: into a number
+void write_record(std::ostream&               stream,
+                  std::vector<RunHint> const& hints,
+                  Action const&               action) {
+    auto const& to = hints[action.toState];
+    stream << (int{to.word} | int{to.number} << 1);
+}
+
+void write_fields(std::ostream&               stream,
+                  Config const&               config,
+                  std::vector<RunHint> const& hints,
+                  Action const&               action) {
     using WriteFieldFcn =
         std::function<void(std::ostream&, Config const&, Action const&)>;
     static std::unordered_map<FieldNames, WriteFieldFcn> writers{
@@ -62,25 +75,33 @@ void write_fields(std::ostream& stream,
         {FieldNames::TokenId, write_token_id},
     };
 
-    bool first = false;
-    stream << '{';
+    bool const packed = config.layout == TableLayout::Packed;
+    bool       first  = false;
+    stream << (packed ? config.packMacro + "(" : "{");
     for (auto const fieldName : config.fieldsToWrite) {
         if (first) {
             stream << ',' << std::endl;
         }
         first = true;
-        writers.at(fieldName)(stream, config, action);
+        if (fieldName == FieldNames::Record) {
+            write_record(stream, hints, action);
+        } else {
+            writers.at(fieldName)(stream, config, action);
+        }
     }
-    stream << '}';
+    stream << (packed ? ')' : '}');
 }
 
-} // namespace
-
-void write_table(std::ostream&          stream,
-                 Config const&          config,
-                 CompressedGraph const& g) {
-    Action const invalid{.toState = Invalid};
+// the token id for the table or DIRECT_TOKEN
+std::string token_id(Config const& config, Action const& action) {
+    std::ostringstream stream;
+    write_token_id(stream, config, action);
+    return stream.str();
+}
 
+void write_class_map(std::ostream&          stream,
+                     Config const&          config,
+                     CompressedGraph const& g) {
     if (config.makeStatic) {
         stream << "static ";
     }
@@ -95,33 +116,214 @@ void write_table(std::ostream&          stream,
         stream << static_cast<int>(g.class_[c]);
     }
     stream << "};" << std::endl;
+}
+
+bool same_action(Action const& a, Action const& b) {
+    return a.toState == b.toState && a.resetRecording == b.resetRecording &&
+           a.token == b.token;
+}
+
+void write_transition(std::ostream&               stream,
+                      Config const&               config,
+                      std::vector<RunHint> const& hints,
+                      Action const&               action) {
+    if (action.token) {
+        stream << "        DIRECT_TOKEN(" << token_id(config, action) << ");"
+               << std::endl;
+    }
+    // recording that can't end up in a token doesn't need resetting either.
+    // anything that does end up in one starts with a reset into a state that
+    // records it.
+    bool const records =
+        hints[action.toState].word || hints[action.toState].number;
+    if (action.resetRecording && records) {
+        stream << "        DIRECT_RESET();" << std::endl;
+    }
+    if (hints[action.toState].word) {
+        stream << "        DIRECT_PUSH(c);" << std::endl;
+    }
+    if (hints[action.toState].number) {
+        stream << "        DIRECT_DIGIT(c);" << std::endl;
+    }
+    stream << "        goto s" << action.toState << ";" << std::endl;
+}
+
+void write_state(std::ostream&               stream,
+                 Config const&               config,
+                 CompressedGraph const&      g,
+                 std::vector<RunHint> const& hints,
+                 size_t const                state) {
+    stream << "s" << state << ":" << std::endl;
+    if (state == Invalid || state == Finished) {
+        // nothing more to do
+        stream << "    *state = " << state << ";" << std::endl
+               << "    return i;" << std::endl;
+        return;
+    }
+    if (hints[state].characters.any()) {
+        stream << "    i += DIRECT_RUN(" << state << ");" << std::endl;
+    }
+    stream << "    if (i == n) {" << std::endl
+           << "        *state = " << state << ";" << std::endl
+           << "        return i;" << std::endl
+           << "    }" << std::endl
+           << "    c = buffer[i++];" << std::endl
+           << "    switch (c >= 0 && c < " << g.class_.size() << " ? "
+           << config.classMapName << "[(size_t)c] : 0) {" << std::endl;
+
+    // one case list for each distinct action, anything going to Invalid
+    // without doing anything else is left to the default.
+    Action const                          invalid{.toState = Invalid};
+    std::vector<std::pair<Action, std::vector<uint8_t>>> cases;
+    for (uint8_t k = 0; k < g.numClasses(); ++k) {
+        auto const iter = g.graph[state].find(k);
+        if (iter == g.graph[state].end() ||
+            same_action(iter->second, invalid)) {
+            continue;
+        }
+        auto const found =
+            std::ranges::find_if(cases, [&](auto const& entry) {
+                return same_action(entry.first, iter->second);
+            });
+        if (found == cases.end()) {
+            cases.emplace_back(iter->second, std::vector<uint8_t>{k});
+        } else {
+            found->second.push_back(k);
+        }
+    }
+    for (auto const& [action, classes] : cases) {
+        for (auto const k : classes) {
+            stream << "    case " << static_cast<int>(k) << ":" << std::endl;
+        }
+        write_transition(stream, config, hints, action);
+    }
+    stream << "    default:" << std::endl
+           << "        goto s" << Invalid << ";" << std::endl
+           << "    }" << std::endl;
+}
+
+void write_direct(std::ostream&          stream,
+                  Config const&          config,
+                  CompressedGraph const& g) {
+    auto const hints = run_hints(g);
+    if (config.writeClassMap) {
+        write_class_map(stream, config, g);
+    }
     if (config.makeStatic) {
         stream << "static ";
     }
-    stream << config.tableType << " " << config.tableVariableName << "["
-           << g.graph.size() << "][" << g.numClasses() << "] = {" << std::endl;
+    stream << "size_t " << config.functionName << "(" << config.contextType
+           << "* const ctx, uint8_t* const state, char const* const buffer, "
+              "size_t const n) {"
+           << std::endl
+           << "    size_t i = 0;" << std::endl
+           << "    char   c;" << std::endl
+           << "    (void)ctx;" << std::endl
+           << "    switch (*state) {" << std::endl;
+    for (size_t state = 0; state < g.graph.size(); ++state) {
+        stream << "    case " << state << ":" << std::endl
+               << "        goto s" << state << ";" << std::endl;
+    }
+    stream << "    default:" << std::endl
+           << "        goto s" << Invalid << ";" << std::endl
+           << "    }" << std::endl;
+    for (size_t state = 0; state < g.graph.size(); ++state) {
+        write_state(stream, config, g, hints, state);
+    }
+    stream << "}" << std::endl;
+}
 
-    first = false;
-    for (auto const& state : g.graph) {
+void write_run_hints(std::ostream&          stream,
+                     Config const&          config,
+                     CompressedGraph const& g) {
+    auto const hints = run_hints(g);
+    if (config.makeStatic) {
+        stream << "static ";
+    }
+    stream << config.runHintType << " " << config.runHintName << "["
+           << hints.size() << "] = {" << std::endl;
+    bool first = false;
+    for (auto const& hint : hints) {
         if (first) {
             stream << "," << std::endl;
         }
         first = true;
+        std::array<unsigned, 16> nibbles{};
+        for (size_t c = 0; c < hint.characters.size(); ++c) {
+            if (hint.characters[c]) {
+                nibbles[c & 0xf] |= 1u << (c >> 4);
+            }
+        }
+        stream << '{' << int{hint.characters.any()} << ", "
+               << int{hint.number} << ", " << int{hint.word} << ", {";
+        for (size_t i = 0; i < nibbles.size(); ++i) {
+            stream << (i ? ", " : "") << nibbles[i];
+        }
+        stream << "}}";
+    }
+    stream << "};" << std::endl;
+}
+} // namespace
+
+void write_table(std::ostream&          stream,
+                 Config const&          config,
+                 CompressedGraph const& g) {
+    if (config.backend == Backend::Direct) {
+        write_direct(stream, config, g);
+        return;
+    }
+    Action const invalid{.toState = Invalid};
+    // the action for state and the class or character, depending on layout
+    auto const action = [&](size_t const state, uint8_t const k) {
+        auto const iter = g.graph[state].find(k);
+        return iter == g.graph[state].end() ? invalid : iter->second;
+    };
+
+    auto const hints = run_hints(g);
+    bool const fused = config.layout == TableLayout::Fused;
+    if (!fused && config.writeClassMap) {
+        write_class_map(stream, config, g);
+    }
+    if (config.makeStatic) {
+        stream << "static ";
+    }
+    size_t const numInner = fused ? num_characters : g.numClasses();
+    size_t const numRows =
+        config.layout == TableLayout::Transposed ? numInner : g.graph.size();
+    size_t const numColumns =
+        config.layout == TableLayout::Transposed ? g.graph.size() : numInner;
+    stream << config.tableType << " " << config.tableVariableName << "["
+           << numRows << "][" << numColumns << "] = {" << std::endl;
+
+    for (size_t row = 0; row < numRows; ++row) {
+        if (row > 0) {
+            stream << "," << std::endl;
+        }
         stream << '{';
-        bool firstAction = false;
-        for (uint8_t c = 0; c < g.numClasses(); ++c) {
-            if (firstAction) {
+        for (size_t column = 0; column < numColumns; ++column) {
+            if (column > 0) {
                 stream << "," << std::endl;
             }
-            firstAction = true;
-            if (auto const iter = state.find(c); iter != state.end()) {
-                write_fields(stream, config, iter->second);
-            } else {
-                write_fields(stream, config, invalid);
+            switch (config.layout) {
+            case TableLayout::Struct:
+            case TableLayout::Packed:
+                write_fields(stream, config, hints, action(row, column));
+                break;
+            case TableLayout::Fused:
+                write_fields(
+                    stream, config, hints, action(row, g.class_[column]));
+                break;
+            case TableLayout::Transposed:
+                write_fields(stream, config, hints, action(column, row));
+                break;
             }
         }
         stream << '}';
     }
     stream << '}' << ';';
+    if (!config.runHintName.empty()) {
+        stream << std::endl;
+        write_run_hints(stream, config, g);
+    }
 }
 } // namespace generator
@@ -8,9 +8,38 @@ enum class FieldNames {
     ToState,
     RecordReset,
     TokenId,
+    // what the transition has to record of its character: bit 0 if it can end
+    // up in a generic word, bit 1 if it can end up in a number (see
+    // run_hints).  0 means it can be dropped.
+    Record,
+};
+
+enum class Backend {
+    // the class map and action table, indexed at run time
+    Table,
+    // straight line C, see write_table
+    Direct,
+};
+
+// how the Table backend lays out the actions.  the values are written into the
+// generated headers (see main.cpp), so new ones go at the end
+enum class TableLayout {
+    // tableType[states][classes], reached through the class map
+    Struct,
+    // like Struct but each action is written as packMacro(fields...) so that
+    // it can be packed into a 16 bit word
+    Packed,
+    // tableType[states][characters].  no class map, so no extra load, but a
+    // much bigger table
+    Fused,
+    // tableType[classes][states], reached through the class map
+    Transposed,
 };
 
 struct WriteTableConfig {
+    Backend     backend = Backend::Table;
+    TableLayout layout  = TableLayout::Struct;
+
     std::vector<FieldNames> fieldsToWrite{FieldNames::ToState};
 
     std::string genericWordId = "GenericWord";
@@ -22,10 +51,46 @@ struct WriteTableConfig {
 
     std::string classMapType = "uint8_t";
     std::string classMapName = "class_";
+    // false if the class map is already written, e.g., by the Table backend
+    // for the same graph before the Direct one.
+    bool writeClassMap = true;
+
+    std::string packMacro = "PACK";
+
+    // if set, also write the run_hints for each state as an array of
+    // {run, number, word, {characters}} where run says the state has any run
+    // characters, number and word are RunHint::number and RunHint::word and
+    // characters is a nibble table: bit h of characters[l] is set if character
+    // (h << 4 | l) is a run character.
+    std::string runHintType = "RunHint";
+    std::string runHintName;
+
+    // the Direct backend writes a function with this name that takes
+    // (contextType* ctx, uint8_t* state, char const* buffer, size_t n), runs
+    // the graph over buffer starting from *state and returns the number of
+    // characters processed with *state updated.
+    std::string functionName = "direct";
+    std::string contextType  = "void";
 
     bool makeStatic = true;
 };
 
+// write g out with the backend in config.
+//
+// the Direct backend writes one label per state and a switch on the character
+// class in each.  what happens on a transition is left to macros that the code
+// including the output has to define.  ctx, buffer, n, and i (the index of the
+// next character in buffer) are in scope for all of them.
+//
+// DIRECT_RUN(state): the number of characters at buffer + i that loop in state,
+//     recorded as they would be one at a time.  only used for states that have
+//     run characters (see run_hints).
+// DIRECT_TOKEN(id): finish the token with the id written like the table's
+//     (genericWordId, numberId or the WordInfo's id).
+// DIRECT_RESET(): reset recording.
+// DIRECT_PUSH(c): record c for a generic word.  left out where it can't end up
+//     in one.
+// DIRECT_DIGIT(c): add c to the number.  left out where it can't end up in one.
 void write_table(std::ostream& stream,
                  WriteTableConfig const&,
                  CompressedGraph const&);
@@ -0,0 +1,156 @@
+#include "../gf-student.h"
+#include "../test/snprintf_reference.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace {
+// what the client and server actually send
+std::string const path = "/courses/ud923/filecorpus/yellowstone.jpg";
+RequestGet const  request{path.data(), path.size()};
+Response const    response{OkResponse, 2367811};
+
+Token const requestTokens[] = {
+    {.id = GetfileToken},
+    {.id = GetToken},
+    {.id = PathToken, .data = {.path = {path.data(), path.size()}}}};
+Token const responseTokens[] = {{.id = GetfileToken},
+                                {.id = OkToken},
+                                {.id = SizeToken, .data = {.size = 2367811}}};
+
+// the old snprintf_tokens, one snprintf per token
+void BM_header_reference(benchmark::State& state, Token const* const tokens) {
+    size_t const numTokens = static_cast<size_t>(state.range(0));
+    char         buffer[1024];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(gf::test::snprintf_tokens_reference(
+            buffer, sizeof(buffer), tokens, numTokens));
+        benchmark::ClobberMemory();
+    }
+}
+
+void BM_snprintf_request_get(benchmark::State& state) {
+    char buffer[1024];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            snprintf_request_get(buffer, sizeof(buffer), &request));
+        benchmark::ClobberMemory();
+    }
+}
+
+void BM_snprintf_response(benchmark::State& state) {
+    char buffer[1024];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            snprintf_response(buffer, sizeof(buffer), &response));
+        benchmark::ClobberMemory();
+    }
+}
+
+void BM_write_response(benchmark::State& state) {
+    char buffer[RESPONSE_HEADER_CAPACITY];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(write_response(buffer, &response));
+        benchmark::ClobberMemory();
+    }
+}
+
+// what gfserver does for every OK response
+void BM_response_header_init(benchmark::State& state) {
+    ResponseHeader header;
+    for (auto _ : state) {
+        response_header_init(&header, &response);
+        benchmark::DoNotOptimize(header);
+    }
+}
+
+// a tokenizer that's done with text
+Tokenizer* tokenized(std::string const& text) {
+    Tokenizer* const tok = tok_create();
+    tok_process(tok, text.data(), text.size());
+    return tok;
+}
+
+void BM_unpack_request_get(benchmark::State& state) {
+    Tokenizer* const tok =
+        tokenized("GETFILE GET " + path + std::string{tok_terminator()});
+    RequestGet out;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(unpack_request_get(tok, &out));
+        benchmark::DoNotOptimize(out);
+    }
+    tok_destroy(tok);
+}
+
+void BM_unpack_response(benchmark::State& state) {
+    Tokenizer* const tok =
+        tokenized("GETFILE OK 2367811" + std::string{tok_terminator()});
+    Response out;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(unpack_response(tok, &out));
+        benchmark::DoNotOptimize(out);
+    }
+    tok_destroy(tok);
+}
+
+// what the server does with each request header it reads: text is
+// tokenizing and unpacking, binary just unpacking
+void BM_parse_request_text(benchmark::State& state) {
+    std::string const text = "GETFILE GET " + path + tok_terminator();
+    Tokenizer* const  tok  = tok_create();
+    tok_set_slices(tok, true);
+    tok_set_grammar(tok, RequestGrammar);
+    RequestGet out;
+    for (auto _ : state) {
+        tok_reset(tok);
+        tok_process(tok, text.data(), text.size());
+        benchmark::DoNotOptimize(unpack_request_get(tok, &out));
+        benchmark::DoNotOptimize(out);
+    }
+    tok_destroy(tok);
+}
+
+void BM_parse_request_binary(benchmark::State& state) {
+    uint8_t      buffer[1024];
+    size_t const n = write_binary_request_get(buffer, &request);
+    RequestGet   out;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(unpack_binary_request_get(buffer, n, &out));
+        benchmark::DoNotOptimize(out);
+    }
+}
+
+// and the client with each response header
+void BM_write_response_binary(benchmark::State& state) {
+    uint8_t buffer[BINARY_HEADER_SIZE];
+    for (auto _ : state) {
+        write_binary_response(buffer, &response);
+        benchmark::DoNotOptimize(buffer);
+    }
+}
+
+void BM_unpack_response_binary(benchmark::State& state) {
+    uint8_t buffer[BINARY_HEADER_SIZE];
+    write_binary_response(buffer, &response);
+    Response out;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            unpack_binary_response(buffer, sizeof(buffer), &out));
+        benchmark::DoNotOptimize(out);
+    }
+}
+} // namespace
+
+BENCHMARK_CAPTURE(BM_header_reference, request, requestTokens)->Arg(3);
+BENCHMARK_CAPTURE(BM_header_reference, response, responseTokens)->Arg(3);
+BENCHMARK(BM_snprintf_request_get);
+BENCHMARK(BM_snprintf_response);
+BENCHMARK(BM_write_response);
+BENCHMARK(BM_response_header_init);
+BENCHMARK(BM_unpack_request_get);
+BENCHMARK(BM_unpack_response);
+BENCHMARK(BM_parse_request_text);
+BENCHMARK(BM_parse_request_binary);
+BENCHMARK(BM_write_response_binary);
+BENCHMARK(BM_unpack_response_binary);
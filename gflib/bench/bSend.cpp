@@ -0,0 +1,121 @@
+#include "../gf-student.h"
+
+#include <benchmark/benchmark.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// a connected pair of loopback tcp sockets with a thread on the receiving end
+// that throws away everything it reads.
+class LoopbackPair {
+  public:
+    LoopbackPair() {
+        int const listener = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family      = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port        = 0;
+        socklen_t addressLen    = sizeof(address);
+        if (listener == -1 ||
+            bind(listener, (sockaddr*)&address, sizeof(address)) == -1 ||
+            listen(listener, 1) == -1 ||
+            getsockname(listener, (sockaddr*)&address, &addressLen) == -1) {
+            throw std::runtime_error("failed to listen");
+        }
+        sender_ = socket(AF_INET, SOCK_STREAM, 0);
+        if (sender_ == -1 ||
+            connect(sender_, (sockaddr*)&address, sizeof(address)) == -1) {
+            throw std::runtime_error("failed to connect");
+        }
+        receiver_ = accept(listener, NULL, NULL);
+        close(listener);
+        if (receiver_ == -1) {
+            throw std::runtime_error("failed to accept");
+        }
+        drain_ = std::thread([this] {
+            std::vector<uint8_t> buffer(1 << 20);
+            while (recv(receiver_, buffer.data(), buffer.size(), 0) > 0) {
+            }
+        });
+    }
+
+    ~LoopbackPair() {
+        shutdown(sender_, SHUT_WR);
+        drain_.join();
+        close(sender_);
+        close(receiver_);
+    }
+
+    int sender() const {
+        return sender_;
+    }
+
+  private:
+    int         sender_   = -1;
+    int         receiver_ = -1;
+    std::thread drain_;
+};
+
+void send_args_(benchmark::internal::Benchmark* b) {
+    for (int64_t const mb : {1, 10, 100}) {
+        b->Arg(mb << 20);
+    }
+}
+
+void BM_sock_send_all(benchmark::State& state) {
+    LoopbackPair               pair;
+    std::vector<uint8_t> const data(state.range(0), 'x');
+    for (auto _ : state) {
+        if (sock_send_all(pair.sender(), data.data(), data.size()) !=
+            (ssize_t)data.size()) {
+            state.SkipWithError("send failed");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_sock_send_all)->Apply(send_args_)->UseRealTime();
+
+// zero copy sends of the same buffer, waiting for the kernel to be done with
+// it after each (wait) or only once at the end.
+void zc_send_(benchmark::State& state, bool const wait) {
+    LoopbackPair pair;
+    if (sock_enable_zerocopy(pair.sender()) != 0) {
+        state.SkipWithError("zero copy not supported");
+        return;
+    }
+    std::vector<uint8_t> const data(state.range(0), 'x');
+    ZerocopySends* const       zs = zc_create(pair.sender());
+    for (auto _ : state) {
+        if (zc_send(zs, data.data(), data.size(), NULL, NULL) !=
+                (ssize_t)data.size() ||
+            zc_reap(zs, wait) != 0) {
+            state.SkipWithError("send failed");
+            break;
+        }
+    }
+    // over loopback the kernel always copies, so expect this to be 1.
+    state.counters["copied"] = zc_copied(zs);
+    zc_destroy(zs);
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+void BM_zc_send_wait(benchmark::State& state) {
+    zc_send_(state, true);
+}
+BENCHMARK(BM_zc_send_wait)->Apply(send_args_)->UseRealTime();
+
+void BM_zc_send(benchmark::State& state) {
+    zc_send_(state, false);
+}
+BENCHMARK(BM_zc_send)->Apply(send_args_)->UseRealTime();
+
+} // namespace
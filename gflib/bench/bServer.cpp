@@ -0,0 +1,155 @@
+#include "../gf-student.h"
+#include "../gfserver-student.h"
+#include "../gfserver.h"
+
+#include <benchmark/benchmark.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// every request gets this many bytes back
+size_t const file_size = 4096;
+
+gfh_error_t serve_file_(gfcontext_t** ctx, char const*, void* data) {
+    auto const& bytes = *static_cast<std::vector<uint8_t> const*>(data);
+    gfs_sendheader(ctx, GF_OK, bytes.size());
+    gfs_send(ctx, bytes.data(), bytes.size());
+    return 0;
+}
+
+// a gfserver serving on its own thread
+class Server {
+  public:
+    Server(ServerBackend const backend, unsigned short const port)
+        : gfs_{gfserver_create()}, data_(file_size, 'x') {
+        gfserver_set_port(&gfs_, port);
+        gfserver_set_maxpending(&gfs_, 128);
+        gfserver_set_handler(&gfs_, serve_file_);
+        gfserver_set_handlerarg(&gfs_, &data_);
+        gfserver_set_backend(&gfs_, backend);
+        gfserver_set_continue_fcn(
+            &gfs_,
+            [](void* stop) { return !*static_cast<std::atomic<bool>*>(stop); },
+            &stop_);
+        if (gfserver_listen(&gfs_) != 0) {
+            throw std::runtime_error("failed to listen");
+        }
+        thread_ = std::thread([this] { gfserver_serve(&gfs_); });
+    }
+
+    ~Server() {
+        if (thread_.joinable()) {
+            stop();
+        }
+        gfserver_destroy(&gfs_);
+    }
+
+    // stop serving and return the backend that was actually used
+    ServerBackend stop() {
+        stop_ = true;
+        thread_.join();
+        return gfserver_backend(&gfs_);
+    }
+
+  private:
+    gfserver_t*          gfs_;
+    std::vector<uint8_t> data_;
+    std::atomic<bool>    stop_ = false;
+    std::thread          thread_;
+};
+
+// the request for /file in protocol
+std::string request_text_(GfProtocol const protocol) {
+    std::string const path = "/file";
+    if (protocol == GfTextProtocol) {
+        return "GETFILE GET " + path + "\r\n\r\n";
+    }
+    std::string      out(BINARY_HEADER_SIZE + path.size(), '\0');
+    RequestGet const request{path.data(), path.size()};
+    write_binary_request_get(reinterpret_cast<uint8_t*>(out.data()), &request);
+    return out;
+}
+
+// make one request and read the whole response.  returns false on failure.
+bool request_(unsigned short const port, GfProtocol const protocol) {
+    int const   sock = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family      = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port        = htons(port);
+    std::string const request = request_text_(protocol);
+    size_t            total   = 0;
+    if (sock != -1 &&
+        connect(sock, (sockaddr*)&address, sizeof(address)) == 0 &&
+        send(sock, request.data(), request.size(), 0) ==
+            (ssize_t)request.size()) {
+        char    buffer[8192];
+        ssize_t n;
+        while ((n = recv(sock, buffer, sizeof(buffer), 0)) > 0) {
+            total += n;
+        }
+    }
+    if (sock != -1) {
+        close(sock);
+    }
+    return total > file_size;
+}
+
+// requests per second with state.threads() clients hammering one server
+void bm_server_(benchmark::State&    state,
+                ServerBackend const  backend,
+                unsigned short const port,
+                GfProtocol const     protocol = GfTextProtocol) {
+    static std::unique_ptr<Server> server;
+    if (state.thread_index() == 0) {
+        server = std::make_unique<Server>(backend, port);
+    }
+    // the threads sync up before and after the timing loop
+    for (auto _ : state) {
+        if (!request_(port, protocol)) {
+            state.SkipWithError("request failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        if (server->stop() != backend) {
+            state.SetLabel("fell back to select");
+        }
+        server.reset();
+    }
+}
+
+void BM_serve_select(benchmark::State& state) {
+    bm_server_(state, SelectServerBackend, 14770);
+}
+
+void BM_serve_io_uring(benchmark::State& state) {
+    bm_server_(state, IoUringServerBackend, 14771);
+}
+
+// the same small file over GETFILE2
+void BM_serve_select_binary(benchmark::State& state) {
+    bm_server_(state, SelectServerBackend, 14772, GfBinaryProtocol);
+}
+
+void BM_serve_io_uring_binary(benchmark::State& state) {
+    bm_server_(state, IoUringServerBackend, 14773, GfBinaryProtocol);
+}
+} // namespace
+
+BENCHMARK(BM_serve_select)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_serve_io_uring)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_serve_select_binary)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_serve_io_uring_binary)->ThreadRange(1, 16)->UseRealTime();
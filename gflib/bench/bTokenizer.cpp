@@ -0,0 +1,297 @@
+#include "../../generator/static_tokenizer.hpp"
+#include "../gf-student.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using ProcessFcn = ssize_t (*)(Tokenizer*, char const*, size_t);
+
+// a request with a path of state.range(0) characters
+std::string request_(size_t const pathSize) {
+    std::string const piece = "courses/ud923/filecorpus/";
+    std::string       path{'/'};
+    while (path.size() < pathSize) {
+        path += piece.substr(0, pathSize - path.size());
+    }
+    return "GETFILE GET " + path + tok_terminator();
+}
+
+void BM_tok_header(benchmark::State&      state,
+                   ProcessFcn const       process,
+                   std::string const&     header,
+                   bool const             slices  = false,
+                   TokenizerGrammar const grammar = AnyGrammar) {
+    Tokenizer* const tok = tok_create();
+    tok_set_slices(tok, slices);
+    tok_set_grammar(tok, grammar);
+    for (auto _ : state) {
+        tok_reset(tok);
+        benchmark::DoNotOptimize(process(tok, header.data(), header.size()));
+    }
+    tok_destroy(tok);
+    state.SetBytesProcessed(state.iterations() * header.size());
+}
+
+void BM_tok_process(benchmark::State& state) {
+    BM_tok_header(state, tok_process, request_(state.range(0)));
+}
+
+void BM_tok_process_direct(benchmark::State& state) {
+    BM_tok_header(state, tok_process_direct, request_(state.range(0)));
+}
+
+// the path points into the header instead of being copied
+void BM_tok_process_slices(benchmark::State& state) {
+    BM_tok_header(state, tok_process, request_(state.range(0)), true);
+}
+
+// what the client and server actually see
+std::string const request =
+    "GETFILE GET /courses/ud923/filecorpus/yellowstone.jpg" +
+    std::string{tok_terminator()};
+std::string const response =
+    "GETFILE OK 2367811" + std::string{tok_terminator()};
+// nothing but keywords and spaces, none of which need recording
+std::string const keywords = [] {
+    std::string out = "GETFILE";
+    while (out.size() < 256) {
+        out += " GET OK FILE_NOT_FOUND ERROR INVALID";
+    }
+    return out + tok_terminator();
+}();
+
+// what gfclient does per request, a fresh tokenizer for every response
+void BM_tok_response_create(benchmark::State& state) {
+    for (auto _ : state) {
+        Tokenizer* const tok = tok_create();
+        benchmark::DoNotOptimize(
+            tok_process(tok, response.data(), response.size()));
+        tok_destroy(tok);
+    }
+}
+
+void BM_tok_response_init(benchmark::State& state) {
+    for (auto _ : state) {
+        TokenizerStorage storage;
+        Tokenizer* const tok = tok_init(&storage);
+        benchmark::DoNotOptimize(
+            tok_process(tok, response.data(), response.size()));
+    }
+}
+
+// corpora like what the client and server see: the workload's paths and some
+// generated ones, and responses of all sizes and statuses.
+std::vector<std::string> const requestCorpus = [] {
+    std::vector<std::string> out;
+    for (std::string const path :
+         {"/courses/ud923/filecorpus/yellowstone.jpg",
+          "/courses/ud923/filecorpus/moranabovejacksonlake.jpg",
+          "/courses/ud923/filecorpus/road.jpg",
+          "/courses/ud923/filecorpus/paraglider.jpg",
+          "/a.txt",
+          "/index.html"}) {
+        out.push_back("GETFILE GET " + path + tok_terminator());
+    }
+    for (size_t i = 0; i < 10; ++i) {
+        out.push_back("GETFILE GET /courses/ud923/filecorpus/1kb-sample-file-" +
+                      std::to_string(i) + ".html" + tok_terminator());
+    }
+    return out;
+}();
+
+std::vector<std::string> const responseCorpus = [] {
+    std::vector<std::string> out;
+    for (size_t size = 1; size < 10000000000; size *= 7) {
+        out.push_back("GETFILE OK " + std::to_string(size) + tok_terminator());
+    }
+    for (std::string const status : {"FILE_NOT_FOUND", "ERROR", "INVALID"}) {
+        out.push_back("GETFILE " + status + tok_terminator());
+    }
+    return out;
+}();
+
+// how a header arrives: all at once, a byte at a time, or in random pieces of
+// 1 to 16 bytes (the same pieces every run).
+enum class Feed { Whole, OneByte, Random };
+
+std::vector<std::vector<size_t>> pieces(std::vector<std::string> const& corpus,
+                                        Feed const                      feed) {
+    std::mt19937                          gen;
+    std::uniform_int_distribution<size_t> pieceDist{1, 16};
+    std::vector<std::vector<size_t>>      out;
+    for (auto const& header : corpus) {
+        auto& sizes = out.emplace_back();
+        for (size_t at = 0; at < header.size(); at += sizes.back()) {
+            size_t const left = header.size() - at;
+            switch (feed) {
+            case Feed::Whole:
+                sizes.push_back(left);
+                break;
+            case Feed::OneByte:
+                sizes.push_back(1);
+                break;
+            case Feed::Random:
+                sizes.push_back(std::min(pieceDist(gen), left));
+                break;
+            }
+        }
+    }
+    return out;
+}
+
+// tokenize every header of the corpus per iteration.  reports bytes and
+// headers (items) per second.
+void BM_tok_corpus(benchmark::State&               state,
+                   ProcessFcn const                process,
+                   std::vector<std::string> const* corpus,
+                   Feed const                      feed,
+                   TokenizerGrammar const          grammar) {
+    auto const       feedSizes = pieces(*corpus, feed);
+    Tokenizer* const tok       = tok_create();
+    tok_set_grammar(tok, grammar);
+    size_t bytes = 0;
+    for (auto const& header : *corpus) {
+        bytes += header.size();
+    }
+    for (auto _ : state) {
+        for (size_t h = 0; h < corpus->size(); ++h) {
+            char const* at = (*corpus)[h].data();
+            tok_reset(tok);
+            for (auto const n : feedSizes[h]) {
+                benchmark::DoNotOptimize(process(tok, at, n));
+                at += n;
+            }
+        }
+    }
+    tok_destroy(tok);
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.SetItemsProcessed(state.iterations() * corpus->size());
+}
+
+// request.grammar and response.grammar for the generator's compile time
+// tokenizer
+struct StaticRequestGrammar {
+    static constexpr generator::StaticWord words[] = {{"GETFILE", GetfileToken},
+                                                      {"GET", GetToken}};
+    static constexpr std::string_view startsGenericWord = "/";
+    static constexpr std::string_view terminator        = "\r\n\r\n";
+    static constexpr bool             numbers           = false;
+    static constexpr int              genericWordId     = PathToken;
+    static constexpr int              numberId          = SizeToken;
+};
+
+struct StaticResponseGrammar {
+    static constexpr generator::StaticWord words[] = {
+        {"GETFILE", GetfileToken},
+        {"OK", OkToken},
+        {"FILE_NOT_FOUND", FileNotFoundToken},
+        {"ERROR", ErrorToken},
+        {"INVALID", InvalidToken}};
+    static constexpr std::string_view startsGenericWord = "";
+    static constexpr std::string_view terminator        = "\r\n\r\n";
+    static constexpr bool             numbers           = true;
+    static constexpr int              genericWordId     = PathToken;
+    static constexpr int              numberId          = SizeToken;
+};
+
+// BM_tok_corpus with whole headers, but through the inlined tokenize<G>
+template <typename G>
+void BM_static_tokenize(benchmark::State&               state,
+                        std::vector<std::string> const* corpus) {
+    size_t bytes = 0;
+    for (auto const& header : *corpus) {
+        bytes += header.size();
+    }
+    for (auto _ : state) {
+        for (auto const& header : *corpus) {
+            size_t numTokens = 0;
+            benchmark::DoNotOptimize(generator::tokenize<G>(
+                header, [&numTokens](generator::StaticToken const& token) {
+                    benchmark::DoNotOptimize(token);
+                    ++numTokens;
+                }));
+            benchmark::DoNotOptimize(numTokens);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.SetItemsProcessed(state.iterations() * corpus->size());
+}
+
+void BM_static_tokenize_request(benchmark::State& state) {
+    BM_static_tokenize<StaticRequestGrammar>(state, &requestCorpus);
+}
+
+void BM_static_tokenize_response(benchmark::State& state) {
+    BM_static_tokenize<StaticResponseGrammar>(state, &responseCorpus);
+}
+} // namespace
+
+BENCHMARK(BM_tok_process)->Arg(16)->Arg(64)->Arg(256)->Arg(1024);
+BENCHMARK(BM_tok_process_direct)->Arg(16)->Arg(64)->Arg(256)->Arg(1024);
+BENCHMARK(BM_tok_process_slices)->Arg(16)->Arg(64)->Arg(256)->Arg(1024);
+BENCHMARK_CAPTURE(BM_tok_header, request_table, tok_process, request);
+BENCHMARK_CAPTURE(BM_tok_header, request_direct, tok_process_direct, request);
+BENCHMARK_CAPTURE(BM_tok_header, request_slices, tok_process, request, true);
+BENCHMARK_CAPTURE(BM_tok_header, response_table, tok_process, response);
+// with the grammar for the direction the header goes
+BENCHMARK_CAPTURE(
+    BM_tok_header, request_grammar, tok_process, request, true, RequestGrammar);
+BENCHMARK_CAPTURE(BM_tok_header,
+                  response_grammar,
+                  tok_process,
+                  response,
+                  false,
+                  ResponseGrammar);
+BENCHMARK_CAPTURE(BM_tok_header,
+                  request_grammar_direct,
+                  tok_process_direct,
+                  request,
+                  true,
+                  RequestGrammar);
+BENCHMARK_CAPTURE(BM_tok_header,
+                  response_grammar_direct,
+                  tok_process_direct,
+                  response,
+                  false,
+                  ResponseGrammar);
+BENCHMARK_CAPTURE(BM_tok_header, response_direct, tok_process_direct, response);
+BENCHMARK_CAPTURE(BM_tok_header, keywords_table, tok_process, keywords);
+BENCHMARK_CAPTURE(BM_tok_header, keywords_direct, tok_process_direct, keywords);
+BENCHMARK(BM_tok_response_create);
+BENCHMARK(BM_tok_response_init);
+
+#define CORPUS_BENCHMARKS(_CORPUS, _GRAMMAR)                     \
+    BENCHMARK_CAPTURE(BM_tok_corpus,                            \
+                      _CORPUS##_whole,                          \
+                      tok_process,                              \
+                      &_CORPUS##Corpus,                         \
+                      Feed::Whole,                              \
+                      _GRAMMAR);                                \
+    BENCHMARK_CAPTURE(BM_tok_corpus,                            \
+                      _CORPUS##_one_byte,                       \
+                      tok_process,                              \
+                      &_CORPUS##Corpus,                         \
+                      Feed::OneByte,                            \
+                      _GRAMMAR);                                \
+    BENCHMARK_CAPTURE(BM_tok_corpus,                            \
+                      _CORPUS##_random,                         \
+                      tok_process,                              \
+                      &_CORPUS##Corpus,                         \
+                      Feed::Random,                             \
+                      _GRAMMAR);                                \
+    BENCHMARK_CAPTURE(BM_tok_corpus,                            \
+                      _CORPUS##_whole_direct,                   \
+                      tok_process_direct,                       \
+                      &_CORPUS##Corpus,                         \
+                      Feed::Whole,                              \
+                      _GRAMMAR)
+CORPUS_BENCHMARKS(request, RequestGrammar);
+CORPUS_BENCHMARKS(response, ResponseGrammar);
+#undef CORPUS_BENCHMARKS
+BENCHMARK(BM_static_tokenize_request);
+BENCHMARK(BM_static_tokenize_response);
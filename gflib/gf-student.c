@@ -2,18 +2,32 @@
  *  This file is for use by students to define anything they wish.  It is used
  * by both the gf server and client implementations
  */
+// SO_ZEROCOPY and the error queue aren't POSIX
+#define _DEFAULT_SOURCE
 
 #include "gf-student.h"
 
 #include <sys/socket.h>
 
 #include <assert.h>
+#include <errno.h>
 #include <memory.h>
+#include <poll.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__linux__) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#define GF_HAVE_ZEROCOPY 1
+#endif
+
 /////////////////////////////////////////////////////////
 // Tokenizer
 /////////////////////////////////////////////////////////
@@ -24,22 +38,39 @@ struct TokenizerTag {
     // a vector of tokens.  they are added with push_token_ below.
     // there's a capacity, greater then numTokens, that is the total number of
     // tokens we can hold before realloc.  push_token_ will handle the realloc.
-    // The token capacity is not reset with tok_reset.
+    // The token capacity is not reset with tok_reset.  a tokenizer from
+    // tok_init is fixed, tokens and buffer are in its TokenizerStorage and
+    // running out of either is an overflow instead.
     Token* tokens;
     size_t tokenCapacity;
     size_t numTokens;
 
     // buffer to store generic strings.  each generic string is written to the
-    // the characters are written as they are processed.  when the end of the
-    // generic string is processed, a null terminator is added, and
-    // startOfCurrent moves to the next character in the buffer.
-    // push_char_ adds characters to this buffer and handles realloc's if
-    // needed.
+    // buffer once it's finished or when the call to tok_process it started in
+    // ends (see copy_word_).  when the end of the generic string is processed,
+    // a null terminator is added, and startOfCurrent moves to the next
+    // character in the buffer.  push_chars_ adds characters to this buffer and
+    // handles realloc's if needed.
     char*  buffer;
     size_t bufferCapacity;
     size_t startOfCurrent;
     size_t bufferCursor;
 
+    // the characters of the current generic string in the caller's buffer
+    // that haven't been copied yet.  NULL if there aren't any.
+    char const* wordBegin;
+    char const* wordEnd;
+
+    // see tok_set_slices
+    bool slices;
+
+    // see tok_set_grammar
+    struct GrammarTag const* grammar;
+
+    // see tok_init and tok_overflow
+    bool fixed;
+    bool overflow;
+
     // the running value of decimal numbers as they are processed.
     size_t numberValue;
 };
@@ -52,48 +83,183 @@ struct ActionTag {
     uint8_t resetRecording : 1;
     // token finished with this transition.  Set to UnknownToken when there is
     // no token.
-    int8_t token;
+    int8_t  token          : 6;
+    // what to record of the character, some of RECORD_WORD and RECORD_NUMBER.
+    // 0 when it can't end up in a token.
+    uint8_t record         : 2;
 };
 typedef struct ActionTag Action;
 
+#define RECORD_WORD   1
+#define RECORD_NUMBER 2
+
+/*!
+ A generated tokenizer, one for each TokenizerGrammar (see tok_set_grammar).
+ the tables are at the bottom of the file.
+ */
+struct GrammarTag {
+    uint8_t numStates;
+    // the columns of a struct, packed or fused table, 128 for fused, which has
+    // one for each character
+    uint8_t numClasses;
+    // maps a character to its class
+    uint8_t const* characterClass;
+    // maps state and character class to action, see get_action_
+    Action const* actions;
+    // a RunHint for each state, see below
+    struct RunHintTag const* runHints;
+    // the same graph coded directly, see tok_process_direct
+    size_t (*direct)(Tokenizer*, uint8_t* state, char const*, size_t);
+    // the literal prefixes the grammar takes, see literal_prefix_
+    uint8_t prefixes;
+    // the state a space takes the start state to, where a prefix leaves it
+    uint8_t inSpace;
+};
+typedef struct GrammarTag Grammar;
+
+#define REQUEST_PREFIX  1
+#define RESPONSE_PREFIX 2
+
+// get_grammar_ and get_action_ access the tables, below.  Use the forward
+// declarations to keep the tables at the bottom of the file.
+static Grammar const* get_grammar_(TokenizerGrammar);
+static Action const*  get_action_(Grammar const*, uint8_t state, char c);
+
+#if !defined(NDEBUG)
+// see tok_process
+static void assert_run_hints_(void);
+#endif
+
 Tokenizer* tok_create() {
+#if !defined(NDEBUG)
+    assert_run_hints_();
+#endif
     Tokenizer* out      = (Tokenizer*)calloc(sizeof(Tokenizer), 1);
     out->tokenCapacity  = 12;
     out->tokens         = (Token*)malloc(sizeof(Token) * out->tokenCapacity);
     out->bufferCapacity = 64;
     out->buffer         = (char*)malloc(out->bufferCapacity);
+    out->grammar        = get_grammar_(AnyGrammar);
     tok_reset(out);
     return out;
 }
 
-void push_char_(Tokenizer* const tok, char const c) {
-    if (tok->bufferCursor == tok->bufferCapacity) {
+// TokenizerStorage has to have room for a Tokenizer.  the array size goes
+// negative, and won't compile, if it doesn't.
+typedef char tokenizer_fits_in_storage_
+    [sizeof(Tokenizer) <= sizeof(((TokenizerStorage*)0)->tokenizer) ? 1 : -1];
+
+Tokenizer* tok_init(TokenizerStorage* const storage) {
+#if !defined(NDEBUG)
+    assert_run_hints_();
+#endif
+    Tokenizer* const out = (Tokenizer*)storage->tokenizer;
+    memset(out, 0, sizeof(Tokenizer));
+    out->fixed          = true;
+    out->tokenCapacity  = TOKENIZER_STORAGE_TOKENS;
+    out->tokens         = storage->tokens;
+    out->bufferCapacity = TOKENIZER_STORAGE_CHARS;
+    out->buffer         = storage->chars;
+    out->grammar        = get_grammar_(AnyGrammar);
+    tok_reset(out);
+    return out;
+}
+
+// a fixed tokenizer ran out of room.  it's invalid from here on.
+static void overflow_(Tokenizer* const tok) {
+    tok->overflow = true;
+    tok->state    = 1;
+}
+
+// the offset of p from the start of the buffer that was at original, which is
+// >= capacity if p doesn't point into it.  slices point elsewhere.
+static size_t buffer_offset_(uintptr_t const   original,
+                             size_t const      capacity,
+                             char const* const p) {
+    size_t const offset = (uintptr_t)p - original;
+    return offset < capacity ? offset : capacity;
+}
+
+// make room for n more characters in the buffer.  returns false if there's
+// no more room to be had.
+static bool reserve_chars_(Tokenizer* const tok, size_t const n) {
+    if (tok->bufferCursor + n > tok->bufferCapacity) {
+        if (tok->fixed) {
+            overflow_(tok);
+            return false;
+        }
         // at capacity, realloc and update tokens to point into new buffer
-        char const* const originalBufferPtr = tok->buffer;
+        uintptr_t const original         = (uintptr_t)tok->buffer;
+        size_t const    originalCapacity = tok->bufferCapacity;
 
-        tok->bufferCapacity *= 2;
+        while (tok->bufferCursor + n > tok->bufferCapacity) {
+            tok->bufferCapacity *= 2;
+        }
         tok->buffer = (char*)realloc(tok->buffer, tok->bufferCapacity);
-        if (tok->buffer != originalBufferPtr) {
+        if ((uintptr_t)tok->buffer != original) {
             for (size_t i = 0; i < tok->numTokens; ++i) {
-                if (tok->tokens[i].id == PathToken) {
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wuse-after-free"
-                    // GCC gets a little nanny here.  we're just using the
-                    // previous address to update the pointers in tokens, if
-                    // any.
-                    size_t const originalOffset =
-                        tok->tokens[i].data.path - originalBufferPtr;
-#pragma GCC diagnostic pop
-                    tok->tokens[i].data.path = tok->buffer + originalOffset;
+                if (tok->tokens[i].id != PathToken) {
+                    continue;
+                }
+                size_t const offset =
+                    buffer_offset_(original,
+                                   originalCapacity,
+                                   tok->tokens[i].data.path.text);
+                if (offset < originalCapacity) {
+                    tok->tokens[i].data.path.text = tok->buffer + offset;
                 }
             }
         }
     }
+    return true;
+}
+
+void push_char_(Tokenizer* const tok, char const c) {
+    if (!reserve_chars_(tok, 1)) {
+        return;
+    }
     tok->buffer[tok->bufferCursor++] = c;
 }
 
+// push n characters at once
+static void push_chars_(Tokenizer* const  tok,
+                        char const* const chars,
+                        size_t const      n) {
+    if (!reserve_chars_(tok, n)) {
+        return;
+    }
+    memcpy(tok->buffer + tok->bufferCursor, chars, n);
+    tok->bufferCursor += n;
+}
+
+// record n characters of the current generic string starting at chars, in the
+// caller's buffer.  the characters of a generic string always come one after
+// the other (the generator only marks states that can go on to finish one
+// without a reset, see run_hints) so keeping the ends is enough.
+static void record_word_(Tokenizer* const  tok,
+                         char const* const chars,
+                         size_t const      n) {
+    if (!tok->wordBegin) {
+        tok->wordBegin = chars;
+    }
+    tok->wordEnd = chars + n;
+}
+
+// copy what's been recorded of the current generic string out of the
+// caller's buffer and into ours.
+static void copy_word_(Tokenizer* const tok) {
+    if (tok->wordBegin) {
+        push_chars_(tok, tok->wordBegin, tok->wordEnd - tok->wordBegin);
+        tok->wordBegin = NULL;
+    }
+}
+
 void push_token_(Tokenizer* const tok, Token const token) {
     if (tok->numTokens == tok->tokenCapacity) {
+        if (tok->fixed) {
+            overflow_(tok);
+            return;
+        }
         // at capacity, realloc
         tok->tokenCapacity *= 2;
         tok->tokens =
@@ -117,72 +283,336 @@ bool tok_invalid(Tokenizer const* tok) {
     return tok->state == 1;
 }
 
-// get_action_ accesses the table, below.  Use the forward declaration to keep
-// the table at the bottom of the file.
-static Action const* get_action_(uint8_t state, char c);
+bool tok_overflow(Tokenizer const* tok) {
+    return tok->overflow;
+}
+
+/*!
+ Most of a header is path and in some states (InGenericWord and InDigits in the
+ generator) a whole set of characters loops back to the same state without a
+ token or a reset.  The generator writes those characters out for each state as
+ a RunHint (see get_run_hint_, below) and, once in one of those states,
+ tok_process finds the whole run of them with the vector unit and records it
+ in one go.  the table picks up again at the first character that isn't one of
+ them.
+
+ characters is a nibble table, bit h of characters[l] is set if the character
+ (h << 4 | l) is in the run.  that's two shuffles to look up 16 or 32
+ characters at once.  numberValue only matters in states that can go on to
+ finish a number (number is set), every other state skips the update.  the
+ same goes for word and generic strings.
+ assert_run_hints_ (from tok_create) checks that the hints agree with the
+ table.
+ */
+struct RunHintTag {
+    // true if the state has any run characters
+    uint8_t run;
+    // true if runs have to keep numberValue up to date
+    uint8_t number;
+    // true if runs have to be recorded as part of a generic string
+    uint8_t word;
+    // the run characters, see above
+    uint8_t characters[16];
+};
+typedef struct RunHintTag RunHint;
+
+// get_run_hint_ accesses the hints, below, next to the tables.
+static RunHint const* get_run_hint_(Grammar const*, uint8_t state);
+
+static bool in_run_(RunHint const* const hint, char const c) {
+    uint8_t const u = (uint8_t)c;
+    return u < 128 && ((hint->characters[u & 0xf] >> (u >> 4)) & 1);
+}
+
+#if !defined(NDEBUG)
+static void assert_grammar_run_hints_(Grammar const* const grammar) {
+    for (uint8_t state = 0; state < grammar->numStates; ++state) {
+        RunHint const* const hint = get_run_hint_(grammar, state);
+        bool                 any  = false;
+        for (int c = 0; c < 256; ++c) {
+            Action const* const action = get_action_(grammar, state, (char)c);
+            bool const loops = action && action->toState == state &&
+                               !action->resetRecording &&
+                               action->token == UnknownToken;
+            // Invalid loops on everything but there's nothing to record
+            assert(state == 1 || loops == in_run_(hint, (char)c));
+            any = any || in_run_(hint, (char)c);
+            if (!action) {
+                continue;
+            }
+            RunHint const* const to = get_run_hint_(grammar, action->toState);
+            // the table records digits and words for exactly the states the
+            // hints do
+            assert(((action->record & RECORD_NUMBER) != 0) == to->number);
+            assert(((action->record & RECORD_WORD) != 0) == to->word);
+            // a state that doesn't keep the number up to date can't hand it
+            // on to one that does
+            assert(hint->number ||
+                   (action->token != SizeToken &&
+                    (action->resetRecording || !to->number)));
+            (void)to;
+        }
+        assert(any == hint->run);
+        (void)any;
+    }
+}
+
+static void assert_run_hints_(void) {
+    // every tokenizer gets here and the answer never changes, only check once.
+    // tokenizers can be made on any thread.
+    static bool checked = false;
+    if (__atomic_load_n(&checked, __ATOMIC_RELAXED)) {
+        return;
+    }
+    for (int id = 0; id < NumGrammars; ++id) {
+        assert_grammar_run_hints_(get_grammar_((TokenizerGrammar)id));
+    }
+    __atomic_store_n(&checked, true, __ATOMIC_RELAXED);
+}
+#endif
+
+
+#if defined(__SSE2__)
+// the length of the run of hint's characters at the start of buffer, 32 at a
+// time.  gives up at the last whole block, the caller finishes up.
+__attribute__((target("avx2"))) static size_t
+run_avx2_(RunHint const* const hint, char const* const buffer, size_t const n) {
+    __m256i const characters = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((__m128i const*)hint->characters));
+    // high nibble to its bit in characters.  8 and up are never in a run.
+    __m256i const bits =
+        _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,
+                         1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m256i const nibble = _mm256_set1_epi8(0xf);
+    size_t        i      = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i const v = _mm256_loadu_si256((__m256i const*)(buffer + i));
+        __m256i const row =
+            _mm256_shuffle_epi8(characters, _mm256_and_si256(v, nibble));
+        __m256i const bit = _mm256_shuffle_epi8(
+            bits, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+        __m256i const  outside = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit),
+                                                  _mm256_setzero_si256());
+        uint32_t const mask    = (uint32_t)_mm256_movemask_epi8(outside);
+        if (mask != 0) {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+    return i;
+}
+
+// as above, 16 at a time.  pshufb is SSSE3 which isn't in the x86_64 baseline.
+__attribute__((target("ssse3"))) static size_t
+run_ssse3_(RunHint const* const hint,
+           char const* const    buffer,
+           size_t const         n) {
+    __m128i const characters =
+        _mm_loadu_si128((__m128i const*)hint->characters);
+    __m128i const bits =
+        _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m128i const nibble = _mm_set1_epi8(0xf);
+    size_t        i      = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i const v   = _mm_loadu_si128((__m128i const*)(buffer + i));
+        __m128i const row =
+            _mm_shuffle_epi8(characters, _mm_and_si128(v, nibble));
+        __m128i const bit =
+            _mm_shuffle_epi8(bits, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+        __m128i const  outside =
+            _mm_cmpeq_epi8(_mm_and_si128(row, bit), _mm_setzero_si128());
+        uint32_t const mask = (uint32_t)_mm_movemask_epi8(outside);
+        if (mask != 0) {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+    return i;
+}
+#endif
+
+// the length of the run of hint's characters at the start of buffer.
+static size_t run_(RunHint const* const hint,
+                   char const* const    buffer,
+                   size_t const         n) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    if (n >= 32 && __builtin_cpu_supports("avx2")) {
+        i = run_avx2_(hint, buffer, n);
+    }
+    // what avx2 left (if it didn't find the end) or all of it
+    if (n - i >= 16 && __builtin_cpu_supports("ssse3")) {
+        i += run_ssse3_(hint, buffer + i, n - i);
+    }
+#endif
+    // the tail (or everything, without the vector unit)
+    while (i < n && in_run_(hint, buffer[i])) {
+        ++i;
+    }
+    return i;
+}
+
+// record the run of hint's characters at the start of buffer and return its
+// length
+static size_t consume_run_(Tokenizer* const     tok,
+                           RunHint const* const hint,
+                           char const* const    buffer,
+                           size_t const         n) {
+    size_t const run = run_(hint, buffer, n);
+    if (hint->word && run > 0) {
+        record_word_(tok, buffer, run);
+    }
+    if (hint->number) {
+        for (size_t j = 0; j < run; ++j) {
+            tok->numberValue *= 10;
+            tok->numberValue += buffer[j] - '0';
+        }
+    }
+    return run;
+}
+
+// finish a token of id.  the current recording is its value, if it has one.
+static void finish_token_(Tokenizer* const tok, TokenId const id) {
+    switch (id) {
+    case UnknownToken:
+    case NumTokens:
+        break;
+    case GetfileToken:
+    case GetToken:
+    case OkToken:
+    case FileNotFoundToken:
+    case ErrorToken:
+    case InvalidToken: {
+        Token const token = {.id = id};
+        push_token_(tok, token);
+        break;
+    }
+    case SizeToken: {
+        Token const token = {.id = SizeToken, .data.size = tok->numberValue};
+        push_token_(tok, token);
+        break;
+    }
+    case PathToken: {
+        Token token = {.id = PathToken};
+        if (tok->slices && tok->wordBegin &&
+            tok->bufferCursor == tok->startOfCurrent) {
+            // the whole path is in the caller's buffer, point at it there.
+            token.data.path.text   = tok->wordBegin;
+            token.data.path.length = tok->wordEnd - tok->wordBegin;
+            tok->wordBegin         = NULL;
+            push_token_(tok, token);
+            break;
+        }
+        // finish and terminate the written path
+        copy_word_(tok);
+        token.data.path.length = tok->bufferCursor - tok->startOfCurrent;
+        push_char_(tok, '\0');
+        // create and push the token
+        token.data.path.text = tok->buffer + tok->startOfCurrent;
+        push_token_(tok, token);
+        // update the start of current to be the next character in the
+        // buffer.
+        tok->startOfCurrent = tok->bufferCursor;
+        break;
+    }
+    }
+}
+
+// this is either the beginning of a generic word (path) or a number (size).
+static void reset_recording_(Tokenizer* const tok) {
+    tok->bufferCursor = tok->startOfCurrent;
+    tok->wordBegin    = NULL;
+    tok->numberValue  = 0;
+}
+
+// nearly every request starts "GETFILE GET /" and every OK response "GETFILE
+// OK ".  if tok hasn't started and buffer starts with one that its grammar
+// takes, push the keywords and go straight to the grammar's InSpace, where the
+// table would have ended up.  returns the number of characters that took, all
+// but the '/' of a request, which is left for the table to record.  0 if it
+// isn't one of them.  the memcmps are a single 8 byte compare and a short one.
+static size_t literal_prefix_(Tokenizer* const  tok,
+                              char const* const buffer,
+                              size_t const      n) {
+    if (tok->state != 0 || n < 11 || memcmp(buffer, "GETFILE ", 8) != 0) {
+        return 0;
+    }
+    TokenId second = UnknownToken;
+    size_t  length = 0;
+    if ((tok->grammar->prefixes & REQUEST_PREFIX) && n >= 13 &&
+        memcmp(buffer + 8, "GET /", 5) == 0) {
+        second = GetToken;
+        length = 12;
+    } else if ((tok->grammar->prefixes & RESPONSE_PREFIX) &&
+               memcmp(buffer + 8, "OK ", 3) == 0) {
+        second = OkToken;
+        length = 11;
+    } else {
+        return 0;
+    }
+    // before the tokens so that an overflow sticks
+    tok->state = tok->grammar->inSpace;
+    finish_token_(tok, GetfileToken);
+    finish_token_(tok, second);
+    return length;
+}
 
 ssize_t tok_process(Tokenizer* const  tok,
                     char const* const buffer,
                     size_t const      n) {
-    size_t i = 0;
+    Grammar const* const grammar = tok->grammar;
+    size_t               i       = literal_prefix_(tok, buffer, n);
     for (; i < n && !tok_done(tok) && !tok_invalid(tok); ++i) {
-        Action const* const action = get_action_(tok->state, buffer[i]);
-        tok->state                 = action->toState;
-        switch (action->token) {
-        case UnknownToken:
-            break;
-        case GetfileToken:
-        case GetToken:
-        case OkToken:
-        case FileNotFoundToken:
-        case ErrorToken:
-        case InvalidToken: {
-            Token const token = {.id = action->token};
-            push_token_(tok, token);
-            break;
+        RunHint const* const hint = get_run_hint_(grammar, tok->state);
+        if (hint->run) {
+            i += consume_run_(tok, hint, buffer + i, n - i);
+            if (i == n) {
+                break;
+            }
         }
-        case SizeToken: {
-            Token const token = {.id        = SizeToken,
-                                 .data.size = tok->numberValue};
-            push_token_(tok, token);
-            break;
+        Action const* const action =
+            get_action_(grammar, tok->state, buffer[i]);
+        tok->state = action->toState;
+        finish_token_(tok, action->token);
+        if (action->resetRecording) {
+            // actions tell us to reset recording.
+            reset_recording_(tok);
         }
-        case PathToken: {
-            // terminate the written path
-            push_char_(tok, '\0');
-            // create and push the token
-            Token const token = {
-                .id        = PathToken,
-                .data.path = tok->buffer + tok->startOfCurrent};
-            push_token_(tok, token);
-            // update the start of current to be the next character in the
-            // buffer.
-            tok->startOfCurrent = tok->bufferCursor;
-            break;
+        // only record what can end up in a token.  keywords, spaces and the
+        // terminator don't.
+        if (action->record & RECORD_WORD) {
+            record_word_(tok, buffer + i, 1);
         }
+        if (action->record & RECORD_NUMBER) {
+            tok->numberValue *= 10;
+            tok->numberValue += buffer[i] - '0';
         }
-        if (action->resetRecording) {
-            // actions tell us to reset recording.  this is either the beginning
-            // of a generic word (path) or a number (size).
-            tok->bufferCursor = tok->startOfCurrent;
-            tok->numberValue  = 0;
-        }
-        // just push the character and update the number regardless of what
-        // state we're in.  we could add more data to the table to tell us when
-        // this is necessary but it doesn't cost us much to do it all of the
-        // time and the text of the table is big enough already.  note that most
-        // transitions reset recording so we not actually accumulating a lot of
-        // characters.
-        push_char_(tok, buffer[i]);
-        tok->numberValue *= 10;
-        tok->numberValue += buffer[i] - '0';
     }
+    // buffer is the caller's, hang on to whatever isn't finished.
+    copy_word_(tok);
     if (tok_invalid(tok)) {
         return -1;
     }
     return i;
 }
 
+ssize_t tok_process_direct(Tokenizer* const  tok,
+                           char const* const buffer,
+                           size_t const      n) {
+    size_t const prefix = literal_prefix_(tok, buffer, n);
+    size_t const processed =
+        prefix +
+        tok->grammar->direct(tok, &tok->state, buffer + prefix, n - prefix);
+    copy_word_(tok);
+    if (tok->overflow) {
+        // the direct code doesn't look at the state until it returns, and then
+        // it writes over it.
+        tok->state = 1;
+    }
+    if (tok_invalid(tok)) {
+        return -1;
+    }
+    return processed;
+}
+
 size_t tok_num_tokens(Tokenizer const* const tok) {
     return tok->numTokens;
 }
@@ -192,15 +622,62 @@ Token tok_token(Tokenizer const* const tok, size_t const i) {
     return tok->tokens[i];
 }
 
+void tok_set_slices(Tokenizer* const tok, bool const slices) {
+    tok->slices = slices;
+}
+
+void tok_set_grammar(Tokenizer* const tok, TokenizerGrammar const grammar) {
+    tok->grammar = get_grammar_(grammar);
+}
+
+void tok_copy_slices(Tokenizer* const tok) {
+    // the copies go in before the string that's being recorded, if any, so
+    // that it stays in one piece.
+    size_t needed = 0;
+    for (size_t i = 0; i < tok->numTokens; ++i) {
+        Token const* const t = tok->tokens + i;
+        if (t->id == PathToken &&
+            buffer_offset_((uintptr_t)tok->buffer,
+                           tok->bufferCapacity,
+                           t->data.path.text) == tok->bufferCapacity) {
+            needed += t->data.path.length + 1;
+        }
+    }
+    if (needed == 0 || !reserve_chars_(tok, needed)) {
+        return;
+    }
+    char* const current = tok->buffer + tok->startOfCurrent;
+    memmove(current + needed, current, tok->bufferCursor - tok->startOfCurrent);
+    char* out = current;
+    for (size_t i = 0; i < tok->numTokens; ++i) {
+        Token* const t = tok->tokens + i;
+        if (t->id == PathToken &&
+            buffer_offset_((uintptr_t)tok->buffer,
+                           tok->bufferCapacity,
+                           t->data.path.text) == tok->bufferCapacity) {
+            memcpy(out, t->data.path.text, t->data.path.length);
+            out[t->data.path.length] = '\0';
+            t->data.path.text        = out;
+            out += t->data.path.length + 1;
+        }
+    }
+    tok->startOfCurrent += needed;
+    tok->bufferCursor += needed;
+}
+
 void tok_reset(Tokenizer* const tok) {
     tok->state          = 0;
     tok->numTokens      = 0;
     tok->startOfCurrent = 0;
     tok->bufferCursor   = 0;
+    tok->wordBegin      = NULL;
     tok->numberValue    = 0;
+    tok->overflow       = false;
 }
 
 void tok_destroy(Tokenizer* const tok) {
+    // see tok_init
+    assert(!tok->fixed);
     free(tok->tokens);
     free(tok->buffer);
     free(tok);
@@ -217,49 +694,178 @@ char const* tok_terminator() {
     return "\r\n\r\n";
 }
 
-char const* token_text_(TokenId const id) {
+static char const* token_text_(TokenId const id) {
 #define TOKEN_TEXT(_ID, _TEXT) _TEXT,
     static char const* const text[] = {TOKEN_ID(TOKEN_TEXT)};
 #undef TOKEN_TEXT
     return text[id];
 }
 
-// sprintf a single token with a string prefix
-static int snprintf_token_(char* const  buffer,
-                           size_t const bufferSize,
-                           char const*  prefix,
-                           Token const* token) {
+static size_t token_text_length_(TokenId const id) {
+#define TOKEN_TEXT_LENGTH(_ID, _TEXT) sizeof(_TEXT) - 1,
+    static uint8_t const lengths[] = {TOKEN_ID(TOKEN_TEXT_LENGTH)};
+#undef TOKEN_TEXT_LENGTH
+    return lengths[id];
+}
+
+// the length of the terminator, see tok_terminator
+#define TERMINATOR_LENGTH 4
+
+// "00" to "99", for formatting numbers two digits at a time
+static char const digitPairs_[] = "00010203040506070809"
+                                  "10111213141516171819"
+                                  "20212223242526272829"
+                                  "30313233343536373839"
+                                  "40414243444546474849"
+                                  "50515253545556575859"
+                                  "60616263646566676869"
+                                  "70717273747576777879"
+                                  "80818283848586878889"
+                                  "90919293949596979899";
+
+// the number of decimal digits in v.  the bit length of v times log10(2)
+// (1233 / 4096) is the number of digits or one more.
+static size_t decimal_digits_(uint64_t const v) {
+    static uint64_t const powers[] = {0,
+                                      10ULL,
+                                      100ULL,
+                                      1000ULL,
+                                      10000ULL,
+                                      100000ULL,
+                                      1000000ULL,
+                                      10000000ULL,
+                                      100000000ULL,
+                                      1000000000ULL,
+                                      10000000000ULL,
+                                      100000000000ULL,
+                                      1000000000000ULL,
+                                      10000000000000ULL,
+                                      100000000000000ULL,
+                                      1000000000000000ULL,
+                                      10000000000000000ULL,
+                                      100000000000000000ULL,
+                                      1000000000000000000ULL,
+                                      10000000000000000000ULL};
+    size_t const guess = (size_t)(64 - __builtin_clzll(v | 1)) * 1233 >> 12;
+    return guess + 1 - (v < powers[guess]);
+}
+
+// write v in decimal to out, from the last digit back, two at a time.
+// returns the number of digits.
+static size_t write_size_(char* const out, uint64_t v) {
+    size_t const n = decimal_digits_(v);
+    char*        at = out + n;
+    while (v >= 100) {
+        at -= 2;
+        memcpy(at, digitPairs_ + 2 * (v % 100), 2);
+        v /= 100;
+    }
+    if (v >= 10) {
+        memcpy(at - 2, digitPairs_ + 2 * v, 2);
+    } else {
+        at[-1] = (char)('0' + v);
+    }
+    return n;
+}
+
+static size_t token_length_(Token const* const token) {
     switch (token->id) {
     case SizeToken:
-        return snprintf(buffer, bufferSize, "%s%zu", prefix, token->data.size);
+        return decimal_digits_(token->data.size);
     case PathToken:
-        return snprintf(buffer, bufferSize, "%s%s", prefix, token->data.path);
+        return token->data.path.length;
     default:
-        return snprintf(
-            buffer, bufferSize, "%s%s", prefix, token_text_(token->id));
+        return token_text_length_(token->id);
+    }
+}
+
+static size_t write_token_(char* const out, Token const* const token) {
+    switch (token->id) {
+    case SizeToken:
+        return write_size_(out, token->data.size);
+    case PathToken:
+        memcpy(out, token->data.path.text, token->data.path.length);
+        return token->data.path.length;
+    default: {
+        size_t const n = token_text_length_(token->id);
+        memcpy(out, token_text_(token->id), n);
+        return n;
+    }
+    }
+}
+
+size_t tokens_length(Token const* const tokens, size_t const numTokens) {
+    // a space between each
+    size_t out = numTokens > 0 ? numTokens - 1 : 0;
+    for (size_t i = 0; i < numTokens; ++i) {
+        out += token_length_(tokens + i);
     }
+    return out + TERMINATOR_LENGTH;
 }
 
-// compute the remaining buffer size, if written > available, return 0.
-// otherwise, return available - written.
-static size_t rem_(size_t const written, size_t const available) {
-    return written > available ? 0 : available - written;
+size_t write_tokens(char* const        buffer,
+                    Token const* const tokens,
+                    size_t const       numTokens) {
+    size_t at = 0;
+    for (size_t i = 0; i < numTokens; ++i) {
+        if (i > 0) {
+            buffer[at++] = ' ';
+        }
+        at += write_token_(buffer + at, tokens + i);
+    }
+    memcpy(buffer + at, tok_terminator(), TERMINATOR_LENGTH);
+    return at + TERMINATOR_LENGTH;
+}
+
+// copy as much of the n characters of text to buffer + *at as fits before
+// bufferSize - 1 (leaving room for the null) and advance *at by n either way.
+static void append_truncated_(char* const       buffer,
+                              size_t const      bufferSize,
+                              size_t* const     at,
+                              char const* const text,
+                              size_t const      n) {
+    if (*at + 1 < bufferSize) {
+        size_t const room = bufferSize - 1 - *at;
+        memcpy(buffer + *at, text, n < room ? n : room);
+    }
+    *at += n;
 }
 
 int snprintf_tokens(char* const  buffer,
                     size_t const bufferSize,
                     Token const* tokens,
                     size_t       numTokens) {
-    size_t      out    = 0;
-    char const* prefix = "";
+    size_t const length = tokens_length(tokens, numTokens);
+    if (length < bufferSize) {
+        write_tokens(buffer, tokens, numTokens);
+        buffer[length] = '\0';
+        return (int)length;
+    }
+    // it doesn't fit.  rare enough to go a token at a time, formatting sizes
+    // and keywords into scratch, room for the longest of either.
+    char   scratch[20];
+    size_t at = 0;
     for (size_t i = 0; i < numTokens; ++i) {
-        out += snprintf_token_(
-            buffer + out, rem_(out, bufferSize), prefix, tokens + i);
-        prefix = " ";
+        if (i > 0) {
+            append_truncated_(buffer, bufferSize, &at, " ", 1);
+        }
+        if (tokens[i].id == PathToken) {
+            append_truncated_(buffer,
+                              bufferSize,
+                              &at,
+                              tokens[i].data.path.text,
+                              tokens[i].data.path.length);
+        } else {
+            size_t const n = write_token_(scratch, tokens + i);
+            append_truncated_(buffer, bufferSize, &at, scratch, n);
+        }
     }
-    out +=
-        snprintf(buffer + out, rem_(out, bufferSize), "%s", tok_terminator());
-    return out;
+    append_truncated_(
+        buffer, bufferSize, &at, tok_terminator(), TERMINATOR_LENGTH);
+    if (bufferSize > 0) {
+        buffer[bufferSize - 1] = '\0';
+    }
+    return (int)length;
 }
 
 /////////////////////////////////////////////////////////
@@ -269,9 +875,11 @@ int snprintf_tokens(char* const  buffer,
 int snprintf_request_get(char* const       buffer,
                          size_t const      n,
                          RequestGet const* request) {
-    Token const tokens[] = {{.id = GetfileToken},
-                            {.id = GetToken},
-                            {.id = PathToken, .data.path = request->path}};
+    Token const tokens[] = {
+        {.id = GetfileToken},
+        {.id = GetToken},
+        {.id        = PathToken,
+         .data.path = {.text = request->path, .length = request->pathLength}}};
     return snprintf_tokens(
         buffer, n, tokens, sizeof(tokens) / sizeof(tokens[0]));
 }
@@ -290,7 +898,9 @@ int unpack_request_get(Tokenizer const* const tok, RequestGet* const request) {
         tok_token(tok, 2).id != PathToken) {
         return -1;
     }
-    request->path = tok_token(tok, 2).data.path;
+    Token const path   = tok_token(tok, 2);
+    request->path       = path.data.path.text;
+    request->pathLength = path.data.path.length;
     return 0;
 }
 
@@ -309,16 +919,56 @@ static TokenId status_to_token_(ResponseStatus const s) {
 #undef OUTPUT_CASE
 }
 
+size_t write_response(char* const buffer, Response const* const response) {
+    Token const tokens[] = {{.id = GetfileToken},
+                            {.id = status_to_token_(response->status)},
+                            {.id = SizeToken, .data.size = response->size}};
+    return write_tokens(buffer, tokens, response->status == OkResponse ? 3 : 2);
+}
+
 int snprintf_response(char* const     buffer,
                       size_t const    n,
                       Response const* response) {
-    Token tokens[] = {{.id = GetfileToken},
-                      {.id = status_to_token_(response->status)},
-                      {.id = SizeToken, .data.size = response->size}};
+    Token const tokens[] = {{.id = GetfileToken},
+                            {.id = status_to_token_(response->status)},
+                            {.id = SizeToken, .data.size = response->size}};
     return snprintf_tokens(
         buffer, n, tokens, response->status == OkResponse ? 3 : 2);
 }
 
+void response_header_init(ResponseHeader* const header,
+                          Response const* const response) {
+    memset(header, 0, sizeof(ResponseHeader));
+    header->response = *response;
+    header->size     = write_response(header->text, response);
+    assert(header->size <= RESPONSE_HEADER_CAPACITY);
+}
+
+// the non-OK headers built by the compiler.  must match snprintf_response.
+#define STATIC_HEADER_TEXT(_TEXT) "GETFILE " _TEXT "\r\n\r\n"
+#define STATIC_RESPONSE_HEADER(_ID, _TEXT)                            \
+    [_ID##Response] = {.response = {.status = _ID##Response},         \
+                       .size = sizeof(STATIC_HEADER_TEXT(_TEXT)) - 1, \
+                       .text = STATIC_HEADER_TEXT(_TEXT)}
+
+static ResponseHeader const staticResponseHeaders_[] = {
+    STATIC_RESPONSE_HEADER(FileNotFound, "FILE_NOT_FOUND"),
+    STATIC_RESPONSE_HEADER(Error, "ERROR"),
+    STATIC_RESPONSE_HEADER(Invalid, "INVALID"),
+};
+
+#undef STATIC_RESPONSE_HEADER
+#undef STATIC_HEADER_TEXT
+
+ResponseHeader const* response_header_static(ResponseStatus const status) {
+    if (status == OkResponse || status < 0 ||
+        (size_t)status >= sizeof(staticResponseHeaders_) /
+                              sizeof(staticResponseHeaders_[0])) {
+        return NULL;
+    }
+    return staticResponseHeaders_ + status;
+}
+
 /// map a TokenId to a status.  return UnknownResponse if the TokenId
 /// doesn't map to any status.
 static ResponseStatus token_to_status_(TokenId const id) {
@@ -366,6 +1016,124 @@ int unpack_response(Tokenizer const* const tok, Response* const request) {
     return 0;
 }
 
+/////////////////////////////////////////////////////////
+// Binary Headers
+/////////////////////////////////////////////////////////
+
+static uint8_t const binaryMagic_[] = {0, 'G', 'F', BINARY_VERSION};
+
+// the offsets in a binary header
+#define BINARY_OPCODE_OFFSET 4
+#define BINARY_PATH_LENGTH_OFFSET 6
+#define BINARY_SIZE_OFFSET 8
+
+// byte by byte so it doesn't matter what the host is.  compilers turn these
+// into plain loads and stores on little endian ones.
+static void write_le_(uint8_t* const out, uint64_t v, size_t const n) {
+    for (size_t i = 0; i < n; ++i, v >>= 8) {
+        out[i] = (uint8_t)v;
+    }
+}
+
+static uint64_t read_le_(uint8_t const* const in, size_t const n) {
+    uint64_t out = 0;
+    for (size_t i = n; i > 0; --i) {
+        out = (out << 8) | in[i - 1];
+    }
+    return out;
+}
+
+// the magic and opcode with the rest zero
+static void write_binary_header_(uint8_t* const     buffer,
+                                 BinaryOpcode const opcode) {
+    memset(buffer, 0, BINARY_HEADER_SIZE);
+    memcpy(buffer, binaryMagic_, sizeof(binaryMagic_));
+    buffer[BINARY_OPCODE_OFFSET] = (uint8_t)opcode;
+}
+
+bool is_binary_header(uint8_t const* const buffer, size_t const n) {
+    assert(n > 0);
+    return buffer[0] == binaryMagic_[0];
+}
+
+size_t write_binary_request_get(uint8_t* const          buffer,
+                                RequestGet const* const request) {
+    assert(request->pathLength <= BINARY_MAX_PATH);
+    write_binary_header_(buffer, BinaryGetOpcode);
+    write_le_(buffer + BINARY_PATH_LENGTH_OFFSET, request->pathLength, 2);
+    memcpy(buffer + BINARY_HEADER_SIZE, request->path, request->pathLength);
+    return BINARY_HEADER_SIZE + request->pathLength;
+}
+
+// check the start of a header in the n bytes in buffer: the magic and an
+// opcode from first to last.  returns 1 if it's all there, 0 if it's right so
+// far but cut short, and -1 if it's wrong.
+static int check_binary_header_(uint8_t const* const buffer,
+                                size_t const         n,
+                                BinaryOpcode const   first,
+                                BinaryOpcode const   last) {
+    size_t const magic = n < sizeof(binaryMagic_) ? n : sizeof(binaryMagic_);
+    if (memcmp(buffer, binaryMagic_, magic) != 0) {
+        return -1;
+    }
+    if (n <= BINARY_OPCODE_OFFSET) {
+        return 0;
+    }
+    uint8_t const opcode = buffer[BINARY_OPCODE_OFFSET];
+    if (opcode < first || opcode > last) {
+        return -1;
+    }
+    return n < BINARY_HEADER_SIZE ? 0 : 1;
+}
+
+ssize_t unpack_binary_request_get(uint8_t const* const buffer,
+                                  size_t const         n,
+                                  RequestGet* const    request) {
+    int const check =
+        check_binary_header_(buffer, n, BinaryGetOpcode, BinaryGetOpcode);
+    if (check <= 0) {
+        return check;
+    }
+    size_t const pathLength =
+        (size_t)read_le_(buffer + BINARY_PATH_LENGTH_OFFSET, 2);
+    if (pathLength == 0 || pathLength > BINARY_MAX_PATH) {
+        return -1;
+    }
+    if (n < BINARY_HEADER_SIZE + pathLength) {
+        return 0;
+    }
+    request->path       = (char const*)buffer + BINARY_HEADER_SIZE;
+    request->pathLength = pathLength;
+    return (ssize_t)(BINARY_HEADER_SIZE + pathLength);
+}
+
+void write_binary_response(uint8_t* const        buffer,
+                           Response const* const response) {
+    assert(response->status >= OkResponse &&
+           response->status <= InvalidResponse);
+    write_binary_header_(buffer,
+                         (BinaryOpcode)(BinaryOkOpcode + response->status));
+    if (response->status == OkResponse) {
+        write_le_(buffer + BINARY_SIZE_OFFSET, response->size, 8);
+    }
+}
+
+ssize_t unpack_binary_response(uint8_t const* const buffer,
+                               size_t const         n,
+                               Response* const      response) {
+    int const check = check_binary_header_(
+        buffer, n, BinaryOkOpcode, BinaryInvalidOpcode);
+    if (check <= 0) {
+        return check;
+    }
+    response->status =
+        (ResponseStatus)(buffer[BINARY_OPCODE_OFFSET] - BinaryOkOpcode);
+    response->size = response->status == OkResponse
+                         ? (size_t)read_le_(buffer + BINARY_SIZE_OFFSET, 8)
+                         : 0;
+    return BINARY_HEADER_SIZE;
+}
+
 /////////////////////////////////////////////////////////
 // Socket Helpers
 /////////////////////////////////////////////////////////
@@ -385,378 +1153,394 @@ ssize_t sock_send_all(int const            socketId,
     return numSent;
 }
 
-Action const* get_action_(uint8_t const state, char const c) {
-    // Table generated by generator in:
-    // https://github.com/banjo74/omscs-cs6200-pr1.git
-    // character_class maps a character to its class
-    // action_table maps state X character class to action
-    static uint8_t const character_class[128] = {
-        1,  0, 0,  0,  0, 0, 0,  0, 0,  0,  2,  0, 0,  3,  0,  0, 0,  0, 0,
-        0,  0, 0,  0,  0, 0, 0,  0, 0,  0,  0,  0, 0,  4,  5,  5, 5,  5, 5,
-        5,  5, 5,  5,  5, 5, 5,  5, 5,  6,  7,  7, 7,  7,  7,  7, 7,  7, 7,
-        7,  5, 5,  5,  5, 5, 5,  5, 8,  5,  5,  9, 10, 11, 12, 5, 13, 5, 14,
-        15, 5, 16, 17, 5, 5, 18, 5, 19, 20, 21, 5, 5,  5,  5,  5, 5,  5, 5,
-        22, 5, 5,  5,  5, 5, 5,  5, 5,  5,  5,  5, 5,  5,  5,  5, 5,  5, 5,
-        5,  5, 5,  5,  5, 5, 5,  5, 5,  5,  5,  5, 5,  0};
-    static Action const action_table[44][23] = {
-        {{1, 0, UnknownToken},  {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {3, 1, UnknownToken},  {1, 0, UnknownToken},
-         {5, 1, UnknownToken},  {4, 1, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {13, 1, UnknownToken}, {18, 1, UnknownToken},
-         {34, 1, UnknownToken}, {6, 1, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken},  {32, 1, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken},  {2, 1, UnknownToken},  {1, 0, UnknownToken},
-         {41, 1, UnknownToken}, {3, 1, UnknownToken},  {1, 0, UnknownToken},
-         {5, 1, UnknownToken},  {4, 1, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {13, 1, UnknownToken}, {18, 1, UnknownToken},
-         {34, 1, UnknownToken}, {6, 1, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken},  {32, 1, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {2, 0, SizeToken},    {1, 0, UnknownToken},
-         {41, 0, SizeToken},   {3, 0, SizeToken},    {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {4, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {2, 0, PathToken},    {1, 0, UnknownToken},
-         {41, 0, PathToken},   {3, 0, PathToken},    {5, 0, UnknownToken},
-         {5, 0, UnknownToken}, {5, 0, UnknownToken}, {5, 0, UnknownToken},
-         {5, 0, UnknownToken}, {5, 0, UnknownToken}, {5, 0, UnknownToken},
-         {5, 0, UnknownToken}, {5, 0, UnknownToken}, {5, 0, UnknownToken},
-         {5, 0, UnknownToken}, {5, 0, UnknownToken}, {5, 0, UnknownToken},
-         {5, 0, UnknownToken}, {5, 0, UnknownToken}, {5, 0, UnknownToken},
-         {5, 0, UnknownToken}, {5, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {7, 1, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {8, 1, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {9, 1, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {10, 1, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {11, 1, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {12, 1, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken},  {2, 1, InvalidToken}, {1, 0, UnknownToken},
-         {41, 1, InvalidToken}, {3, 1, InvalidToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {14, 1, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {15, 1, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {16, 1, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {17, 1, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {2, 1, ErrorToken},   {1, 0, UnknownToken},
-         {41, 1, ErrorToken},  {3, 1, ErrorToken},   {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {19, 1, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {20, 1, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {21, 1, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {22, 1, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {23, 1, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {24, 1, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {25, 1, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {26, 1, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {27, 1, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {28, 1, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {29, 1, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {30, 1, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {31, 1, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken},      {2, 1, FileNotFoundToken},
-         {1, 0, UnknownToken},      {41, 1, FileNotFoundToken},
-         {3, 1, FileNotFoundToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},      {1, 0, UnknownToken},
-         {1, 0, UnknownToken},      {1, 0, UnknownToken},
-         {1, 0, UnknownToken},      {1, 0, UnknownToken},
-         {1, 0, UnknownToken},      {1, 0, UnknownToken},
-         {1, 0, UnknownToken},      {1, 0, UnknownToken},
-         {1, 0, UnknownToken},      {1, 0, UnknownToken},
-         {1, 0, UnknownToken},      {1, 0, UnknownToken},
-         {1, 0, UnknownToken},      {1, 0, UnknownToken},
-         {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {33, 1, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {2, 1, OkToken},      {1, 0, UnknownToken},
-         {41, 1, OkToken},     {3, 1, OkToken},      {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {35, 1, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {36, 1, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {2, 1, GetToken},     {1, 0, UnknownToken},
-         {41, 1, GetToken},    {3, 1, GetToken},     {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {37, 1, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {38, 1, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {39, 1, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {40, 1, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken},  {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken},  {2, 1, GetfileToken}, {1, 0, UnknownToken},
-         {41, 1, GetfileToken}, {3, 1, GetfileToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken}, {42, 1, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {43, 1, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken},  {1, 0, UnknownToken}},
-        {{1, 0, UnknownToken}, {1, 0, UnknownToken}, {2, 1, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}, {1, 0, UnknownToken},
-         {1, 0, UnknownToken}, {1, 0, UnknownToken}}};
-    if (c >= sizeof(character_class) / sizeof(character_class[0])) {
-        return NULL;
+int sock_enable_zerocopy(int const socketId) {
+#if defined(GF_HAVE_ZEROCOPY)
+    int const optionValue = 1;
+    if (setsockopt(socketId,
+                   SOL_SOCKET,
+                   SO_ZEROCOPY,
+                   &optionValue,
+                   sizeof(optionValue)) == -1) {
+        return -1;
+    }
+    return 0;
+#else
+    (void)socketId;
+    return -1;
+#endif
+}
+
+// a buffer zc_send was given.  its sends are ids [firstId, firstId + numIds).
+typedef struct {
+    uint8_t const* buffer;
+    ZcReleaseFcn   release;
+    void*          releaseArg;
+    uint32_t       firstId;
+    uint32_t       numIds;
+    uint32_t       numDone;
+    // set once zc_send has made all of its sends
+    bool sealed;
+} ZcBuffer;
+
+struct ZerocopySendsTag {
+    int socketId;
+    // the id the kernel will give the next send
+    uint32_t nextId;
+    size_t   outstanding;
+    bool     copied;
+    // the ones that aren't released yet, in the order they were sent
+    ZcBuffer* buffers;
+    size_t    numBuffers;
+    size_t    capacity;
+};
+
+ZerocopySends* zc_create(int const socketId) {
+    ZerocopySends* const out = (ZerocopySends*)calloc(1, sizeof(ZerocopySends));
+    out->socketId            = socketId;
+    return out;
+}
+
+int zc_destroy(ZerocopySends* const zs) {
+    if (!zs) {
+        return 0;
     }
-    return &action_table[state][character_class[(size_t)c]];
+    int const out = zc_reap(zs, true);
+    free(zs->buffers);
+    free(zs);
+    return out;
+}
+
+size_t zc_outstanding(ZerocopySends const* const zs) {
+    return zs->outstanding;
+}
+
+bool zc_copied(ZerocopySends const* const zs) {
+    return zs->copied;
+}
+
+#if defined(GF_HAVE_ZEROCOPY)
+// hand back the buffers whose sends are all done, keeping the rest in order.
+static void zc_release_done_(ZerocopySends* const zs) {
+    size_t kept = 0;
+    for (size_t i = 0; i < zs->numBuffers; ++i) {
+        ZcBuffer const b = zs->buffers[i];
+        if (!b.sealed || b.numDone < b.numIds) {
+            zs->buffers[kept++] = b;
+        } else if (b.release) {
+            b.release(b.buffer, b.releaseArg);
+        }
+    }
+    zs->numBuffers = kept;
+}
+
+// the kernel's done with sends [first, last].  they usually come in order but
+// needn't, so count them against every buffer they overlap.  the ids wrap, so
+// measure everything from the oldest buffer's first id in 32 bits.
+static void zc_complete_(ZerocopySends* const zs,
+                         uint32_t const       first,
+                         uint32_t const       last) {
+    if (zs->numBuffers == 0) {
+        return;
+    }
+    uint32_t const base = zs->buffers[0].firstId;
+    uint32_t const low  = first - base;
+    uint32_t const high = last - base + 1;
+    for (size_t i = 0; i < zs->numBuffers; ++i) {
+        ZcBuffer* const b       = zs->buffers + i;
+        uint32_t const  bLow    = b->firstId - base;
+        uint32_t const  bHigh   = bLow + b->numIds;
+        uint32_t const  from    = low > bLow ? low : bLow;
+        uint32_t const  to      = high < bHigh ? high : bHigh;
+        uint32_t const  overlap = from < to ? to - from : 0;
+        b->numDone += overlap;
+        zs->outstanding -= overlap;
+    }
+}
+
+// read the notifications on the error queue without waiting.  returns the
+// number of sends they completed or -1 on failure.
+static ssize_t zc_read_completions_(ZerocopySends* const zs) {
+    ssize_t completed = 0;
+    for (;;) {
+        char          control[128];
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control    = control;
+        msg.msg_controllen = sizeof(control);
+        if (recvmsg(zs->socketId, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) == -1) {
+            return errno == EAGAIN || errno == EWOULDBLOCK ? completed : -1;
+        }
+        for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+             cmsg                 = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level != IPPROTO_IP &&
+                cmsg->cmsg_level != IPPROTO_IPV6) {
+                continue;
+            }
+            struct sock_extended_err const* const err =
+                (struct sock_extended_err const*)CMSG_DATA(cmsg);
+            if (err->ee_origin != SO_EE_ORIGIN_ZEROCOPY || err->ee_errno != 0) {
+                continue;
+            }
+            // notifications cover the range of send ids [ee_info, ee_data].
+            zc_complete_(zs, err->ee_info, err->ee_data);
+            completed += (uint32_t)(err->ee_data - err->ee_info) + 1;
+            if (err->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) {
+                zs->copied = true;
+            }
+        }
+    }
+}
+
+// read completions until no more than target sends are outstanding, waiting
+// for them if need be.  SIZE_MAX just reads what's there.
+static int zc_reap_to_(ZerocopySends* const zs, size_t const target) {
+    int  status = 0;
+    bool hungUp = false;
+    for (;;) {
+        ssize_t const completed = zc_read_completions_(zs);
+        if (completed < 0) {
+            status = -1;
+            break;
+        }
+        if (zs->outstanding <= target) {
+            break;
+        }
+        if (completed == 0 && hungUp) {
+            // the connection's gone and nothing else is coming.
+            status = -1;
+            break;
+        }
+        // the error queue is reported as POLLERR which is always polled for.
+        struct pollfd pfd;
+        memset(&pfd, 0, sizeof(pfd));
+        pfd.fd = zs->socketId;
+        if (poll(&pfd, 1, -1) == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            status = -1;
+            break;
+        }
+        if (pfd.revents & POLLNVAL) {
+            status = -1;
+            break;
+        }
+        if (pfd.revents & POLLERR) {
+            // could be the socket's own error, e.g., the other end reset the
+            // connection.  reading it clears it.  the kernel still sends the
+            // notifications as it drops the data, so keep waiting for those.
+            int       error    = 0;
+            socklen_t errorLen = sizeof(error);
+            getsockopt(zs->socketId, SOL_SOCKET, SO_ERROR, &error, &errorLen);
+        }
+        hungUp = pfd.revents & POLLHUP;
+    }
+    zc_release_done_(zs);
+    return status;
+}
+#endif
+
+int zc_reap(ZerocopySends* const zs, bool const wait) {
+#if defined(GF_HAVE_ZEROCOPY)
+    return zc_reap_to_(zs, wait ? 0 : SIZE_MAX);
+#else
+    (void)zs;
+    (void)wait;
+    return 0;
+#endif
+}
+
+ssize_t zc_send(ZerocopySends* const zs,
+                uint8_t const* const buffer,
+                size_t const         n,
+                ZcReleaseFcn const   release,
+                void* const          releaseArg) {
+#if defined(GF_HAVE_ZEROCOPY)
+    if (zs->numBuffers == zs->capacity) {
+        size_t const capacity = zs->capacity ? 2 * zs->capacity : 8;
+        void* const  buffers =
+            realloc(zs->buffers, capacity * sizeof(ZcBuffer));
+        if (!buffers) {
+            // can't keep track of it, so copy it
+            ssize_t const out = sock_send_all(zs->socketId, buffer, n);
+            if (release) {
+                release(buffer, releaseArg);
+            }
+            return out;
+        }
+        zs->buffers  = (ZcBuffer*)buffers;
+        zs->capacity = capacity;
+    }
+    // reaping can move it, but it stays last
+    zs->buffers[zs->numBuffers++] = (ZcBuffer){.buffer     = buffer,
+                                               .release    = release,
+                                               .releaseArg = releaseArg,
+                                               .firstId    = zs->nextId};
+    ssize_t status  = (ssize_t)n;
+    size_t  numSent = 0;
+    while (numSent < n) {
+        ssize_t const localSent =
+            send(zs->socketId, buffer + numSent, n - numSent, MSG_ZEROCOPY);
+        if (localSent > 0) {
+            // every send that succeeds gets exactly one notification.
+            numSent += (size_t)localSent;
+            ++zs->nextId;
+            ++zs->buffers[zs->numBuffers - 1].numIds;
+            ++zs->outstanding;
+            continue;
+        }
+        if (localSent == -1 && errno == ENOBUFS) {
+            // the socket has run out of option memory to track pinned pages.
+            if (zs->outstanding == 0) {
+                // nothing to wait on, just copy the rest.
+                zs->copied = true;
+                if (sock_send_all(zs->socketId, buffer + numSent, n - numSent) <
+                    0) {
+                    status = -1;
+                }
+                break;
+            }
+            // wait for some of the pinned pages to be released and try again
+            if (zc_reap_to_(zs, zs->outstanding - 1) != 0) {
+                status = -1;
+                break;
+            }
+            continue;
+        }
+        status = -1;
+        break;
+    }
+    zs->buffers[zs->numBuffers - 1].sealed = true;
+    // if none of it's pinned it's done already
+    zc_release_done_(zs);
+    return status;
+#else
+    ssize_t const out = sock_send_all(zs->socketId, buffer, n);
+    zs->copied        = true;
+    if (release) {
+        release(buffer, releaseArg);
+    }
+    return out;
+#endif
+}
+
+/*!
+ The hooks for the direct coded tokenizers in the tables, below.  see
+ write_table in the generator for what each has to do.  ctx, buffer, n and i
+ are in scope.
+ */
+#define DIRECT_RUN(_STATE)                                               \
+    consume_run_(ctx,                                                    \
+                 get_run_hint_(ctx->grammar, (_STATE)),                  \
+                 buffer + i,                                             \
+                 n - i)
+#define DIRECT_TOKEN(_ID) finish_token_(ctx, (_ID))
+#define DIRECT_RESET()    reset_recording_(ctx)
+// c was just read from buffer[i - 1]
+#define DIRECT_PUSH(_C)   record_word_(ctx, buffer + i - 1, 1)
+#define DIRECT_DIGIT(_C) \
+    (ctx->numberValue = ctx->numberValue * 10 + (size_t)((_C) - '0'))
+
+/*!
+ The tables for each grammar, generated from any.grammar, request.grammar and
+ response.grammar by the generator in:
+ https://github.com/banjo74/omscs-cs6200-pr1.git
+ with --direct.  don't edit the headers, edit the grammar and run make grammars
+ (see module.mk).
+
+ character_class maps a character to its class and action_table maps state and
+ class to action in whichever --layout the headers were written with, they say
+ which in <NAME>_TABLE_LAYOUT and get_action_ follows it.  make grammars writes
+ transposed, class X state, so the state, the only thing that depends on the
+ previous character, goes last in the address.  tok_direct_ is the same graph
+ as straight line code.
+ */
+// the --layout values, in the generator's TableLayout order
+#define LAYOUT_STRUCT_     0
+#define LAYOUT_PACKED_     1
+#define LAYOUT_FUSED_      2
+#define LAYOUT_TRANSPOSED_ 3
+// how --layout packed writes an action, Action is already 16 bits
+#define ACTION(_TO_STATE, _RESET, _TOKEN, _RECORD) \
+    {(_TO_STATE), (_RESET), (_TOKEN), (_RECORD)}
+
+#include "any-grammar.h"
+#include "request-grammar.h"
+#include "response-grammar.h"
+
+#undef DIRECT_RUN
+#undef DIRECT_TOKEN
+#undef DIRECT_RESET
+#undef DIRECT_PUSH
+#undef DIRECT_DIGIT
+#undef ACTION
+
+#if !defined(ANY_TABLE_LAYOUT) || !defined(REQUEST_TABLE_LAYOUT) || \
+    !defined(RESPONSE_TABLE_LAYOUT)
+#error "grammar headers without a layout, run make grammars"
+#endif
+#if REQUEST_TABLE_LAYOUT != ANY_TABLE_LAYOUT || \
+    RESPONSE_TABLE_LAYOUT != ANY_TABLE_LAYOUT
+#error "the grammar headers have to be written with the same --layout"
+#endif
+#define TABLE_LAYOUT_ ANY_TABLE_LAYOUT
+
+// a table's dimensions, states and classes are one each way around
+#define NUM_ROWS(_TABLE)    (sizeof(_TABLE) / sizeof((_TABLE)[0]))
+#define NUM_COLUMNS(_TABLE) (sizeof((_TABLE)[0]) / sizeof((_TABLE)[0][0]))
+#if TABLE_LAYOUT_ == LAYOUT_TRANSPOSED_
+#define NUM_STATES  NUM_COLUMNS
+#define NUM_CLASSES NUM_ROWS
+#else
+#define NUM_STATES  NUM_ROWS
+#define NUM_CLASSES NUM_COLUMNS
+#endif
+#define GRAMMAR(_NAME, _PREFIXES)        \
+    {NUM_STATES(_NAME##_action_table_),  \
+     NUM_CLASSES(_NAME##_action_table_), \
+     _NAME##_character_class_,           \
+     _NAME##_action_table_[0],           \
+     _NAME##_run_hints_,                 \
+     _NAME##_tok_direct_,                \
+     (_PREFIXES),                        \
+     _NAME##_in_space_state_}
+
+static Grammar const grammars_[NumGrammars] = {
+    [AnyGrammar]      = GRAMMAR(any, REQUEST_PREFIX | RESPONSE_PREFIX),
+    [RequestGrammar]  = GRAMMAR(request, REQUEST_PREFIX),
+    [ResponseGrammar] = GRAMMAR(response, RESPONSE_PREFIX),
+};
+
+#undef GRAMMAR
+#undef NUM_CLASSES
+#undef NUM_STATES
+#undef NUM_COLUMNS
+#undef NUM_ROWS
+
+Grammar const* get_grammar_(TokenizerGrammar const id) {
+    return &grammars_[id];
+}
+
+Action const* get_action_(Grammar const* const grammar,
+                          uint8_t const        state,
+                          char const           c) {
+    // anything past ascii is in class 0 with the control characters, invalid
+    // everywhere, like the direct code has it.
+    unsigned char const u = (unsigned char)c;
+#if TABLE_LAYOUT_ == LAYOUT_FUSED_
+    // character 0 is in class 0 too
+    return grammar->actions + state * grammar->numClasses + (u < 128 ? u : 0);
+#else
+    size_t const k = u < 128 ? grammar->characterClass[u] : 0;
+#if TABLE_LAYOUT_ == LAYOUT_TRANSPOSED_
+    return grammar->actions + k * grammar->numStates + state;
+#else
+    return grammar->actions + state * grammar->numClasses + k;
+#endif
+#endif
+}
+
+RunHint const* get_run_hint_(Grammar const* const grammar,
+                             uint8_t const        state) {
+    return grammar->runHints + state;
 }
@@ -6,5 +6,17 @@
  
  #include "gfclient.h"
  #include "gf-student.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// speak protocol to the server (see GfProtocol in gf-student.h).
+// GfTextProtocol, GETFILE, by default.
+void gfc_set_protocol(gfcrequest_t** gfr, GfProtocol protocol);
+
+#ifdef __cplusplus
+}
+#endif
  
  #endif // __GF_CLIENT_STUDENT_H__
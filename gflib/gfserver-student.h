@@ -25,6 +25,52 @@ int gfserver_listen(gfserver_t**);
 // get the port of the server
 unsigned short gfserver_port(gfserver_t**);
 
+// sends of at least threshold bytes go out with MSG_ZEROCOPY so the kernel pins
+// the handler's buffer instead of copying it.  0 (the default) turns it off.
+// falls back to regular sends where the platform or socket doesn't support it
+// and for the rest of a connection once the kernel reports that it copied
+// anyway (as it always does over loopback).
+void gfserver_set_zerocopy_threshold(gfserver_t**, size_t threshold);
+
+// called once the kernel is done with a buffer passed to gfs_send.
+typedef void (*SendReleaseFcn)(void const* data, void* releaseArg);
+
+// by default gfs_send returns once the kernel is done with data, which for a
+// zero copy send is when the client has acknowledged it.  with a release
+// function gfs_send returns as soon as data is queued and calls release(data,
+// releaseArg), possibly from a later gfs_send or as the connection closes, when
+// the handler may reuse or free it.  a plain send releases it before it
+// returns.  data is never released if the connection fails while the kernel
+// still holds it.
+void gfserver_set_send_release_fcn(gfserver_t**,
+                                   SendReleaseFcn,
+                                   void* releaseArg);
+
+// how gfserver_serve waits for connections and reads request headers.
+typedef enum {
+    // select on the listening socket and read each header in turn.  default.
+    SelectServerBackend,
+    // io_uring: a multishot accept and the headers of many connections read at
+    // once into registered buffers.  falls back to select where io_uring (or
+    // the features it needs) isn't available.
+    IoUringServerBackend,
+} ServerBackend;
+
+void gfserver_set_backend(gfserver_t**, ServerBackend);
+
+// the backend in use.  once serving starts, this is SelectServerBackend if
+// io_uring was asked for but isn't available.
+ServerBackend gfserver_backend(gfserver_t**);
+
+// defined in gf-student.h
+struct ResponseHeaderTag;
+
+// like gfs_sendheader but sends a header that's already been serialized (see
+// ResponseHeader in gf-student.h), e.g., one cached with the content.  the
+// status and size come from the header.
+ssize_t gfs_sendheader_prepared(gfcontext_t**,
+                                struct ResponseHeaderTag const* header);
+
 // destroy server
 void gfserver_destroy(gfserver_t**);
 
@@ -0,0 +1,1120 @@
+// generated from request.grammar by generator, do not edit
+static uint8_t const request_character_class_[128] = {1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 6, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 7, 8, 9, 5, 10, 5, 5, 11, 5, 5, 5, 5, 5, 5, 5, 12, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 0};
+static Action const request_action_table_[13][16] = {
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{2,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{2,
+0,
+PathToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{2,
+1,
+GetToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{2,
+1,
+GetfileToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{14,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{2,
+1,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{13,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{13,
+0,
+PathToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{13,
+1,
+GetToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{13,
+1,
+GetfileToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{15,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{3,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{3,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{3,
+0,
+PathToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{3,
+1,
+GetToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{3,
+1,
+GetfileToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{5,
+0,
+UnknownToken,
+1},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{5,
+1,
+UnknownToken,
+1},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{5,
+1,
+UnknownToken,
+1},
+{1,
+0,
+UnknownToken,
+0},
+{5,
+0,
+UnknownToken,
+1},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{5,
+0,
+UnknownToken,
+1},
+{7,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{12,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{5,
+0,
+UnknownToken,
+1},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{9,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{6,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{6,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{5,
+0,
+UnknownToken,
+1},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{5,
+0,
+UnknownToken,
+1},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{10,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{5,
+0,
+UnknownToken,
+1},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{11,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{5,
+0,
+UnknownToken,
+1},
+{1,
+0,
+UnknownToken,
+0},
+{8,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}}};
+static RunHint const request_run_hints_[16] = {
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{1, 0, 1, {248, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 124}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}};
+
+static uint8_t const request_in_space_state_ = 3;
+
+#define REQUEST_TABLE_LAYOUT 3 // transposed
+
+static size_t request_tok_direct_(Tokenizer* const ctx, uint8_t* const state, char const* const buffer, size_t const n) {
+    size_t i = 0;
+    char   c;
+    (void)ctx;
+    switch (*state) {
+    case 0:
+        goto s0;
+    case 1:
+        goto s1;
+    case 2:
+        goto s2;
+    case 3:
+        goto s3;
+    case 4:
+        goto s4;
+    case 5:
+        goto s5;
+    case 6:
+        goto s6;
+    case 7:
+        goto s7;
+    case 8:
+        goto s8;
+    case 9:
+        goto s9;
+    case 10:
+        goto s10;
+    case 11:
+        goto s11;
+    case 12:
+        goto s12;
+    case 13:
+        goto s13;
+    case 14:
+        goto s14;
+    case 15:
+        goto s15;
+    default:
+        goto s1;
+    }
+s0:
+    if (i == n) {
+        *state = 0;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? request_character_class_[(size_t)c] : 0) {
+    case 4:
+        goto s3;
+    case 6:
+        DIRECT_RESET();
+        DIRECT_PUSH(c);
+        goto s5;
+    case 9:
+        goto s6;
+    default:
+        goto s1;
+    }
+s1:
+    *state = 1;
+    return i;
+s2:
+    *state = 2;
+    return i;
+s3:
+    if (i == n) {
+        *state = 3;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? request_character_class_[(size_t)c] : 0) {
+    case 1:
+        goto s2;
+    case 3:
+        goto s13;
+    case 4:
+        goto s3;
+    case 6:
+        DIRECT_RESET();
+        DIRECT_PUSH(c);
+        goto s5;
+    case 9:
+        goto s6;
+    default:
+        goto s1;
+    }
+s4:
+    if (i == n) {
+        *state = 4;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? request_character_class_[(size_t)c] : 0) {
+    default:
+        goto s1;
+    }
+s5:
+    i += DIRECT_RUN(5);
+    if (i == n) {
+        *state = 5;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? request_character_class_[(size_t)c] : 0) {
+    case 1:
+        DIRECT_TOKEN(PathToken);
+        goto s2;
+    case 3:
+        DIRECT_TOKEN(PathToken);
+        goto s13;
+    case 4:
+        DIRECT_TOKEN(PathToken);
+        goto s3;
+    case 5:
+    case 6:
+    case 7:
+    case 8:
+    case 9:
+    case 10:
+    case 11:
+    case 12:
+        DIRECT_PUSH(c);
+        goto s5;
+    default:
+        goto s1;
+    }
+s6:
+    if (i == n) {
+        *state = 6;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? request_character_class_[(size_t)c] : 0) {
+    case 7:
+        goto s7;
+    default:
+        goto s1;
+    }
+s7:
+    if (i == n) {
+        *state = 7;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? request_character_class_[(size_t)c] : 0) {
+    case 12:
+        goto s8;
+    default:
+        goto s1;
+    }
+s8:
+    if (i == n) {
+        *state = 8;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? request_character_class_[(size_t)c] : 0) {
+    case 1:
+        DIRECT_TOKEN(GetToken);
+        goto s2;
+    case 3:
+        DIRECT_TOKEN(GetToken);
+        goto s13;
+    case 4:
+        DIRECT_TOKEN(GetToken);
+        goto s3;
+    case 8:
+        goto s9;
+    default:
+        goto s1;
+    }
+s9:
+    if (i == n) {
+        *state = 9;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? request_character_class_[(size_t)c] : 0) {
+    case 10:
+        goto s10;
+    default:
+        goto s1;
+    }
+s10:
+    if (i == n) {
+        *state = 10;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? request_character_class_[(size_t)c] : 0) {
+    case 11:
+        goto s11;
+    default:
+        goto s1;
+    }
+s11:
+    if (i == n) {
+        *state = 11;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? request_character_class_[(size_t)c] : 0) {
+    case 7:
+        goto s12;
+    default:
+        goto s1;
+    }
+s12:
+    if (i == n) {
+        *state = 12;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? request_character_class_[(size_t)c] : 0) {
+    case 1:
+        DIRECT_TOKEN(GetfileToken);
+        goto s2;
+    case 3:
+        DIRECT_TOKEN(GetfileToken);
+        goto s13;
+    case 4:
+        DIRECT_TOKEN(GetfileToken);
+        goto s3;
+    default:
+        goto s1;
+    }
+s13:
+    if (i == n) {
+        *state = 13;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? request_character_class_[(size_t)c] : 0) {
+    case 2:
+        goto s14;
+    default:
+        goto s1;
+    }
+s14:
+    if (i == n) {
+        *state = 14;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? request_character_class_[(size_t)c] : 0) {
+    case 3:
+        goto s15;
+    default:
+        goto s1;
+    }
+s15:
+    if (i == n) {
+        *state = 15;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? request_character_class_[(size_t)c] : 0) {
+    case 2:
+        goto s2;
+    default:
+        goto s1;
+    }
+}
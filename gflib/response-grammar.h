@@ -0,0 +1,4432 @@
+// generated from response.grammar by generator, do not edit
+static uint8_t const response_character_class_[128] = {1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 0, 0, 0, 0, 0, 0, 0, 6, 0, 0, 7, 8, 9, 10, 0, 11, 0, 12, 13, 0, 14, 15, 0, 0, 16, 0, 17, 18, 19, 0, 0, 0, 0, 0, 0, 0, 0, 20, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+static Action const response_action_table_[21][44] = {
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{2,
+1,
+UnknownToken,
+0},
+{2,
+0,
+SizeToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{2,
+1,
+InvalidToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{2,
+1,
+ErrorToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{2,
+1,
+FileNotFoundToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{2,
+1,
+OkToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{2,
+1,
+GetfileToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{42,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{2,
+1,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{41,
+1,
+UnknownToken,
+0},
+{41,
+0,
+SizeToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{41,
+1,
+InvalidToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{41,
+1,
+ErrorToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{41,
+1,
+FileNotFoundToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{41,
+1,
+OkToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{41,
+1,
+GetfileToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{43,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{3,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{3,
+1,
+UnknownToken,
+0},
+{3,
+0,
+SizeToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{3,
+1,
+InvalidToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{3,
+1,
+ErrorToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{3,
+1,
+FileNotFoundToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{3,
+1,
+OkToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{3,
+1,
+GetfileToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{4,
+1,
+UnknownToken,
+2},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{4,
+1,
+UnknownToken,
+2},
+{4,
+0,
+UnknownToken,
+2},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{9,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{12,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{31,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{13,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{13,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{21,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{35,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{40,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{18,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{18,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{27,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{37,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{34,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{34,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{6,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{6,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{11,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{19,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{38,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{33,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{10,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{20,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{39,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{7,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{23,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{30,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{32,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{32,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{16,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{24,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{28,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{14,
+1,
+UnknownToken,
+0},
+{15,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{17,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{25,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{36,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{29,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{8,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}},
+{{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{22,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{26,
+1,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0},
+{1,
+0,
+UnknownToken,
+0}}};
+static RunHint const response_run_hints_[44] = {
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{1, 1, 0, {8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+{0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}};
+
+static uint8_t const response_in_space_state_ = 3;
+
+#define RESPONSE_TABLE_LAYOUT 3 // transposed
+
+static size_t response_tok_direct_(Tokenizer* const ctx, uint8_t* const state, char const* const buffer, size_t const n) {
+    size_t i = 0;
+    char   c;
+    (void)ctx;
+    switch (*state) {
+    case 0:
+        goto s0;
+    case 1:
+        goto s1;
+    case 2:
+        goto s2;
+    case 3:
+        goto s3;
+    case 4:
+        goto s4;
+    case 5:
+        goto s5;
+    case 6:
+        goto s6;
+    case 7:
+        goto s7;
+    case 8:
+        goto s8;
+    case 9:
+        goto s9;
+    case 10:
+        goto s10;
+    case 11:
+        goto s11;
+    case 12:
+        goto s12;
+    case 13:
+        goto s13;
+    case 14:
+        goto s14;
+    case 15:
+        goto s15;
+    case 16:
+        goto s16;
+    case 17:
+        goto s17;
+    case 18:
+        goto s18;
+    case 19:
+        goto s19;
+    case 20:
+        goto s20;
+    case 21:
+        goto s21;
+    case 22:
+        goto s22;
+    case 23:
+        goto s23;
+    case 24:
+        goto s24;
+    case 25:
+        goto s25;
+    case 26:
+        goto s26;
+    case 27:
+        goto s27;
+    case 28:
+        goto s28;
+    case 29:
+        goto s29;
+    case 30:
+        goto s30;
+    case 31:
+        goto s31;
+    case 32:
+        goto s32;
+    case 33:
+        goto s33;
+    case 34:
+        goto s34;
+    case 35:
+        goto s35;
+    case 36:
+        goto s36;
+    case 37:
+        goto s37;
+    case 38:
+        goto s38;
+    case 39:
+        goto s39;
+    case 40:
+        goto s40;
+    case 41:
+        goto s41;
+    case 42:
+        goto s42;
+    case 43:
+        goto s43;
+    default:
+        goto s1;
+    }
+s0:
+    if (i == n) {
+        *state = 0;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 4:
+        goto s3;
+    case 5:
+        DIRECT_RESET();
+        DIRECT_DIGIT(c);
+        goto s4;
+    case 8:
+        goto s13;
+    case 9:
+        goto s18;
+    case 10:
+        goto s34;
+    case 11:
+        goto s6;
+    case 15:
+        goto s32;
+    default:
+        goto s1;
+    }
+s1:
+    *state = 1;
+    return i;
+s2:
+    *state = 2;
+    return i;
+s3:
+    if (i == n) {
+        *state = 3;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 1:
+        goto s2;
+    case 3:
+        goto s41;
+    case 4:
+        goto s3;
+    case 5:
+        DIRECT_RESET();
+        DIRECT_DIGIT(c);
+        goto s4;
+    case 8:
+        goto s13;
+    case 9:
+        goto s18;
+    case 10:
+        goto s34;
+    case 11:
+        goto s6;
+    case 15:
+        goto s32;
+    default:
+        goto s1;
+    }
+s4:
+    i += DIRECT_RUN(4);
+    if (i == n) {
+        *state = 4;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 1:
+        DIRECT_TOKEN(SizeToken);
+        goto s2;
+    case 3:
+        DIRECT_TOKEN(SizeToken);
+        goto s41;
+    case 4:
+        DIRECT_TOKEN(SizeToken);
+        goto s3;
+    case 5:
+        DIRECT_DIGIT(c);
+        goto s4;
+    default:
+        goto s1;
+    }
+s5:
+    if (i == n) {
+        *state = 5;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    default:
+        goto s1;
+    }
+s6:
+    if (i == n) {
+        *state = 6;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 14:
+        goto s7;
+    default:
+        goto s1;
+    }
+s7:
+    if (i == n) {
+        *state = 7;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 19:
+        goto s8;
+    default:
+        goto s1;
+    }
+s8:
+    if (i == n) {
+        *state = 8;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 6:
+        goto s9;
+    default:
+        goto s1;
+    }
+s9:
+    if (i == n) {
+        *state = 9;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 13:
+        goto s10;
+    default:
+        goto s1;
+    }
+s10:
+    if (i == n) {
+        *state = 10;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 11:
+        goto s11;
+    default:
+        goto s1;
+    }
+s11:
+    if (i == n) {
+        *state = 11;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 7:
+        goto s12;
+    default:
+        goto s1;
+    }
+s12:
+    if (i == n) {
+        *state = 12;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 1:
+        DIRECT_TOKEN(InvalidToken);
+        goto s2;
+    case 3:
+        DIRECT_TOKEN(InvalidToken);
+        goto s41;
+    case 4:
+        DIRECT_TOKEN(InvalidToken);
+        goto s3;
+    default:
+        goto s1;
+    }
+s13:
+    if (i == n) {
+        *state = 13;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 16:
+        goto s14;
+    default:
+        goto s1;
+    }
+s14:
+    if (i == n) {
+        *state = 14;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 16:
+        goto s15;
+    default:
+        goto s1;
+    }
+s15:
+    if (i == n) {
+        *state = 15;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 15:
+        goto s16;
+    default:
+        goto s1;
+    }
+s16:
+    if (i == n) {
+        *state = 16;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 16:
+        goto s17;
+    default:
+        goto s1;
+    }
+s17:
+    if (i == n) {
+        *state = 17;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 1:
+        DIRECT_TOKEN(ErrorToken);
+        goto s2;
+    case 3:
+        DIRECT_TOKEN(ErrorToken);
+        goto s41;
+    case 4:
+        DIRECT_TOKEN(ErrorToken);
+        goto s3;
+    default:
+        goto s1;
+    }
+s18:
+    if (i == n) {
+        *state = 18;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 11:
+        goto s19;
+    default:
+        goto s1;
+    }
+s19:
+    if (i == n) {
+        *state = 19;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 13:
+        goto s20;
+    default:
+        goto s1;
+    }
+s20:
+    if (i == n) {
+        *state = 20;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 8:
+        goto s21;
+    default:
+        goto s1;
+    }
+s21:
+    if (i == n) {
+        *state = 21;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 20:
+        goto s22;
+    default:
+        goto s1;
+    }
+s22:
+    if (i == n) {
+        *state = 22;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 14:
+        goto s23;
+    default:
+        goto s1;
+    }
+s23:
+    if (i == n) {
+        *state = 23;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 15:
+        goto s24;
+    default:
+        goto s1;
+    }
+s24:
+    if (i == n) {
+        *state = 24;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 17:
+        goto s25;
+    default:
+        goto s1;
+    }
+s25:
+    if (i == n) {
+        *state = 25;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 20:
+        goto s26;
+    default:
+        goto s1;
+    }
+s26:
+    if (i == n) {
+        *state = 26;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 9:
+        goto s27;
+    default:
+        goto s1;
+    }
+s27:
+    if (i == n) {
+        *state = 27;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 15:
+        goto s28;
+    default:
+        goto s1;
+    }
+s28:
+    if (i == n) {
+        *state = 28;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 18:
+        goto s29;
+    default:
+        goto s1;
+    }
+s29:
+    if (i == n) {
+        *state = 29;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 14:
+        goto s30;
+    default:
+        goto s1;
+    }
+s30:
+    if (i == n) {
+        *state = 30;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 7:
+        goto s31;
+    default:
+        goto s1;
+    }
+s31:
+    if (i == n) {
+        *state = 31;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 1:
+        DIRECT_TOKEN(FileNotFoundToken);
+        goto s2;
+    case 3:
+        DIRECT_TOKEN(FileNotFoundToken);
+        goto s41;
+    case 4:
+        DIRECT_TOKEN(FileNotFoundToken);
+        goto s3;
+    default:
+        goto s1;
+    }
+s32:
+    if (i == n) {
+        *state = 32;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 12:
+        goto s33;
+    default:
+        goto s1;
+    }
+s33:
+    if (i == n) {
+        *state = 33;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 1:
+        DIRECT_TOKEN(OkToken);
+        goto s2;
+    case 3:
+        DIRECT_TOKEN(OkToken);
+        goto s41;
+    case 4:
+        DIRECT_TOKEN(OkToken);
+        goto s3;
+    default:
+        goto s1;
+    }
+s34:
+    if (i == n) {
+        *state = 34;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 8:
+        goto s35;
+    default:
+        goto s1;
+    }
+s35:
+    if (i == n) {
+        *state = 35;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 17:
+        goto s36;
+    default:
+        goto s1;
+    }
+s36:
+    if (i == n) {
+        *state = 36;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 9:
+        goto s37;
+    default:
+        goto s1;
+    }
+s37:
+    if (i == n) {
+        *state = 37;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 11:
+        goto s38;
+    default:
+        goto s1;
+    }
+s38:
+    if (i == n) {
+        *state = 38;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 13:
+        goto s39;
+    default:
+        goto s1;
+    }
+s39:
+    if (i == n) {
+        *state = 39;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 8:
+        goto s40;
+    default:
+        goto s1;
+    }
+s40:
+    if (i == n) {
+        *state = 40;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 1:
+        DIRECT_TOKEN(GetfileToken);
+        goto s2;
+    case 3:
+        DIRECT_TOKEN(GetfileToken);
+        goto s41;
+    case 4:
+        DIRECT_TOKEN(GetfileToken);
+        goto s3;
+    default:
+        goto s1;
+    }
+s41:
+    if (i == n) {
+        *state = 41;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 2:
+        goto s42;
+    default:
+        goto s1;
+    }
+s42:
+    if (i == n) {
+        *state = 42;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 3:
+        goto s43;
+    default:
+        goto s1;
+    }
+s43:
+    if (i == n) {
+        *state = 43;
+        return i;
+    }
+    c = buffer[i++];
+    switch (c >= 0 && c < 128 ? response_character_class_[(size_t)c] : 0) {
+    case 2:
+        goto s2;
+    default:
+        goto s1;
+    }
+}
@@ -1,5 +1,5 @@
 
-#include "../gfclient.h"
+#include "../gfclient-student.h"
 
 #include <memory>
 
@@ -59,4 +59,5 @@ GFC_WRAPPER(perform);
 GFC_WRAPPER(get_status);
 GFC_WRAPPER(get_bytesreceived);
 GFC_WRAPPER(get_filelen);
+GFC_WRAPPER(set_protocol);
 } // namespace gf::test
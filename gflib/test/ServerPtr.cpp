@@ -4,7 +4,9 @@
 #include "../gfserver-student.h"
 
 #include <assert.h>
+#include <algorithm>
 #include <limits>
+#include <stdexcept>
 #include <type_traits>
 
 namespace gf::test {
@@ -17,4 +19,49 @@ void DestroyServer::operator()(gfserver_t* gfc) const {
 ServerPtr create_server() {
     return ServerPtr{gfserver_create()};
 }
+
+namespace {
+using Data = std::unordered_map<std::string, Bytes>;
+
+// handler that serves files out of a Data
+gfh_error_t serve_data(gfcontext_t** ctx, char const* path, void* data_) {
+    auto const& data = *static_cast<Data const*>(data_);
+    auto const  iter = data.find(path);
+    if (iter == data.end()) {
+        gfs_sendheader(ctx, GF_FILE_NOT_FOUND, 0);
+        return 0;
+    }
+    auto const& bytes = iter->second;
+    gfs_sendheader(ctx, GF_OK, bytes.size());
+    for (size_t sent = 0; sent < bytes.size();) {
+        size_t const n = std::min(bytes.size() - sent, size_t{64 * 1024});
+        gfs_send(ctx, bytes.data() + sent, n);
+        sent += n;
+    }
+    return 0;
+}
+} // namespace
+
+ServerRunner::ServerRunner(ServerPtr server, Data data)
+    : stop_{std::make_unique<std::atomic<bool>>(false)} {
+    auto sharedData = std::make_shared<Data>(std::move(data));
+    gfs::set_handler(server, serve_data);
+    gfs::set_handlerarg(server, sharedData.get());
+    gfs::set_continue_fcn(
+        server,
+        [](void* stop) { return !*static_cast<std::atomic<bool>*>(stop); },
+        stop_.get());
+    if (gfs::listen(server) != 0) {
+        throw std::runtime_error("failed to listen");
+    }
+    future_ = std::async(std::launch::async,
+                         [server = std::move(server), sharedData]() mutable {
+                             gfs::serve(server);
+                         });
+}
+
+ServerRunner::~ServerRunner() {
+    *stop_ = true;
+    future_.wait();
+}
 } // namespace gf::test
@@ -55,14 +55,18 @@ GfsFunctionWrapper(Return (*)(gfserver_t**, Arguments...))
     -> GfsFunctionWrapper<Return, Arguments...>;
 
 // now, this creates an inline variable that is FunctionStem and points an
-// instance of GfsFunctionWrapper.  so something like set_port(ServerPtr,
-// port) looks like a function call and it's just calling gfc_set_port under the
-// hood.
+// instance of GfsFunctionWrapper.  so something like
+// gfs::set_port(ServerPtr, port) looks like a function call and it's just
+// calling gfserver_set_port under the hood.
+//
+// these live in their own namespace: inline variables are merged by name at
+// link time so they mustn't collide with the GFC_WRAPPERs in RequestPtr.hpp.
 #define GFS_WRAPPER(FunctionStem)                         \
     inline auto const FunctionStem = GfsFunctionWrapper { \
         gfserver_##FunctionStem                           \
     }
 
+namespace gfs {
 GFS_WRAPPER(set_port);
 GFS_WRAPPER(port);
 GFS_WRAPPER(set_handler);
@@ -71,6 +75,11 @@ GFS_WRAPPER(set_maxpending);
 GFS_WRAPPER(listen);
 GFS_WRAPPER(set_continue_fcn);
 GFS_WRAPPER(serve);
+GFS_WRAPPER(set_backend);
+GFS_WRAPPER(backend);
+GFS_WRAPPER(set_zerocopy_threshold);
+GFS_WRAPPER(set_send_release_fcn);
+} // namespace gfs
 
 /*!
  Constructing a ServerRunner starts a server running on an seperate thread.
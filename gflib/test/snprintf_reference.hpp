@@ -0,0 +1,63 @@
+#ifndef gf_test_snprintf_reference_hpp
+#define gf_test_snprintf_reference_hpp
+#include "../gf-student.h"
+
+#include <cstdio>
+
+namespace gf::test {
+// snprintf_tokens the way it was before write_tokens, one snprintf per token
+// and one for the terminator.  what the serializers have to match.
+inline int snprintf_tokens_reference(char* const        buffer,
+                                     size_t const       bufferSize,
+                                     Token const* const tokens,
+                                     size_t const       numTokens) {
+    auto const rem = [bufferSize](size_t const written) {
+        return written > bufferSize ? 0 : bufferSize - written;
+    };
+    size_t      out    = 0;
+    char const* prefix = "";
+    for (size_t i = 0; i < numTokens; ++i) {
+        Token const& token = tokens[i];
+        switch (token.id) {
+        case SizeToken:
+            out += std::snprintf(
+                buffer + out, rem(out), "%s%zu", prefix, token.data.size);
+            break;
+        case PathToken:
+            out += std::snprintf(buffer + out,
+                                 rem(out),
+                                 "%s%.*s",
+                                 prefix,
+                                 (int)token.data.path.length,
+                                 token.data.path.text);
+            break;
+        case GetfileToken:
+            out += std::snprintf(buffer + out, rem(out), "%sGETFILE", prefix);
+            break;
+        case GetToken:
+            out += std::snprintf(buffer + out, rem(out), "%sGET", prefix);
+            break;
+        case OkToken:
+            out += std::snprintf(buffer + out, rem(out), "%sOK", prefix);
+            break;
+        case FileNotFoundToken:
+            out += std::snprintf(
+                buffer + out, rem(out), "%sFILE_NOT_FOUND", prefix);
+            break;
+        case ErrorToken:
+            out += std::snprintf(buffer + out, rem(out), "%sERROR", prefix);
+            break;
+        case InvalidToken:
+            out += std::snprintf(buffer + out, rem(out), "%sINVALID", prefix);
+            break;
+        default:
+            break;
+        }
+        prefix = " ";
+    }
+    out += std::snprintf(buffer + out, rem(out), "%s", tok_terminator());
+    return static_cast<int>(out);
+}
+} // namespace gf::test
+
+#endif // include guard
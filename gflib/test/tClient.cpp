@@ -305,3 +305,98 @@ TEST(Client, EarlyShutdown) {
         }
     }
 }
+
+namespace {
+// like launch_mock_server but speaking the binary protocol.  sends response's
+// header and then toSend.
+std::thread launch_mock_binary_server(boost::asio::io_context& ioContext,
+                                      unsigned short const     port,
+                                      Response const           response,
+                                      Bytes                    toSend,
+                                      size_t const             chunkSize,
+                                      std::string&             pathRequested) {
+    std::thread t{[&ioContext,
+                   acceptor = setup_acceptor(ioContext, port),
+                   response,
+                   toSend = std::move(toSend),
+                   chunkSize,
+                   &pathRequested] {
+        tcp::socket socket{ioContext};
+        acceptor->accept(socket);
+        uint8_t    buffer[1024];
+        size_t     received = 0;
+        RequestGet request;
+        while (unpack_binary_request_get(buffer, received, &request) == 0) {
+            received += socket.read_some(boost::asio::buffer(
+                buffer + received, std::size(buffer) - received));
+        }
+        pathRequested.assign(request.path, request.pathLength);
+
+        Bytes bytes(BINARY_HEADER_SIZE);
+        write_binary_response(reinterpret_cast<uint8_t*>(bytes.data()),
+                              &response);
+        bytes.insert(bytes.end(), toSend.begin(), toSend.end());
+        for (size_t sent = 0; sent < bytes.size(); sent += chunkSize) {
+            using namespace std::chrono_literals;
+            boost::system::error_code error;
+            Bytes                     localBytes(
+                bytes.begin() + sent,
+                bytes.begin() + std::min(sent + chunkSize, bytes.size()));
+            boost::asio::write(socket, boost::asio::buffer(localBytes), error);
+            std::this_thread::sleep_for(5ms);
+        }
+        shutdown(socket);
+    }};
+    return t;
+}
+} // namespace
+
+TEST(Client, PerformBinary) {
+    boost::asio::io_context ioContext{1};
+
+    std::mt19937             gen{random_seed()};
+    std::vector<Bytes> const bytess{
+        Bytes{},
+        random_bytes(gen, 1025),
+    };
+
+    for (size_t const chunkSize : {1024, 5, 1}) {
+        for (auto const& bytes : bytess) {
+            std::string       pathRequested;
+            std::string const pathSent{"/a/b/c/d/d"};
+            auto              t = launch_mock_binary_server(ioContext,
+                                               default_port,
+                                               {OkResponse, bytes.size()},
+                                               bytes,
+                                               chunkSize,
+                                               pathRequested);
+
+            auto req = setup_request(pathSent);
+            set_protocol(req, GfBinaryProtocol);
+            Bytes bytesReceived;
+            setup_write_fcn(req, bytesReceived);
+            EXPECT_EQ(perform(req), 0);
+            EXPECT_EQ(bytesReceived, bytes);
+            EXPECT_EQ(get_filelen(req), bytes.size());
+            EXPECT_EQ(get_status(req), GF_OK);
+            t.join();
+            EXPECT_EQ(pathRequested, pathSent);
+        }
+    }
+
+    std::pair<ResponseStatus, gfstatus_t> const statuses[] = {
+        {FileNotFoundResponse, GF_FILE_NOT_FOUND},
+        {ErrorResponse, GF_ERROR},
+        {InvalidResponse, GF_INVALID}};
+    for (auto const& [status, expected] : statuses) {
+        std::string pathRequested;
+        auto        t = launch_mock_binary_server(
+            ioContext, default_port, {status, 0}, {}, 3, pathRequested);
+
+        auto req = setup_request("/a");
+        set_protocol(req, GfBinaryProtocol);
+        EXPECT_EQ(perform(req), 0);
+        EXPECT_EQ(get_status(req), expected);
+        t.join();
+    }
+}
@@ -1,16 +1,24 @@
 #include "../gf-student.h"
 #include "TokenizerPtr.hpp"
+#include "random_seed.hpp"
+#include "snprintf_reference.hpp"
 #include "terminator.hpp"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <list>
+#include <random>
+#include <string_view>
+#include <vector>
+
 using namespace gf::test;
 
 TEST(RequestGet, RoundTrip) {
     RequestGet const requests[] = {
-        {"/a/b/c/d"},
-        {"/d/e/f/g"},
+        {"/a/b/c/d", 8},
+        {"/d/e/f/g", 8},
     };
     auto tok = create_tokenizer();
     for (auto const& request : requests) {
@@ -26,6 +34,7 @@ TEST(RequestGet, RoundTrip) {
         RequestGet out;
         EXPECT_EQ(unpack_request_get(tok.get(), &out), 0);
         EXPECT_STREQ(out.path, request.path);
+        EXPECT_EQ(out.pathLength, request.pathLength);
     }
 }
 
@@ -99,3 +108,183 @@ TEST(Response, InvalidUnpack) {
         EXPECT_LT(unpack_response(tok.get(), &out), 0);
     }
 }
+
+TEST(Binary, RoundTrip) {
+    std::string const paths[] = {"/a", "/d/e/f/g", std::string(800, '/')};
+    for (auto const& path : paths) {
+        RequestGet const request{path.data(), path.size()};
+        uint8_t          buffer[1024];
+        size_t const     n = write_binary_request_get(buffer, &request);
+        ASSERT_EQ(n, BINARY_HEADER_SIZE + path.size());
+        EXPECT_TRUE(is_binary_header(buffer, 1));
+        // every prefix is just short
+        for (size_t i = 0; i < n; ++i) {
+            RequestGet out;
+            EXPECT_EQ(unpack_binary_request_get(buffer, i, &out), 0) << i;
+        }
+        RequestGet out;
+        EXPECT_EQ(unpack_binary_request_get(buffer, n, &out), (ssize_t)n);
+        EXPECT_EQ(std::string(out.path, out.pathLength), path);
+    }
+
+    Response const responses[] = {
+        {OkResponse, 0},
+        {OkResponse, 0x0102030405060708},
+        {ErrorResponse, 0},
+        {FileNotFoundResponse, 0},
+        {InvalidResponse, 0},
+    };
+    for (auto const& response : responses) {
+        uint8_t buffer[BINARY_HEADER_SIZE];
+        write_binary_response(buffer, &response);
+        Response out;
+        EXPECT_EQ(unpack_binary_response(buffer, sizeof(buffer) - 1, &out), 0);
+        EXPECT_EQ(unpack_binary_response(buffer, sizeof(buffer), &out),
+                  BINARY_HEADER_SIZE);
+        EXPECT_EQ(out.status, response.status);
+        EXPECT_EQ(out.size, response.size);
+    }
+    // little endian on the wire, whatever the host
+    uint8_t buffer[BINARY_HEADER_SIZE];
+    write_binary_response(buffer, &responses[1]);
+    EXPECT_THAT(buffer,
+                testing::ElementsAre(
+                    0, 'G', 'F', 2, 2, 0, 0, 0, 8, 7, 6, 5, 4, 3, 2, 1));
+}
+
+TEST(Binary, InvalidUnpack) {
+    RequestGet const request{"/a", 2};
+    uint8_t          valid[BINARY_HEADER_SIZE + 2];
+    write_binary_request_get(valid, &request);
+
+    // change one byte of valid
+    auto const changed = [&valid](size_t const at, uint8_t const value) {
+        std::vector<uint8_t> out(std::begin(valid), std::end(valid));
+        out[at] = value;
+        return out;
+    };
+    std::vector<uint8_t> const invalidRequests[] = {
+        changed(0, 'G'),            // magic, text
+        changed(3, 1),              // version
+        changed(4, BinaryOkOpcode), // a response
+        changed(4, 0),              // no such opcode
+        changed(6, 0),              // no path
+        changed(7, 4),              // path too long
+    };
+    for (auto const& bytes : invalidRequests) {
+        RequestGet out;
+        EXPECT_EQ(unpack_binary_request_get(bytes.data(), bytes.size(), &out),
+                  -1);
+    }
+    // and a request isn't a response
+    Response response;
+    EXPECT_EQ(unpack_binary_response(valid, sizeof(valid), &response), -1);
+    // wrong from the first byte, no need to wait for more
+    RequestGet out;
+    EXPECT_EQ(unpack_binary_request_get(invalidRequests[0].data(), 1, &out),
+              -1);
+    EXPECT_FALSE(is_binary_header(invalidRequests[0].data(), 1));
+}
+
+TEST(ResponseHeader, MatchesSnprintf) {
+    std::vector<Response> responses = {
+        {OkResponse, 0},
+        {OkResponse, 123456},
+        {OkResponse, std::numeric_limits<size_t>::max()},
+        {ErrorResponse, 0},
+        {FileNotFoundResponse, 0},
+        {InvalidResponse, 0},
+    };
+    for (size_t size = 1; size < SIZE_MAX / 10; size *= 10) {
+        responses.push_back({OkResponse, size - 1});
+        responses.push_back({OkResponse, size});
+    }
+    for (auto const& response : responses) {
+        char       buffer[1024];
+        auto const n = snprintf_response(buffer, sizeof(buffer), &response);
+        std::string const expected(buffer, static_cast<size_t>(n));
+
+        ResponseHeader header;
+        response_header_init(&header, &response);
+        EXPECT_EQ(std::string(header.text, header.size), expected);
+        EXPECT_EQ(header.response.status, response.status);
+        EXPECT_EQ(header.response.size, response.size);
+
+        auto const* const staticHeader =
+            response_header_static(response.status);
+        if (response.status == OkResponse) {
+            EXPECT_EQ(staticHeader, nullptr);
+        } else {
+            ASSERT_NE(staticHeader, nullptr);
+            EXPECT_EQ(std::string(staticHeader->text, staticHeader->size),
+                      expected);
+            EXPECT_EQ(staticHeader->response.status, response.status);
+        }
+    }
+    EXPECT_EQ(response_header_static(UnknownResponse), nullptr);
+}
+
+// write_tokens and snprintf_tokens against snprintf, every number of digits
+// and random paths, with buffers big enough and not.
+TEST(Serialize, MatchesSnprintf) {
+    std::mt19937                          gen{random_seed()};
+    std::uniform_int_distribution<size_t> sizeDist;
+    std::uniform_int_distribution<size_t> pathDist{0, 200};
+    std::uniform_int_distribution<int>    charDist{0x21, 0x7e};
+
+    std::vector<std::vector<Token>> headers;
+    auto const addSize = [&headers](size_t const size) {
+        headers.push_back({{.id = GetfileToken},
+                           {.id = OkToken},
+                           {.id = SizeToken, .data = {.size = size}}});
+    };
+    for (size_t size = 1; size < SIZE_MAX / 10; size *= 10) {
+        addSize(size - 1);
+        addSize(size);
+        addSize(size + 1);
+    }
+    addSize(std::numeric_limits<size_t>::max());
+    for (auto const id :
+         {FileNotFoundToken, ErrorToken, InvalidToken, GetfileToken}) {
+        headers.push_back({{.id = GetfileToken}, {.id = id}});
+    }
+    headers.push_back({});
+    std::list<std::string> paths;
+    for (size_t i = 0; i < 100; ++i) {
+        addSize(sizeDist(gen) >> (i % 64));
+        auto& path = paths.emplace_back(pathDist(gen) + 1, '/');
+        std::generate(path.begin() + 1, path.end(), [&] {
+            return static_cast<char>(charDist(gen));
+        });
+        headers.push_back(
+            {{.id = GetfileToken},
+             {.id = GetToken},
+             {.id = PathToken, .data = {.path = {path.data(), path.size()}}}});
+    }
+
+    for (auto const& tokens : headers) {
+        char       expected[512];
+        auto const n = snprintf_tokens_reference(
+            expected, sizeof(expected), tokens.data(), tokens.size());
+        ASSERT_LT(static_cast<size_t>(n), sizeof(expected));
+        EXPECT_EQ(tokens_length(tokens.data(), tokens.size()),
+                  static_cast<size_t>(n));
+
+        char written[512];
+        EXPECT_EQ(write_tokens(written, tokens.data(), tokens.size()),
+                  static_cast<size_t>(n));
+        EXPECT_EQ(std::string_view(written, n), std::string_view(expected, n));
+
+        // every buffer size from nothing to room to spare
+        for (size_t size = 0; size < static_cast<size_t>(n) + 3; ++size) {
+            std::string actual(size + 1, '#');
+            std::string reference(size + 1, '#');
+            EXPECT_EQ(snprintf_tokens(
+                          actual.data(), size, tokens.data(), tokens.size()),
+                      n);
+            snprintf_tokens_reference(
+                reference.data(), size, tokens.data(), tokens.size());
+            EXPECT_EQ(actual, reference) << size;
+        }
+    }
+}
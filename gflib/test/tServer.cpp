@@ -0,0 +1,310 @@
+#include "Bytes.hpp"
+#include "ServerPtr.hpp"
+#include "random_bytes.hpp"
+#include "random_seed.hpp"
+#include "terminator.hpp"
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/ts/buffer.hpp>
+#include <boost/asio/ts/internet.hpp>
+#include <boost/asio/write.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <poll.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+using boost::asio::ip::tcp;
+using namespace gf::test;
+
+namespace {
+unsigned short const default_port = 14758;
+
+ServerBackend const backends[] = {SelectServerBackend, IoUringServerBackend};
+
+// send request to the server in pieces of at most pieceSize, pausing between
+// them, and return everything the server sends back.
+std::string fetch(std::string const& request,
+                  size_t const       pieceSize = std::string::npos) {
+    boost::asio::io_context ioContext{1};
+    tcp::resolver           resolver{ioContext};
+    tcp::socket             socket{ioContext};
+    boost::asio::connect(
+        socket, resolver.resolve("localhost", std::to_string(default_port)));
+    for (size_t sent = 0; sent < request.size();) {
+        if (sent > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        std::string const piece = request.substr(sent, pieceSize);
+        boost::asio::write(socket, boost::asio::buffer(piece));
+        sent += piece.size();
+    }
+    // so a cut short header doesn't leave the server waiting on us
+    socket.shutdown(tcp::socket::shutdown_send);
+    boost::system::error_code error;
+    std::string               out;
+    boost::asio::read(socket, boost::asio::dynamic_buffer(out), error);
+    return out;
+}
+
+// send request and return everything the server sends back before it closes
+// the connection.  nullopt if it's still open after timeout.
+std::optional<std::string> fetch_within(
+    std::string const&              request,
+    std::chrono::milliseconds const timeout) {
+    boost::asio::io_context ioContext{1};
+    tcp::resolver           resolver{ioContext};
+    tcp::socket             socket{ioContext};
+    boost::asio::connect(
+        socket, resolver.resolve("localhost", std::to_string(default_port)));
+    boost::asio::write(socket, boost::asio::buffer(request));
+    std::string out;
+    pollfd      fd{socket.native_handle(), POLLIN, 0};
+    char        buffer[1024];
+    while (poll(&fd, 1, static_cast<int>(timeout.count())) == 1) {
+        ssize_t const numRead = recv(fd.fd, buffer, sizeof(buffer), 0);
+        if (numRead <= 0) {
+            return out;
+        }
+        out.append(buffer, static_cast<size_t>(numRead));
+    }
+    return std::nullopt;
+}
+
+std::string to_string(Bytes const& bytes) {
+    return std::string(reinterpret_cast<char const*>(bytes.data()),
+                       bytes.size());
+}
+
+std::string expected_response(Bytes const& bytes) {
+    return "GETFILE OK " + std::to_string(bytes.size()) + terminator +
+           to_string(bytes);
+}
+
+std::string binary_request(std::string const& path) {
+    std::string      out(BINARY_HEADER_SIZE + path.size(), '\0');
+    RequestGet const request{path.data(), path.size()};
+    write_binary_request_get(reinterpret_cast<uint8_t*>(out.data()), &request);
+    return out;
+}
+
+std::string binary_response(ResponseStatus const status,
+                            Bytes const&         bytes = {}) {
+    std::string    out(BINARY_HEADER_SIZE, '\0');
+    Response const response{status, bytes.size()};
+    write_binary_response(reinterpret_cast<uint8_t*>(out.data()), &response);
+    return out + to_string(bytes);
+}
+
+std::unordered_map<std::string, Bytes> make_data(std::mt19937& gen) {
+    std::unordered_map<std::string, Bytes> out;
+    for (size_t const size : {0, 1, 1025, 1024 * 1024}) {
+        out.emplace("/file" + std::to_string(size), random_bytes(gen, size));
+    }
+    return out;
+}
+} // namespace
+
+TEST(Server, Serves) {
+    std::mt19937 gen{random_seed()};
+    auto const   data = make_data(gen);
+    for (auto const backend : backends) {
+        auto server = create_server();
+        gfs::set_port(server, default_port);
+        gfs::set_backend(server, backend);
+        ServerRunner const runner{std::move(server), data};
+
+        for (auto const& [path, bytes] : data) {
+            EXPECT_EQ(fetch("GETFILE GET " + path + terminator),
+                      expected_response(bytes))
+                << path << ":" << backend;
+        }
+        EXPECT_EQ(fetch("GETFILE GET /notthere" + terminator),
+                  "GETFILE FILE_NOT_FOUND" + terminator)
+            << backend;
+        EXPECT_EQ(fetch("GETFILE GOT /file1" + terminator),
+                  "GETFILE INVALID" + terminator)
+            << backend;
+        // header cut short
+        EXPECT_EQ(fetch("GETFILE GET /file1"), "GETFILE INVALID" + terminator)
+            << backend;
+    }
+}
+
+TEST(Server, Concurrent) {
+    std::mt19937 gen{random_seed()};
+    auto const   data = make_data(gen);
+    std::vector<std::string> paths;
+    for (auto const& [path, _] : data) {
+        paths.push_back(path);
+    }
+    for (auto const backend : backends) {
+        auto server = create_server();
+        gfs::set_port(server, default_port);
+        gfs::set_backend(server, backend);
+        ServerRunner const runner{std::move(server), data};
+
+        size_t const             numClients = 32;
+        std::vector<std::thread> clients;
+        std::vector<size_t>      numBad(numClients, 0);
+        for (size_t i = 0; i < numClients; ++i) {
+            clients.emplace_back([&, i] {
+                for (size_t j = 0; j < 8; ++j) {
+                    auto const& path = paths[(i + j) % paths.size()];
+                    // trickle the header in so that many are in flight at once
+                    if (fetch("GETFILE GET " + path + terminator, 7) !=
+                        expected_response(data.at(path))) {
+                        ++numBad[i];
+                    }
+                }
+            });
+        }
+        for (auto& client : clients) {
+            client.join();
+        }
+        EXPECT_THAT(numBad, testing::Each(0u)) << backend;
+    }
+}
+
+TEST(Server, ServesBinary) {
+    std::mt19937 gen{random_seed()};
+    auto const   data = make_data(gen);
+    for (auto const backend : backends) {
+        auto server = create_server();
+        gfs::set_port(server, default_port);
+        gfs::set_backend(server, backend);
+        ServerRunner const runner{std::move(server), data};
+
+        for (auto const& [path, bytes] : data) {
+            EXPECT_EQ(fetch(binary_request(path)),
+                      binary_response(OkResponse, bytes))
+                << path << ":" << backend;
+            // a piece at a time
+            EXPECT_EQ(fetch(binary_request(path), 3),
+                      binary_response(OkResponse, bytes))
+                << path << ":" << backend;
+        }
+        EXPECT_EQ(fetch(binary_request("/notthere")),
+                  binary_response(FileNotFoundResponse))
+            << backend;
+        std::string wrongOpcode = binary_request("/file1");
+        wrongOpcode[4]          = BinaryOkOpcode;
+        EXPECT_EQ(fetch(wrongOpcode), binary_response(InvalidResponse))
+            << backend;
+        // cut short and too long
+        std::string const request = binary_request("/file1");
+        EXPECT_EQ(fetch(request.substr(0, request.size() - 1)),
+                  binary_response(InvalidResponse))
+            << backend;
+        EXPECT_EQ(fetch(request + "x"), binary_response(InvalidResponse))
+            << backend;
+        // and text still works
+        EXPECT_EQ(fetch("GETFILE GET /file1" + terminator),
+                  expected_response(data.at("/file1")))
+            << backend;
+    }
+}
+
+TEST(Server, ClosesAfterEmptyContent) {
+    // no gfs_send follows the header, so sending it has to close up
+    std::unordered_map<std::string, Bytes> const data{{"/empty", Bytes{}}};
+    for (auto const backend : backends) {
+        auto server = create_server();
+        gfs::set_port(server, default_port);
+        gfs::set_backend(server, backend);
+        ServerRunner const runner{std::move(server), data};
+
+        EXPECT_EQ(fetch_within("GETFILE GET /empty" + terminator,
+                               std::chrono::seconds{5}),
+                  "GETFILE OK 0" + terminator)
+            << backend;
+    }
+}
+
+TEST(Server, ReleasesEverySentBuffer) {
+    std::mt19937 gen{random_seed()};
+    auto const   data = make_data(gen);
+    struct Released {
+        std::mutex                mutex;
+        std::vector<char const*> buffers;
+    };
+    for (auto const backend : backends) {
+        Released released;
+        auto     server = create_server();
+        gfs::set_port(server, default_port);
+        gfs::set_backend(server, backend);
+        // every send tries zero copy, until loopback copies it
+        gfs::set_zerocopy_threshold(server, 1);
+        gfs::set_send_release_fcn(
+            server,
+            [](void const* buffer, void* released_) {
+                auto&                  r = *static_cast<Released*>(released_);
+                std::lock_guard const lock{r.mutex};
+                r.buffers.push_back(static_cast<char const*>(buffer));
+            },
+            &released);
+        ServerRunner const runner{std::move(server), data};
+
+        std::string const path = "/file1048576";
+        EXPECT_EQ(fetch("GETFILE GET " + path + terminator),
+                  expected_response(data.at(path)))
+            << backend;
+        // the handler sends it in 64 KiB pieces, each released once before
+        // the connection closes
+        std::lock_guard const lock{released.mutex};
+        std::ranges::sort(released.buffers);
+        ASSERT_EQ(released.buffers.size(), 16u) << backend;
+        for (size_t i = 1; i < released.buffers.size(); ++i) {
+            EXPECT_EQ(released.buffers[i] - released.buffers[i - 1], 64 * 1024)
+                << backend;
+        }
+    }
+}
+
+TEST(Server, KeepsAcceptingWithEverySlotBusy) {
+    // more idle clients than the io_uring backend has slots (64).  select
+    // reads each header to the end before the next, so only io_uring.
+    std::unordered_map<std::string, Bytes> const data{
+        {"/file", Bytes{std::byte{1}}}};
+    auto server = create_server();
+    gfs::set_port(server, default_port);
+    gfs::set_backend(server, IoUringServerBackend);
+    gfs::set_maxpending(server, 128);
+    gfserver_t*        raw = server.get();
+    ServerRunner const runner{std::move(server), data};
+    ASSERT_EQ(fetch("GETFILE GET /file" + terminator),
+              expected_response(data.at("/file")));
+    if (gfserver_backend(&raw) != IoUringServerBackend) {
+        GTEST_SKIP() << "no io_uring";
+    }
+
+    boost::asio::io_context ioContext{1};
+    tcp::resolver           resolver{ioContext};
+    auto const              endpoints =
+        resolver.resolve("localhost", std::to_string(default_port));
+
+    std::vector<tcp::socket> idle;
+    for (size_t i = 0; i < 66; ++i) {
+        boost::asio::connect(idle.emplace_back(ioContext), endpoints);
+        // keep them in the order they connected
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    // the ones that got slots give up, the waiting ones get them, and then
+    // there's one to spare
+    for (size_t i = 0; i < 3; ++i) {
+        idle[i].close();
+    }
+    EXPECT_EQ(fetch_within("GETFILE GET /file" + terminator,
+                           std::chrono::seconds{5}),
+              expected_response(data.at("/file")));
+    idle.clear();
+}
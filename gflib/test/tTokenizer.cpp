@@ -1,11 +1,13 @@
 #include "../gf-student.h"
 #include "TokenizerPtr.hpp"
+#include "random_bytes.hpp"
 #include "random_seed.hpp"
 #include "terminator.hpp"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <list>
 #include <random>
 
 using namespace gf::test;
@@ -56,7 +58,7 @@ class CppToken {
 
     CppToken(Token const& tok) {
         if (tok.id == PathToken) {
-            data_ = tok.data.path;
+            data_ = std::string{tok.data.path.text, tok.data.path.length};
         } else if (tok.id == SizeToken) {
             data_ = tok.data.size;
         } else {
@@ -132,8 +134,9 @@ Token to_token(CppToken const& tok) {
 
         Token operator()(std::string const& s) const {
             Token out;
-            out.id        = PathToken;
-            out.data.path = s.c_str();
+            out.id               = PathToken;
+            out.data.path.text   = s.c_str();
+            out.data.path.length = s.size();
             return out;
         }
     };
@@ -273,3 +276,284 @@ TEST(Tokenizer, Basic) {
     };
     test_points(tok, points);
 }
+
+// paths with every character that can be in one, long enough to go through the
+// vector code in tok_process.  test_point also feeds them 3 at a time, which
+// takes the scalar path.
+TEST(Tokenizer, LongPaths) {
+    auto         tok = create_tokenizer();
+    std::mt19937 gen{gf::test::random_seed()};
+    std::uniform_int_distribution<int>    charDist{0x21, 0x7e};
+    std::uniform_int_distribution<size_t> sizeDist{0, 300};
+
+    std::vector<Point> points;
+    for (size_t i = 0; i < 256; ++i) {
+        std::string path{'/'};
+        for (size_t n = sizeDist(gen); path.size() <= n;) {
+            path += static_cast<char>(charDist(gen));
+        }
+        points.push_back({"GETFILE GET " + path + terminator,
+                          true,
+                          {GetfileToken, GetToken, path}});
+        // and with something that doesn't belong in a path
+        for (char const bad : {'\x01', '\x7f', '\n'}) {
+            std::string badPath = path;
+            badPath.insert(std::uniform_int_distribution<size_t>{
+                               1, path.size()}(gen),
+                           1,
+                           bad);
+            points.push_back({"GETFILE GET " + badPath + terminator,
+                              false,
+                              {GetfileToken, GetToken}});
+        }
+    }
+    test_points(tok, points);
+}
+
+// tok_process_direct has to do exactly what tok_process does.  headers with
+// random damage, fed in random pieces to both.
+TEST(Tokenizer, DirectMatchesTable) {
+    auto         table  = create_tokenizer();
+    auto         direct = create_tokenizer();
+    std::mt19937 gen{gf::test::random_seed()};
+    RandomToken  randomToken;
+    // the table has no entries past 127
+    std::uniform_int_distribution<int>    charDist{0, 127};
+    std::uniform_int_distribution<size_t> pieceDist{1, 40};
+
+    for (size_t i = 0; i < 1024; ++i) {
+        std::vector<CppToken> tokens;
+        while (tokens.size() < 4) {
+            tokens.push_back(randomToken(gen));
+        }
+        std::string input = input_text(tokens) + terminator + ignored;
+        if (i % 2 == 1) {
+            std::uniform_int_distribution<size_t> where{0, input.size() - 1};
+            input[where(gen)] = static_cast<char>(charDist(gen));
+        }
+
+        tok_reset(table.get());
+        tok_reset(direct.get());
+        for (size_t at = 0; at < input.size();) {
+            size_t const n = std::min(pieceDist(gen), input.size() - at);
+            ASSERT_EQ(tok_process(table.get(), input.data() + at, n),
+                      tok_process_direct(direct.get(), input.data() + at, n))
+                << to_readable(input);
+            at += n;
+        }
+        EXPECT_EQ(tok_done(table.get()), tok_done(direct.get()));
+        EXPECT_EQ(tok_invalid(table.get()), tok_invalid(direct.get()));
+        EXPECT_EQ(get_tokens(table), get_tokens(direct)) << to_readable(input);
+    }
+}
+
+// slices have to come out the same as copies however the header is split up.
+// each piece goes through its own buffer, like a recv buffer.  paths that
+// arrive in one piece point into it, the rest are copied, and after
+// tok_copy_slices the pieces can go.
+TEST(Tokenizer, Slices) {
+    auto         copies = create_tokenizer();
+    auto         slices = create_tokenizer();
+    std::mt19937 gen{gf::test::random_seed()};
+    RandomToken  randomToken;
+    std::uniform_int_distribution<size_t> pieceDist{1, 300};
+    tok_set_slices(slices.get(), true);
+
+    size_t numSliced = 0;
+    for (size_t i = 0; i < 256; ++i) {
+        std::vector<CppToken> tokens;
+        while (tokens.size() < 8) {
+            tokens.push_back(randomToken(gen));
+        }
+        std::string const input = input_text(tokens);
+        bool const        copy  = i % 2 == 1;
+
+        tok_reset(copies.get());
+        tok_reset(slices.get());
+        process(copies, input);
+        std::list<std::string> pieces;
+        for (size_t at = 0; at < input.size();) {
+            auto& piece = pieces.emplace_back(
+                input.substr(at, std::min(pieceDist(gen), input.size() - at)));
+            ASSERT_EQ(tok_process(slices.get(), piece.data(), piece.size()),
+                      static_cast<ssize_t>(piece.size()));
+            for (size_t j = 0; j < tok_num_tokens(slices.get()); ++j) {
+                Token const t = tok_token(slices.get(), j);
+                if (t.id == PathToken && t.data.path.text >= piece.data() &&
+                    t.data.path.text < piece.data() + piece.size()) {
+                    ++numSliced;
+                }
+            }
+            if (copy) {
+                tok_copy_slices(slices.get());
+                std::ranges::fill(piece, 'x');
+            }
+            at += piece.size();
+        }
+        EXPECT_TRUE(tok_done(slices.get()));
+        EXPECT_EQ(get_tokens(copies), get_tokens(slices));
+    }
+    EXPECT_GT(numSliced, 0u);
+}
+
+// a tokenizer in a TokenizerStorage works like any other until it runs out of
+// room, then it's invalid and says it overflowed.
+TEST(Tokenizer, Storage) {
+    TokenizerStorage storage;
+    Tokenizer* const tok = tok_init(&storage);
+
+    std::string const path(TOKENIZER_STORAGE_CHARS - 1, 'a');
+    std::string const fits = "GETFILE GET /" + path.substr(1) + terminator;
+    EXPECT_EQ(tok_process(tok, fits.data(), fits.size()),
+              static_cast<ssize_t>(fits.size()));
+    EXPECT_TRUE(tok_done(tok));
+    ASSERT_EQ(tok_num_tokens(tok), 3u);
+    EXPECT_EQ(tok_token(tok, 2).data.path.length, path.size());
+
+    // one character too many for the path
+    std::string const tooLong = "GETFILE GET /" + path + terminator;
+    tok_reset(tok);
+    EXPECT_EQ(tok_process(tok, tooLong.data(), tooLong.size()), -1);
+    EXPECT_TRUE(tok_invalid(tok));
+    EXPECT_TRUE(tok_overflow(tok));
+    tok_reset(tok);
+    EXPECT_EQ(tok_process_direct(tok, tooLong.data(), tooLong.size()), -1);
+    EXPECT_TRUE(tok_overflow(tok));
+
+    // as a slice it doesn't take any room
+    tok_reset(tok);
+    tok_set_slices(tok, true);
+    EXPECT_EQ(tok_process(tok, tooLong.data(), tooLong.size()),
+              static_cast<ssize_t>(tooLong.size()));
+    EXPECT_TRUE(tok_done(tok));
+    EXPECT_FALSE(tok_overflow(tok));
+    tok_set_slices(tok, false);
+
+    // one token too many
+    std::string tooMany = "GETFILE";
+    for (size_t i = 1; i <= TOKENIZER_STORAGE_TOKENS; ++i) {
+        tooMany += " GET";
+    }
+    tooMany += terminator;
+    for (auto const process : {tok_process, tok_process_direct}) {
+        tok_reset(tok);
+        EXPECT_EQ(process(tok, tooMany.data(), tooMany.size()), -1);
+        EXPECT_TRUE(tok_overflow(tok));
+        EXPECT_EQ(tok_num_tokens(tok), size_t{TOKENIZER_STORAGE_TOKENS});
+    }
+}
+
+// the request and response grammars take what the any grammar does, in their
+// direction, and nothing going the other way.
+TEST(Tokenizer, Grammars) {
+    auto         any      = create_tokenizer();
+    auto         request  = create_tokenizer();
+    auto         response = create_tokenizer();
+    std::mt19937 gen{gf::test::random_seed()};
+    std::uniform_int_distribution<int>    charDist{0x21, 0x7e};
+    std::uniform_int_distribution<size_t> sizeDist{0, 100};
+    std::uniform_int_distribution<size_t> pieceDist{1, 40};
+    tok_set_grammar(request.get(), RequestGrammar);
+    tok_set_grammar(response.get(), ResponseGrammar);
+
+    std::vector<std::string> requests;
+    std::vector<std::string> responses = {"GETFILE FILE_NOT_FOUND" + terminator,
+                                          "GETFILE ERROR" + terminator,
+                                          "GETFILE INVALID" + terminator};
+    for (size_t i = 0; i < 256; ++i) {
+        std::string path{'/'};
+        for (size_t n = sizeDist(gen); path.size() <= n;) {
+            path += static_cast<char>(charDist(gen));
+        }
+        requests.push_back("GETFILE GET " + path + terminator);
+        responses.push_back("GETFILE OK " + std::to_string(gen()) + terminator);
+    }
+
+    // each grammar has its own direct code too
+    for (auto const tokProcess : {tok_process, tok_process_direct}) {
+        auto const run = [&](TokenizerPtr& tok, std::string const& input) {
+            tok_reset(tok.get());
+            for (size_t at = 0; at < input.size() && !tok_invalid(tok.get());) {
+                size_t const n = std::min(pieceDist(gen), input.size() - at);
+                tokProcess(tok.get(), input.data() + at, n);
+                at += n;
+            }
+            return tok_done(tok.get());
+        };
+        for (auto const& [input, right, wrong] :
+             {std::tuple{&requests, &request, &response},
+              std::tuple{&responses, &response, &request}}) {
+            for (auto const& header : *input) {
+                EXPECT_TRUE(run(any, header)) << to_readable(header);
+                EXPECT_TRUE(run(*right, header)) << to_readable(header);
+                EXPECT_EQ(get_tokens(any), get_tokens(*right));
+                EXPECT_FALSE(run(*wrong, header)) << to_readable(header);
+                // it knows as soon as it sees the second keyword
+                EXPECT_EQ(get_tokens(*wrong),
+                          std::vector<CppToken>{GetfileToken});
+            }
+        }
+    }
+}
+
+// the literal prefix fast path only kicks in on the first bytes of a header,
+// so feeding one byte first is the table alone.  they have to agree on
+// everything, whatever follows the prefix or whatever it's been mangled into.
+TEST(Tokenizer, LiteralPrefix) {
+    std::mt19937                          gen{random_seed()};
+    std::uniform_int_distribution<size_t> sizeDist{0, 32};
+    std::string const                     prefixes[] = {"GETFILE GET /",
+                                                        "GETFILE OK ",
+                                                        "GETFILE GET ",
+                                                        "GETFILE OK",
+                                                        "GETFILE  GET /",
+                                                        "GETFILE OK  "};
+    std::string const tails[]    = {"", "a/b" + terminator, "123" + terminator};
+
+    std::vector<std::string> inputs;
+    for (size_t i = 0; i < 64; ++i) {
+        auto const  bytes = random_bytes(gen, sizeDist(gen));
+        std::string random(bytes.size(), '\0');
+        std::ranges::transform(bytes, random.begin(), [](std::byte const b) {
+            return static_cast<char>(b);
+        });
+        for (auto const& prefix : prefixes) {
+            for (auto const& tail : tails) {
+                inputs.push_back(prefix + tail);
+            }
+            inputs.push_back(prefix + random);
+            // one byte of the prefix replaced
+            std::string mangled = prefix + tails[1];
+            mangled[i % prefix.size()] = random.empty() ? '\0' : random[0];
+            inputs.push_back(mangled);
+        }
+    }
+
+    auto whole = create_tokenizer();
+    auto split = create_tokenizer();
+    for (auto const grammar : {AnyGrammar, RequestGrammar, ResponseGrammar}) {
+        tok_set_grammar(whole.get(), grammar);
+        tok_set_grammar(split.get(), grammar);
+        for (auto const tokProcess : {tok_process, tok_process_direct}) {
+            for (auto const& input : inputs) {
+                tok_reset(whole.get());
+                tok_reset(split.get());
+                ssize_t const n =
+                    tokProcess(whole.get(), input.data(), input.size());
+                ssize_t splitN = tokProcess(split.get(), input.data(), 1);
+                if (splitN == 1 && !tok_done(split.get())) {
+                    ssize_t const rest = tokProcess(
+                        split.get(), input.data() + 1, input.size() - 1);
+                    splitN = rest < 0 ? rest : 1 + rest;
+                }
+                EXPECT_EQ(n, splitN) << to_readable(input);
+                EXPECT_EQ(tok_done(whole.get()), tok_done(split.get()))
+                    << to_readable(input);
+                EXPECT_EQ(tok_invalid(whole.get()), tok_invalid(split.get()))
+                    << to_readable(input);
+                EXPECT_EQ(get_tokens(whole), get_tokens(split))
+                    << to_readable(input);
+            }
+        }
+    }
+}
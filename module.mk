@@ -33,10 +33,14 @@ ALLCPPFILES := $(call ALLFILESWITHEXTENSION,cpp)
 TESTCFILES   := $(filter test/%,$(ALLCFILES))
 TESTCPPFILES := $(filter test/%,$(ALLCPPFILES))
 
-SRCCFILES    := $(filter-out $(TESTCFILES),$(ALLCFILES))
-SRCCPPFILES  := $(filter-out $(TESTCPPFILES),$(ALLCPPFILES))
+BENCHCFILES   := $(filter bench/%,$(ALLCFILES))
+BENCHCPPFILES := $(filter bench/%,$(ALLCPPFILES))
+
+SRCCFILES    := $(filter-out $(TESTCFILES) $(BENCHCFILES),$(ALLCFILES))
+SRCCPPFILES  := $(filter-out $(TESTCPPFILES) $(BENCHCPPFILES),$(ALLCPPFILES))
 
 TESTEXE      := $(TESTBINDIR)/test
+BENCHEXE     := $(TESTBINDIR)/bench
 
 TESTTS       := $(TESTTSDIR)/$(MODNAME).unit.ts
 SYSTEMTESTTS := $(TESTTSDIR)/$(MODNAME).system.ts
@@ -51,6 +55,8 @@ SRCCOBJS     := $(patsubst %.c,$(OBJDIR)/%.o,$(SRCCFILES))
 SRCCPPOBJS   := $(patsubst %.cpp,$(OBJDIR)/%.o,$(SRCCPPFILES))
 TESTCOBJS    := $(patsubst %.c,$(OBJDIR)/%.o,$(TESTCFILES))
 TESTCPPOBJS  := $(patsubst %.cpp,$(OBJDIR)/%.o,$(TESTCPPFILES))
+BENCHCOBJS   := $(patsubst %.c,$(OBJDIR)/%.o,$(BENCHCFILES))
+BENCHCPPOBJS := $(patsubst %.cpp,$(OBJDIR)/%.o,$(BENCHCPPFILES))
 
 MAINC        := $(if $(SRCCFILES),$(shell grep -l TEST_MODE $(SRCCFILES)))
 MAINCPP      := $(if $(SRCCPPFILES),$(shell grep -l TEST_MODE $(SRCCPPFILES)))
@@ -80,19 +86,36 @@ $(GENHDR) : $(GENHDRDIR)/%.h : %.c $(MAKEFILE_LIST) | $(GENHDRDIR)
 	@echo '#endif' >> $@
 	@echo '#endif' >> $@
 
+# tokenizer tables generated from the grammar descriptions, see main in the
+# generator.  the headers are checked in next to their grammar so that the plain
+# Makefiles build without the generator.  nothing regenerates them on its own,
+# run make grammars after changing a grammar or the generator.
+GRAMMARFILES := $(call ALLFILESWITHEXTENSION,grammar)
+GENERATOR    := $(THISDIR)/bin/$(ARCHDIR)/generator/main
+
+.PHONY : grammars
+grammars :
+ifneq ($(GRAMMARFILES),)
+	$(MAKE) -C $(THISDIR)/generator NORUNTESTS=1 ../bin/$(ARCHDIR)/generator/main
+	for grammar in $(GRAMMARFILES); do \
+	    $(GENERATOR) --direct $$grammar $${grammar%.grammar}-grammar.h || exit 1; \
+	done
+endif
 
 3PROOT           := $(THISDIR)/../../3p
 GOOGLETEST_ROOT  ?= $(3PROOT)/googletest
 BOOST_ROOT       ?= $(3PROOT)/boost_1_89_0
+GOOGLEBENCHMARK_ROOT ?= $(3PROOT)/benchmark
 
 OBJS         := $(sort $(SRCCOBJS) $(SRCCPPOBJS)) $(sort $(TESTCOBJS) $(TESTCPPOBJS)) $(EMBEDEDOBJS)
+BENCHOBJS    := $(sort $(SRCCOBJS) $(SRCCPPOBJS)) $(sort $(BENCHCOBJS) $(BENCHCPPOBJS)) $(EMBEDEDOBJS)
 
 DEPFILE       = $(patsubst %.o,%.d,$(1))
 
 CFLAGS = -c $< -o $@ $(if $(DEBUG),-O0,-O2) -g -Wpedantic -Wall -Werror -MMD -MF $(call DEPFILE,$@) -MP
 
-$(SRCCOBJS) $(TESTCOBJS) $(MAINCOBJS) : CFLAGS+=-std=c99 
-$(SRCCPPOBJS) $(TESTCPPOBJS) $(MAINCPPOBJS) : CFLAGS+=-std=c++20 
+$(SRCCOBJS) $(TESTCOBJS) $(BENCHCOBJS) $(MAINCOBJS) : CFLAGS+=-std=c99 
+$(SRCCPPOBJS) $(TESTCPPOBJS) $(BENCHCPPOBJS) $(MAINCPPOBJS) : CFLAGS+=-std=c++20 
 
 $(SRCCPPOBJS) $(MAINCPPOBJS) : CFLAGS+=$(if $(BOOST_IN_SOURCE),-I$(BOOST_ROOT))
 
@@ -101,10 +124,14 @@ $(SRCCOBJS) $(SRCCPPOBJS) : CFLAGS+=-DTEST_MODE=1
 $(TESTCOBJS) $(TESTCPPOBJS) : CFLAGS+=-I$(GOOGLETEST_ROOT)/googletest/include -I$(GOOGLETEST_ROOT)/googlemock/include -I$(BOOST_ROOT) -I$(GENHDRDIR)
 $(TESTCOBJS) $(TESTCPPOBJS) : | $(GENHDR)
 
-$(SRCCOBJS) $(TESTCOBJS) : $(OBJDIR)/%.o : %.c 
+# benchmarks may use the test helpers too
+$(BENCHCOBJS) $(BENCHCPPOBJS) : CFLAGS+=-I$(GOOGLEBENCHMARK_ROOT)/include -I$(GOOGLETEST_ROOT)/googletest/include -I$(GOOGLETEST_ROOT)/googlemock/include -I$(BOOST_ROOT) -I$(GENHDRDIR)
+$(BENCHCOBJS) $(BENCHCPPOBJS) : | $(GENHDR)
+
+$(SRCCOBJS) $(TESTCOBJS) $(BENCHCOBJS) : $(OBJDIR)/%.o : %.c 
 	gcc $(CFLAGS)
 
-$(SRCCPPOBJS) $(TESTCPPOBJS) : $(OBJDIR)/%.o : %.cpp
+$(SRCCPPOBJS) $(TESTCPPOBJS) $(BENCHCPPOBJS) : $(OBJDIR)/%.o : %.cpp
 	g++ $(CFLAGS)
 
 $(MAINCOBJS) : $(OBJDIR)/%_main.o : %.c 
@@ -116,6 +143,9 @@ $(MAINCPPOBJS) : $(OBJDIR)/%_main.o : %.cpp
 $(TESTEXE) : $(OBJS) $(MAKEFILE_LIST) | $(TESTBINDIR)
 	g++ -o $@ $(OBJS) $(GOOGLETEST_ROOT)/build/lib/libgmock.a $(GOOGLETEST_ROOT)/build/lib/libgtest.a
 
+$(BENCHEXE) : $(BENCHOBJS) $(MAKEFILE_LIST) | $(TESTBINDIR)
+	g++ -o $@ $(BENCHOBJS) $(GOOGLEBENCHMARK_ROOT)/build/src/libbenchmark.a -lpthread
+
 EXESRCOBJS := $(sort \
   $(filter-out $(patsubst %.c,$(OBJDIR)/%.o,$(MAINC)),$(SRCCOBJS)) \
   $(filter-out $(patsubst %.cpp,$(OBJDIR)/%.o,$(MAINCPP)),$(SRCCPPOBJS)))
@@ -151,17 +181,30 @@ ifndef NORUNTESTS
   build : $(TESTTS) $(SYSTEMTESTTS)
 endif
 
+# benchmarks aren't part of build.  run them explicitly with make bench.  pass
+# benchmark options in BENCHARGS, e.g., BENCHARGS=--benchmark_format=json
+.PHONY : bench
+bench : $(BENCHEXE)
+	$(BENCHEXE) $(BENCHARGS)
+
+# the same, also written as json to bench-<commit>.json in TESTBINDIR, to
+# compare commits with, e.g., google benchmark's tools/compare.py
+BENCHJSON = $(TESTBINDIR)/bench-$(shell git rev-parse --short HEAD 2>/dev/null || echo unknown).json
+.PHONY : bench-json
+bench-json : $(BENCHEXE)
+	$(BENCHEXE) --benchmark_out=$(BENCHJSON) --benchmark_out_format=json $(BENCHARGS)
+
 .PHONY : clean
 clean : 
-	$(RM) -rf $(OBJDIR) $(TESTEXE) $(TESTTS)
+	$(RM) -rf $(OBJDIR) $(TESTEXE) $(BENCHEXE) $(TESTTS)
 
-ALLOBJDIRS := $(sort $(patsubst %/,%,$(dir $(OBJS))))
-$(OBJS) : $(MAKEFILE_LIST) | $(ALLOBJDIRS)
+ALLOBJDIRS := $(sort $(patsubst %/,%,$(dir $(OBJS) $(BENCHOBJS))))
+$(OBJS) $(BENCHOBJS) : $(MAKEFILE_LIST) | $(ALLOBJDIRS)
 
 $(ALLOBJDIRS) $(TESTBINDIR) $(TESTTSDIR) $(GENHDRDIR) $(BINDIR) :
 	mkdir -p $@
 
--include $(call DEPFILE,$(OBJS))
+-include $(call DEPFILE,$(sort $(OBJS) $(BENCHOBJS)))
 
 
 
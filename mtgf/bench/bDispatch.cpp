@@ -0,0 +1,152 @@
+#include "../gfserver-student.h"
+
+#include <benchmark/benchmark.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+
+// requests served through the multi threaded handler, the native HandlerClient
+// and the content Source, with the handler's calls to them through the function
+// pointers (the TEST_MODE build) or bound at compile time (static_dispatch.c,
+// the production build).  reads aren't shared so each 1 KiB chunk of the file
+// is one read and one send.  run from the module directory for content.txt.
+
+extern "C" {
+// content.h isn't ready for C++
+#include "../content.h"
+
+// the static_dispatch.c build of gfserver_main.c
+MultiThreadedHandler* static_mth_start_with(WpOptions const* poolOptions,
+                                            size_t           numThreads,
+                                            HandlerClient*   handlerClient,
+                                            Source*          source);
+void static_mth_share_reads(MultiThreadedHandler*, size_t window);
+void static_mth_process(MultiThreadedHandler* mtc,
+                        gfcontext_t**         ctx,
+                        char const*           path);
+void static_mth_finish(MultiThreadedHandler*);
+void static_hc_init_native(HandlerClient* client);
+void static_content_source_init(Source*);
+}
+
+namespace {
+
+unsigned short const port = 56742;
+char const* const    path = "/courses/ud923/filecorpus/road.jpg";
+
+// one build's entry points
+struct Dispatch {
+    MultiThreadedHandler* (*start_with)(WpOptions const*,
+                                        size_t,
+                                        HandlerClient*,
+                                        Source*);
+    void (*share_reads)(MultiThreadedHandler*, size_t);
+    void (*process)(MultiThreadedHandler*, gfcontext_t**, char const*);
+    void (*finish)(MultiThreadedHandler*);
+    void (*init_native)(HandlerClient*);
+    void (*content_source_init)(Source*);
+};
+
+Dispatch const dynamic_dispatch = {mth_start_with,
+                                   mth_share_reads,
+                                   mth_process,
+                                   mth_finish,
+                                   hc_init_native,
+                                   content_source_init};
+
+Dispatch const static_dispatch = {static_mth_start_with,
+                                  static_mth_share_reads,
+                                  static_mth_process,
+                                  static_mth_finish,
+                                  static_hc_init_native,
+                                  static_content_source_init};
+
+struct Handler {
+    Dispatch const*       dispatch;
+    MultiThreadedHandler* mth;
+};
+
+gfh_error_t handle_(gfcontext_t** ctx, char const* path, void* handler_) {
+    auto const& handler = *static_cast<Handler*>(handler_);
+    handler.dispatch->process(handler.mth, ctx, path);
+    return 0;
+}
+
+// request path and read the response to the end.  returns the bytes read.
+size_t fetch_(std::string const& request) {
+    int const   socketId = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family      = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port        = htons(port);
+    if (connect(socketId, (sockaddr*)&address, sizeof(address)) == -1 ||
+        send(socketId, request.data(), request.size(), 0) !=
+            (ssize_t)request.size()) {
+        close(socketId);
+        return 0;
+    }
+    size_t  out = 0;
+    char    buffer[64 * 1024];
+    ssize_t numRead;
+    while ((numRead = recv(socketId, buffer, sizeof(buffer), 0)) > 0) {
+        out += (size_t)numRead;
+    }
+    close(socketId);
+    return out;
+}
+
+void BM_serve(benchmark::State& state, Dispatch const& dispatch) {
+    static bool const loaded = content_init("content.txt") == 0;
+    benchmark::DoNotOptimize(loaded);
+
+    HandlerClient client;
+    Source        source;
+    dispatch.init_native(&client);
+    dispatch.content_source_init(&source);
+    Handler handler{&dispatch, dispatch.start_with(NULL, 1, &client, &source)};
+    dispatch.share_reads(handler.mth, 0);
+
+    std::atomic<bool> stop{false};
+    gfserver_t*       gfs = gfserver_create();
+    gfserver_set_port(&gfs, port);
+    gfserver_set_handler(&gfs, handle_);
+    gfserver_set_handlerarg(&gfs, &handler);
+    gfserver_set_continue_fcn(
+        &gfs,
+        [](void* stop) { return !*static_cast<std::atomic<bool>*>(stop); },
+        &stop);
+    if (gfserver_listen(&gfs) != 0) {
+        state.SkipWithError("failed to listen");
+        gfserver_destroy(&gfs);
+        dispatch.finish(handler.mth);
+        return;
+    }
+    std::thread server{[&gfs] { gfserver_serve(&gfs); }};
+
+    std::string const request = std::string{"GETFILE GET "} + path + "\r\n\r\n";
+    size_t            numBytes = 0;
+    for (auto _ : state) {
+        size_t const n = fetch_(request);
+        if (n == 0) {
+            state.SkipWithError("fetch failed");
+            break;
+        }
+        numBytes += n;
+    }
+    state.SetBytesProcessed(numBytes);
+
+    stop = true;
+    server.join();
+    dispatch.finish(handler.mth);
+    gfserver_destroy(&gfs);
+}
+} // namespace
+
+BENCHMARK_CAPTURE(BM_serve, dynamic, dynamic_dispatch)->UseRealTime();
+BENCHMARK_CAPTURE(BM_serve, static, static_dispatch)->UseRealTime();
@@ -0,0 +1,136 @@
+#include "../gf-student.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <thread>
+
+// the mutex queue against the ring and the work stealing deques, a task or a
+// batch at a time, from 1 to 64 threads
+
+namespace {
+
+enum class Kind { Mutex, Ring };
+
+Queue* create_queue(Kind const kind) {
+    return kind == Kind::Ring ? queue_create_ring(1024) : queue_create();
+}
+
+// every thread puts one in and takes one out, so nobody waits for long
+void BM_queue_pairs(benchmark::State& state, Kind const kind) {
+    static Queue* q = nullptr;
+    if (state.thread_index() == 0) {
+        q = create_queue(kind);
+    }
+    int item = 0;
+    for (auto _ : state) {
+        queue_enqueue(q, &item);
+        benchmark::DoNotOptimize(queue_dequeue(q));
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        queue_destroy(q);
+        q = nullptr;
+    }
+}
+
+void nothing_(WpTask task, void*) {
+    benchmark::DoNotOptimize(task);
+}
+
+// one thread adds tasks that do nothing for range(0) workers, that take up to
+// maxBatch at a time
+void BM_pool_tasks(benchmark::State& state,
+                   WpQueueKind const kind,
+                   size_t const      maxBatch = 1) {
+    size_t const    numTasks = 16 * 1024;
+    WpOptions const options{kind, 1024, maxBatch, nullptr};
+    for (auto _ : state) {
+        WorkerPool* const pool =
+            wp_start_with(&options,
+                          static_cast<size_t>(state.range(0)),
+                          nothing_,
+                          nullptr,
+                          nullptr);
+        for (size_t i = 0; i < numTasks; ++i) {
+            wp_add_task(pool, &state);
+        }
+        wp_finish(pool, nullptr, nullptr);
+    }
+    state.SetItemsProcessed(state.iterations() * numTasks);
+}
+
+struct Tree {
+    WorkerPool*      pool = nullptr;
+    std::atomic<int> unfinished{0};
+};
+
+// a binary tree of tasks, each adds its two children to the pool
+void grow_(WpTask depth_, void* tree_) {
+    auto* const tree  = static_cast<Tree*>(tree_);
+    auto const  depth = reinterpret_cast<intptr_t>(depth_);
+    if (depth > 0) {
+        tree->unfinished += 2;
+        WpTask children[] = {reinterpret_cast<WpTask>(depth - 1),
+                             reinterpret_cast<WpTask>(depth - 1)};
+        wp_add_tasks(tree->pool, children, 2);
+    }
+    --tree->unfinished;
+}
+
+// tasks adding tasks for range(0) workers, where the deques don't share
+void BM_pool_tree(benchmark::State& state, WpQueueKind const kind) {
+    intptr_t const  depth = 14;
+    WpOptions const options{kind, 2 << depth};
+    for (auto _ : state) {
+        Tree tree;
+        tree.pool = wp_start_with(&options,
+                                  static_cast<size_t>(state.range(0)),
+                                  grow_,
+                                  [](void* t) { return t; },
+                                  &tree);
+        tree.unfinished = 1;
+        wp_add_task(tree.pool, reinterpret_cast<WpTask>(depth));
+        while (tree.unfinished > 0) {
+            std::this_thread::yield();
+        }
+        wp_finish(tree.pool, nullptr, nullptr);
+    }
+    state.SetItemsProcessed(state.iterations() * ((2 << depth) - 1));
+}
+} // namespace
+
+BENCHMARK_CAPTURE(BM_queue_pairs, mutex, Kind::Mutex)->ThreadRange(1, 64);
+BENCHMARK_CAPTURE(BM_queue_pairs, ring, Kind::Ring)->ThreadRange(1, 64);
+BENCHMARK_CAPTURE(BM_pool_tasks, mutex, WpMutexQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_pool_tasks, ring, WpRingQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_pool_tasks, mutex_batch, WpMutexQueue, 32)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_pool_tasks, ring_batch, WpRingQueue, 32)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_pool_tasks, stealing, WpWorkStealing)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_pool_tree, mutex, WpMutexQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_pool_tree, ring, WpRingQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_pool_tree, stealing, WpWorkStealing)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
@@ -0,0 +1,31 @@
+// gfserver_main.c again, dispatching the way the production build does (see
+// GF_STATIC_DISPATCH there) but without its main.  its external names get a
+// static_ prefix so that it links next to the TEST_MODE build, which dispatches
+// through the function pointers, and bDispatch.cpp can run the two side by
+// side.
+#define TEST_MODE          1
+#define GF_STATIC_DISPATCH 1
+
+#define content_source_init         static_content_source_init
+#define hc_abort                    static_hc_abort
+#define hc_init_native              static_hc_init_native
+#define hc_initialize               static_hc_initialize
+#define hc_send                     static_hc_send
+#define hc_send_header              static_hc_send_header
+#define hc_send_prepared_header     static_hc_send_prepared_header
+#define hc_set_send_prepared_header static_hc_set_send_prepared_header
+#define mth_finish                  static_mth_finish
+#define mth_process                 static_mth_process
+#define mth_share_reads             static_mth_share_reads
+#define mth_start                   static_mth_start
+#define mth_start_with              static_mth_start_with
+#define mth_task_create_            static_mth_task_create_
+#define mth_task_destroy_           static_mth_task_destroy_
+#define source_finish               static_source_finish
+#define source_header               static_source_header
+#define source_initialize           static_source_initialize
+#define source_read                 static_source_read
+#define source_set_header_fcn       static_source_set_header_fcn
+#define source_start                static_source_start
+
+#include "../gfserver_main.c"
@@ -1,6 +1,10 @@
 
 #define _DEFAULT_SOURCE
 
+#include "content.h"
+
+#include "gf-student-gflib.h"
+
 #include <sys/stat.h>
 
 #include <fcntl.h>
@@ -14,6 +18,8 @@
 typedef struct {
     int  fildes;
     char key[MAX_KEYLEN];
+    // GETFILE OK <size>, serialized once at load time
+    ResponseHeader header;
 } item_t;
 
 static int     nitems;
@@ -48,6 +54,14 @@ int content_init(char const* filename) {
             fprintf(stderr, "Unable to open file %s.\n", path);
             exit(EXIT_FAILURE);
         }
+        struct stat st;
+        if (0 > fstat(items[nitems].fildes, &st)) {
+            fprintf(stderr, "Unable to stat file %s.\n", path);
+            exit(EXIT_FAILURE);
+        }
+        Response const response = {.status = OkResponse,
+                                   .size   = (size_t)st.st_size};
+        response_header_init(&items[nitems].header, &response);
         nitems++;
 
         if (nitems == capacity) {
@@ -65,15 +79,12 @@ int content_init(char const* filename) {
 
 unsigned long int content_delay = 0;
 
-int content_get(char const* key) {
+// find key in items, NULL if it's not there
+static item_t const* find_(char const* key) {
     int lo = 0;
     int hi = nitems - 1;
     int mid, cmp;
 
-    if (content_delay > 0) {
-        usleep(content_delay);
-    }
-
     while (lo <= hi) {
         // Key is in items[lo..hi] or not present.
         mid = lo + (hi - lo) / 2;
@@ -83,10 +94,29 @@ int content_get(char const* key) {
         } else if (cmp > 0) {
             lo = mid + 1;
         } else {
-            return items[mid].fildes;
+            return items + mid;
         }
     }
-    return -1;
+    return NULL;
+}
+
+int content_get(char const* key) {
+    return content_get_with_header(key, NULL);
+}
+
+int content_get_with_header(char const*            key,
+                            ResponseHeader const** header) {
+    if (content_delay > 0) {
+        usleep(content_delay);
+    }
+    item_t const* const item = find_(key);
+    if (!item) {
+        return -1;
+    }
+    if (header) {
+        *header = &item->header;
+    }
+    return item->fildes;
 }
 
 void content_destroy() {
@@ -19,6 +19,17 @@ int content_init(const char *filename);
  */
 int content_get(const char *key);
 
+/* defined in gf-student-gflib.h */
+struct ResponseHeaderTag;
+
+/*
+ * Like content_get but also sets *header to the GETFILE OK header for the
+ * file.  The header is serialized once, when the content is loaded, and is
+ * valid until content_destroy.  *header is left alone if the key isn't found.
+ */
+int content_get_with_header(const char *key,
+                            struct ResponseHeaderTag const **header);
+
 /* 
  * Frees all memory and closes all file descriptors
  * associated with the cache.
@@ -2,8 +2,8 @@
  *  This file is for use by students to define anything they wish.  It is used
  * by both the gf server and client implementations
  */
-#ifndef __GF_STUDENT_H__
-#define __GF_STUDENT_H__
+#ifndef __GF_STUDENT_GFLIB_H__
+#define __GF_STUDENT_GFLIB_H__
 
 #include <sys/types.h>
 
@@ -72,10 +72,15 @@ struct TokenTag {
     TokenId id;
 
     union {
-        // points to a null-terminated string that is a path.  paths must start
-        // with / the memory for this string is owned by the tokenizer and can
-        // be invalidated if the tokenizer processes more tokens or is reset.
-        char const* path;
+        // a path, length characters starting at text.  paths must start with /.
+        // normally the tokenizer owns the characters, null terminates them and
+        // they can be invalidated if the tokenizer processes more tokens or is
+        // reset.  with tok_set_slices, text may instead point into the buffer
+        // given to tok_process and isn't null terminated.
+        struct {
+            char const* text;
+            size_t      length;
+        } path;
 
         // the value of a size read in as a decimal value.
         size_t size;
@@ -85,6 +90,27 @@ struct TokenTag {
 // allocate and reset a tokenizer ready to process text
 Tokenizer* tok_create();
 
+// the fixed capacity of a tokenizer in a TokenizerStorage
+#define TOKENIZER_STORAGE_TOKENS 16
+#define TOKENIZER_STORAGE_CHARS  4096
+
+typedef struct TokenizerStorageTag TokenizerStorage;
+
+// room for a tokenizer that never allocates, so that it can live on the stack
+// or in a per connection struct.  the members are private, see tok_init.
+struct TokenizerStorageTag {
+    uint64_t tokenizer[16];
+    Token    tokens[TOKENIZER_STORAGE_TOKENS];
+    char     chars[TOKENIZER_STORAGE_CHARS];
+};
+
+// reset a tokenizer in storage, ready to process text, and return it.  it can
+// hold TOKENIZER_STORAGE_TOKENS tokens and TOKENIZER_STORAGE_CHARS characters
+// of copied paths (null terminators included) and going over is an error, see
+// tok_overflow.  it's good for as long as storage is and must not be passed to
+// tok_destroy.
+Tokenizer* tok_init(TokenizerStorage* storage);
+
 // Do the processing starting with buffer and processing up to n characters.
 // Possible return values (with a non-zero n) are:
 //
@@ -101,6 +127,39 @@ Tokenizer* tok_create();
 // will return true in this case.
 ssize_t tok_process(Tokenizer*, char const* buffer, size_t n);
 
+// same as tok_process but runs the direct coded tokenizer (straight line code
+// with a label per state, written by the generator with --direct) instead of
+// going through the table.  the two can be used on the same Tokenizer.
+ssize_t tok_process_direct(Tokenizer*, char const* buffer, size_t n);
+
+// turn slice mode on or off (it starts off and tok_reset leaves it alone).  in
+// slice mode a path that arrives whole in one call to tok_process isn't copied,
+// its token points straight into the buffer that was passed in and is only
+// good for as long as that buffer's contents are.  only paths that span calls
+// get copied.
+void tok_set_slices(Tokenizer*, bool slices);
+
+// copy every path token that points into a caller's buffer (see
+// tok_set_slices) into the tokenizer so that the buffer can be reused.
+void tok_copy_slices(Tokenizer*);
+
+// what a tokenizer takes, see tok_set_grammar.
+typedef enum {
+    // requests and responses, the default
+    AnyGrammar,
+    // requests only: GETFILE, GET and a path
+    RequestGrammar,
+    // responses only: GETFILE, a status and for OK, a size
+    ResponseGrammar,
+    NumGrammars
+} TokenizerGrammar;
+
+// tokenize with a table for just one direction of the protocol (it starts out
+// with AnyGrammar and tok_reset leaves it alone).  the tables are smaller and
+// a header going the wrong way is invalid as soon as it shows.  each grammar
+// has direct code for tok_process_direct too.
+void tok_set_grammar(Tokenizer*, TokenizerGrammar);
+
 // returns true if the tokenizer has enountered the terminating sequence of
 // characters.
 bool tok_done(Tokenizer const*);
@@ -109,6 +168,10 @@ bool tok_done(Tokenizer const*);
 // characters
 bool tok_invalid(Tokenizer const*);
 
+// returns true if a tokenizer from tok_init ran out of room.  it's also
+// tok_invalid.
+bool tok_overflow(Tokenizer const*);
+
 // return the number of tokens enountered by the tokenizer so far.
 // more specifically, the number of tokens *completed* by the tokenizer so far.
 // can be called at any time, even if invalid (will return the number tokens
@@ -141,6 +204,15 @@ int snprintf_tokens(char*        buffer,
                     Token const* tokens,
                     size_t       numTokens);
 
+// the number of characters write_tokens writes for tokens.
+size_t tokens_length(Token const* tokens, size_t numTokens);
+
+// print the tokens like snprintf_tokens but without any checks and without a
+// null: buffer must have room for tokens_length characters.  keywords are
+// copied and sizes formatted two digits at a time, no snprintf.  returns the
+// number of characters written.
+size_t write_tokens(char* buffer, Token const* tokens, size_t numTokens);
+
 /////////////////////////////////////////////////////////
 // Headers
 /////////////////////////////////////////////////////////
@@ -149,7 +221,11 @@ typedef struct RequestGetTag RequestGet;
 
 // a request to the server
 struct RequestGetTag {
+    // pathLength characters starting at path.  unpack_request_get leaves path
+    // pointing into the tokenizer's token, so it's only null terminated if the
+    // token is (see Token).
     char const* path;
+    size_t      pathLength;
 };
 
 // print the request into the provided buffer.  printed in the protocol format
@@ -188,6 +264,10 @@ struct ResponseTag {
 // returns like snprintf.
 int snprintf_response(char* buffer, size_t n, Response const*);
 
+// like snprintf_response but with write_tokens: buffer must have room for
+// RESPONSE_HEADER_CAPACITY characters.  returns the number written.
+size_t write_response(char* buffer, Response const*);
+
 // if the Tokenizer is done and contains the expected tokens, then populate the
 // provided Response and return 0.  Otherwise, return -1.
 // The Tokenizer must have 2 or 3 tokens:
@@ -198,6 +278,90 @@ int snprintf_response(char* buffer, size_t n, Response const*);
 // GetfileToken, InvalidToken
 int unpack_response(Tokenizer const* tok, Response*);
 
+// the longest response header: GETFILE OK, a 20 digit size and the terminator.
+#define RESPONSE_HEADER_CAPACITY 40
+
+typedef struct ResponseHeaderTag ResponseHeader;
+
+// a Response already serialized in the protocol format, terminator and all, so
+// that it can be sent as is.  for headers that get sent over and over.
+struct ResponseHeaderTag {
+    // what was serialized
+    Response response;
+    // the number of bytes in text.  text is not null terminated.
+    size_t size;
+    char   text[RESPONSE_HEADER_CAPACITY];
+};
+
+// serialize response into header.
+void response_header_init(ResponseHeader* header, Response const* response);
+
+// the serialized header for any status but OkResponse.  these never change so
+// they're built at compile time.  returns NULL for OkResponse (which needs a
+// size, see response_header_init) or an unknown status.
+ResponseHeader const* response_header_static(ResponseStatus);
+
+/////////////////////////////////////////////////////////
+// Binary Headers
+/////////////////////////////////////////////////////////
+
+// GETFILE2, the binary protocol.  no decimals, no tokens, no terminator to
+// scan for.  every header is BINARY_HEADER_SIZE bytes, little endian:
+//
+//     offset  size
+//          0     4  magic and version: 0, 'G', 'F', BINARY_VERSION
+//          4     1  opcode (BinaryOpcode)
+//          5     1  0
+//          6     2  path length, requests only
+//          8     8  file size, OK responses only
+//
+// a request's path follows its header and an OK response's file follows its.
+// text headers never start with a 0 so the first byte on a connection says
+// which protocol it speaks.
+#define BINARY_HEADER_SIZE 16
+#define BINARY_VERSION 2
+// the longest path in a binary request.  the request and a null terminator
+// fit in the server's 1024 byte header buffer.
+#define BINARY_MAX_PATH (1024 - BINARY_HEADER_SIZE - 1)
+
+// the responses are in ResponseStatus order
+typedef enum {
+    BinaryGetOpcode = 1,
+    BinaryOkOpcode,
+    BinaryFileNotFoundOpcode,
+    BinaryErrorOpcode,
+    BinaryInvalidOpcode,
+} BinaryOpcode;
+
+// which protocol a connection speaks
+typedef enum {
+    GfTextProtocol,
+    GfBinaryProtocol,
+} GfProtocol;
+
+// true if the first n bytes of a connection, at least 1, start a binary header
+bool is_binary_header(uint8_t const* buffer, size_t n);
+
+// write the request's header and path to buffer, which must have room for
+// BINARY_HEADER_SIZE + request->pathLength bytes.  the path must be no longer
+// than BINARY_MAX_PATH.  returns the number of bytes written.
+size_t write_binary_request_get(uint8_t* buffer, RequestGet const*);
+
+// unpack the request at the start of the n bytes in buffer.  returns the size
+// of the request, header and path, 0 if that's more than n, and -1 if it's
+// not a valid request.  the request's path points into buffer.
+ssize_t unpack_binary_request_get(uint8_t const* buffer,
+                                  size_t         n,
+                                  RequestGet*);
+
+// write the response's header, BINARY_HEADER_SIZE bytes, to buffer.
+void write_binary_response(uint8_t* buffer, Response const*);
+
+// unpack the response header at the start of the n bytes in buffer.  returns
+// BINARY_HEADER_SIZE, 0 if that's more than n, and -1 if it's not a valid
+// response.
+ssize_t unpack_binary_response(uint8_t const* buffer, size_t n, Response*);
+
 /////////////////////////////////////////////////////////
 // Socket Helpers
 /////////////////////////////////////////////////////////
@@ -208,7 +372,60 @@ ssize_t sock_send_all(int const            socketId,
                       uint8_t const* const buffer,
                       size_t               n);
 
+// turn on SO_ZEROCOPY for socketId so that it may be used with a ZerocopySends.
+// Returns 0 on success.  Returns -1 if the platform or the socket doesn't
+// support zero copy sends.
+int sock_enable_zerocopy(int socketId);
+
+/*!
+ The MSG_ZEROCOPY sends on a socket that the kernel may still be reading.  the
+ kernel pins a buffer's pages instead of copying them, so the buffer can't
+ change until the kernel is done with it, which for TCP is once the data's been
+ ACKed.  it numbers the sends on a socket from its first one and reports
+ ranges of them done on the socket's error queue, so each socket gets one
+ ZerocopySends, made before its first MSG_ZEROCOPY send.
+
+ zc_send sends a buffer and returns as soon as it's queued.  zc_reap reads the
+ notifications that have arrived and gives each buffer that's done back to its
+ owner by calling the release function it was sent with.  zc_destroy waits for
+ the rest.  socketId must have been passed to sock_enable_zerocopy.
+ */
+typedef struct ZerocopySendsTag ZerocopySends;
+
+// called once the kernel is done with buffer.  it's the caller's again.
+typedef void (*ZcReleaseFcn)(void const* buffer, void* releaseArg);
+
+ZerocopySends* zc_create(int socketId);
+
+// waits for everything outstanding (zc_reap(zs, true)) and destroys zs, which
+// may be NULL.  returns -1 if the socket failed first.  the buffers that
+// weren't done then are never released, the kernel may still hold them.
+int zc_destroy(ZerocopySends* zs);
+
+// send n bytes of buffer, all of it, like sock_send_all.  release, if non-NULL,
+// is called with buffer and releaseArg from a later zc_reap (or this call if
+// none of it's pinned) once the kernel's done with it, whether or not the send
+// succeeds.  returns n or -1 on failure.
+ssize_t zc_send(ZerocopySends* zs,
+                uint8_t const* buffer,
+                size_t         n,
+                ZcReleaseFcn   release,
+                void*          releaseArg);
+
+// read the completions that have arrived and release the buffers that are
+// done.  if wait, keep at it until there's nothing outstanding.  returns -1 on
+// failure, see zc_destroy.
+int zc_reap(ZerocopySends* zs, bool wait);
+
+// the number of sends that haven't completed
+size_t zc_outstanding(ZerocopySends const* zs);
+
+// true once the kernel has reported that it copied a send after all (e.g.,
+// over loopback).  zero copy is just overhead then and the caller should go
+// back to sock_send_all.
+bool zc_copied(ZerocopySends const* zs);
+
 #ifdef __cplusplus
 }
 #endif
-#endif // __GF_STUDENT_H__
+#endif // __GF_STUDENT_GFLIB_H__
@@ -1,4 +1,6 @@
 #define _POSIX_C_SOURCE 200809L
+// syscall for futexes
+#define _DEFAULT_SOURCE
 #include "gf-student.h"
 
 #include "content.h"
@@ -8,27 +10,505 @@
 #include <sys/stat.h>
 
 #include <assert.h>
+#include <errno.h>
+#include <limits.h>
 #include <memory.h>
 #include <pthread.h>
+#include <sched.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 /////////////////////////////////////////////////////////////
 // Concurrent Queue
 /////////////////////////////////////////////////////////////
 
+// an eventcount.  a waiter announces itself, checks for what it's waiting for
+// again and only then sleeps, until a notify after the announcement.
+// notifying is a load unless somebody's waiting who hasn't been woken yet.
+//
+// it's one word so a waiter's key is the epoch it announced in and a notify
+// sees the waiters and woken together: the epoch, the waiters and of them how
+// many have been woken and aren't back yet.  a woken thread that hasn't run
+// yet would otherwise have every notify make a syscall, on a busy machine
+// that's a while.  the futex is the epoch's half.
+typedef union {
+    uint64_t state;
+    uint32_t halves[2];
+} EventCount;
+
+#define EC_WOKEN_ONE_   UINT64_C(1)
+#define EC_WAITER_ONE_  (UINT64_C(1) << 16)
+#define EC_EPOCH_ONE_   (UINT64_C(1) << 32)
+#define EC_WOKEN_(s)    ((s) & 0xffff)
+#define EC_WAITERS_(s)  (((s) >> 16) & 0xffff)
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define EC_EPOCH_HALF_ 1
+#else
+#define EC_EPOCH_HALF_ 0
+#endif
+
+// announce a wait, returning the key for ec_wait_
+static uint32_t ec_prepare_wait_(EventCount* const ec) {
+    uint64_t const state =
+        __atomic_fetch_add(&ec->state, EC_WAITER_ONE_, __ATOMIC_SEQ_CST);
+    // pairs with ec_notify_'s.  either the notifier sees the waiter or the
+    // waiter's check after this sees what the notifier did.
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    return (uint32_t)(state >> 32);
+}
+
+// done waiting, whyever.  a notify's skipped when everybody's been woken so
+// woken can't be more than the waiters that are going to come back, and every
+// waiter with a key from before a wake does come back.  it goes down for
+// everybody, too low is only a wasted syscall.
+static void ec_leave_(EventCount* const ec) {
+    uint64_t state = __atomic_load_n(&ec->state, __ATOMIC_RELAXED);
+    uint64_t next  = 0;
+    do {
+        uint64_t const waiters = EC_WAITERS_(state) - 1;
+        uint64_t       woken   = EC_WOKEN_(state);
+        woken                  = woken == 0 ? 0 : woken - 1;
+        woken                  = woken > waiters ? waiters : woken;
+        next = (state & ~UINT64_C(0xffffffff)) | waiters << 16 | woken;
+    } while (!__atomic_compare_exchange_n(
+        &ec->state, &state, next, true, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+}
+
+// the check after ec_prepare_wait_ found what it was waiting for
+static void ec_cancel_wait_(EventCount* const ec) {
+    ec_leave_(ec);
+}
+
+// sleep until a notify since key was taken or for timeout, if it isn't NULL.
+// it can wake up early so check again.
+static void ec_wait_(EventCount* const            ec,
+                     uint32_t const               key,
+                     struct timespec const* const timeout) {
+#if defined(__linux__)
+    syscall(SYS_futex,
+            ec->halves + EC_EPOCH_HALF_,
+            FUTEX_WAIT_PRIVATE,
+            key,
+            timeout,
+            NULL,
+            0);
+#else
+    (void)key;
+    (void)timeout;
+    sched_yield();
+#endif
+    ec_leave_(ec);
+}
+
+// wake one waiter, or all of them
+static void ec_notify_(EventCount* const ec, bool const all) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    uint64_t state = __atomic_load_n(&ec->state, __ATOMIC_RELAXED);
+    uint64_t next  = 0;
+    do {
+        uint64_t const waiters = EC_WAITERS_(state);
+        uint64_t const woken   = EC_WOKEN_(state);
+        if (woken >= waiters) {
+            // nobody, or they're all on their way to check again
+            return;
+        }
+        // everybody announced has an older key and comes back, asleep or not
+        next = state + EC_EPOCH_ONE_ +
+               (all ? waiters - woken : 1) * EC_WOKEN_ONE_;
+    } while (!__atomic_compare_exchange_n(
+        &ec->state, &state, next, true, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+#if defined(__linux__)
+    syscall(SYS_futex,
+            ec->halves + EC_EPOCH_HALF_,
+            FUTEX_WAKE_PRIVATE,
+            all ? INT_MAX : 1,
+            NULL,
+            NULL,
+            0);
+#endif
+}
+
+// the clock timed waits go by, the mutex queue's condition variable's too
+static struct timespec now_(void) {
+    struct timespec out;
+    clock_gettime(CLOCK_MONOTONIC, &out);
+    return out;
+}
+
+#define NS_PER_S_ INT64_C(1000000000)
+
+static struct timespec add_ns_(struct timespec t, int64_t const ns) {
+    int64_t const total = t.tv_nsec + ns;
+    t.tv_sec += (time_t)(total / NS_PER_S_);
+    t.tv_nsec = (long)(total % NS_PER_S_);
+    return t;
+}
+
+static int64_t ns_between_(struct timespec const* const from,
+                           struct timespec const* const to) {
+    return (int64_t)(to->tv_sec - from->tv_sec) * NS_PER_S_ +
+           (to->tv_nsec - from->tv_nsec);
+}
+
+// Vyukov's bounded MPMC queue.  a cell's sequence says whose turn it is: pos
+// when it's free for the enqueue at pos, pos + 1 when it's full for the dequeue
+// at pos.  enqueuers and dequeuers each race for their position with a CAS and
+// never touch each other's position in the common case.
+typedef struct {
+    size_t    sequence;
+    QueueItem item;
+} RingCell;
+
+#define CACHE_LINE_ 64
+
+typedef struct {
+    size_t enqueuePos;
+    char   enqueuePad[CACHE_LINE_ - sizeof(size_t)];
+    size_t dequeuePos;
+    char   dequeuePad[CACHE_LINE_ - sizeof(size_t)];
+    // workers wait on this, producers only read its waiters
+    EventCount notEmpty;
+    char       notEmptyPad[CACHE_LINE_ - sizeof(EventCount)];
+    EventCount notFull;
+    char       notFullPad[CACHE_LINE_ - sizeof(EventCount)];
+
+    size_t    mask;
+    RingCell* cells;
+} Ring;
+
+// how many times to try before waiting
+#define RING_SPINS_ 16
+
+static Ring* ring_create_(size_t const capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+        size *= 2;
+    }
+    Ring* out  = (Ring*)calloc(1, sizeof(Ring));
+    out->mask  = size - 1;
+    out->cells = (RingCell*)calloc(size, sizeof(RingCell));
+    for (size_t i = 0; i < size; ++i) {
+        out->cells[i].sequence = i;
+    }
+    return out;
+}
+
+static void ring_destroy_(Ring* const r) {
+    free(r->cells);
+    free(r);
+}
+
+static bool ring_try_enqueue_(Ring* const r, QueueItem const item) {
+    size_t    pos  = __atomic_load_n(&r->enqueuePos, __ATOMIC_RELAXED);
+    RingCell* cell = NULL;
+    for (;;) {
+        cell = r->cells + (pos & r->mask);
+        size_t const seq =
+            __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        intptr_t const diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&r->enqueuePos,
+                                            &pos,
+                                            pos + 1,
+                                            true,
+                                            __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // the dequeue a lap ago hasn't happened, full
+            return false;
+        } else {
+            pos = __atomic_load_n(&r->enqueuePos, __ATOMIC_RELAXED);
+        }
+    }
+    cell->item = item;
+    __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+// enqueue n items in consecutive positions or none.  the positions are taken
+// in one go once the dequeuers have claimed everything a lap before them, the
+// cells are written when those dequeuers are done with them.
+static bool ring_try_enqueue_n_(Ring* const            r,
+                                QueueItem const* const items,
+                                size_t const           n) {
+    size_t const capacity = r->mask + 1;
+    size_t       pos      = __atomic_load_n(&r->enqueuePos, __ATOMIC_RELAXED);
+    for (;;) {
+        size_t const dequeuePos =
+            __atomic_load_n(&r->dequeuePos, __ATOMIC_ACQUIRE);
+        intptr_t const used = (intptr_t)(pos - dequeuePos);
+        if (used < 0) {
+            // pos is stale, the dequeuers have passed it
+            pos = __atomic_load_n(&r->enqueuePos, __ATOMIC_RELAXED);
+            continue;
+        }
+        if ((size_t)used + n > capacity) {
+            return false;
+        }
+        if (__atomic_compare_exchange_n(&r->enqueuePos,
+                                        &pos,
+                                        pos + n,
+                                        true,
+                                        __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        RingCell* const cell = r->cells + ((pos + i) & r->mask);
+        while (__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) != pos + i) {
+            // claimed, still being read
+            sched_yield();
+        }
+        cell->item = items[i];
+        __atomic_store_n(&cell->sequence, pos + i + 1, __ATOMIC_RELEASE);
+    }
+    return true;
+}
+
+static bool ring_try_dequeue_(Ring* const r, QueueItem* const out) {
+    size_t    pos  = __atomic_load_n(&r->dequeuePos, __ATOMIC_RELAXED);
+    RingCell* cell = NULL;
+    for (;;) {
+        cell = r->cells + (pos & r->mask);
+        size_t const seq =
+            __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        intptr_t const diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&r->dequeuePos,
+                                            &pos,
+                                            pos + 1,
+                                            true,
+                                            __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // not enqueued yet, empty
+            return false;
+        } else {
+            pos = __atomic_load_n(&r->dequeuePos, __ATOMIC_RELAXED);
+        }
+    }
+    *out = cell->item;
+    // free for the enqueue a lap later
+    __atomic_store_n(&cell->sequence, pos + r->mask + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+// how many of available items to take so that shares takers get about the same
+// number, no more than max and at least 1
+static size_t share_of_(size_t const available,
+                        size_t const max,
+                        size_t const shares) {
+    size_t const share = (available + shares - 1) / shares;
+    return share > max ? max : share == 0 ? 1 : share;
+}
+
+// dequeue consecutive positions in one go, up to max of the available items and
+// about a shares'th of them.  0 if it's empty.  ring_try_enqueue_n_'s other
+// half: the cells are read when their enqueuers are done with them.
+static size_t ring_try_dequeue_n_(Ring* const      r,
+                                  QueueItem* const out,
+                                  size_t const     max,
+                                  size_t const     shares) {
+    size_t pos = __atomic_load_n(&r->dequeuePos, __ATOMIC_RELAXED);
+    size_t n   = 0;
+    for (;;) {
+        size_t const enqueuePos =
+            __atomic_load_n(&r->enqueuePos, __ATOMIC_ACQUIRE);
+        intptr_t const available = (intptr_t)(enqueuePos - pos);
+        if (available <= 0) {
+            return 0;
+        }
+        n = share_of_((size_t)available, max, shares);
+        if (__atomic_compare_exchange_n(&r->dequeuePos,
+                                        &pos,
+                                        pos + n,
+                                        true,
+                                        __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        RingCell* const cell = r->cells + ((pos + i) & r->mask);
+        while (__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) !=
+               pos + i + 1) {
+            // claimed, still being written
+            sched_yield();
+        }
+        out[i] = cell->item;
+        __atomic_store_n(
+            &cell->sequence, pos + i + r->mask + 1, __ATOMIC_RELEASE);
+    }
+    return n;
+}
+
+static bool ring_try_put_(Ring* const            r,
+                          QueueItem const* const items,
+                          size_t const           n) {
+    return n == 1 ? ring_try_enqueue_(r, items[0])
+                  : ring_try_enqueue_n_(r, items, n);
+}
+
+static void ring_enqueue_n_(Ring* const r, QueueItem* items, size_t n) {
+    size_t const capacity = r->mask + 1;
+    while (n > 0) {
+        // more than fits can't go in in one go
+        size_t const batch = n < capacity ? n : capacity;
+        while (!ring_try_put_(r, items, batch)) {
+            uint32_t const key = ec_prepare_wait_(&r->notFull);
+            if (ring_try_put_(r, items, batch)) {
+                ec_cancel_wait_(&r->notFull);
+                break;
+            }
+            ec_wait_(&r->notFull, key, NULL);
+        }
+        ec_notify_(&r->notEmpty, batch > 1);
+        items += batch;
+        n -= batch;
+    }
+}
+
+// wake a producer once it's down to half full, not for every cell, so they
+// aren't woken to put in one each.  the dequeues keep going till then, it isn't
+// empty, and each wakes another producer after that.
+static void ring_notify_not_full_(Ring* const r) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    uint64_t const state = __atomic_load_n(&r->notFull.state, __ATOMIC_RELAXED);
+    if (EC_WOKEN_(state) >= EC_WAITERS_(state)) {
+        return;
+    }
+    size_t const used = __atomic_load_n(&r->enqueuePos, __ATOMIC_RELAXED) -
+                        __atomic_load_n(&r->dequeuePos, __ATOMIC_RELAXED);
+    if (used <= (r->mask + 1) / 2) {
+        ec_notify_(&r->notFull, false);
+    }
+}
+
+static size_t ring_try_take_(Ring* const      r,
+                             QueueItem* const out,
+                             size_t const     max,
+                             size_t const     shares) {
+    return max == 1 ? ring_try_dequeue_(r, out)
+                    : ring_try_dequeue_n_(r, out, max, shares);
+}
+
+// block for at least one item, then ring_try_dequeue_n_.  0 if deadline, if
+// it isn't NULL, passes first.
+static size_t ring_dequeue_n_(Ring* const                  r,
+                              QueueItem* const             out,
+                              size_t const                 max,
+                              size_t const                 shares,
+                              struct timespec const* const deadline) {
+    size_t n = 0;
+    for (size_t spins = 0;; ++spins) {
+        if ((n = ring_try_take_(r, out, max, shares)) > 0) {
+            break;
+        }
+        if (spins < RING_SPINS_) {
+            continue;
+        }
+        // only park when it's empty
+        uint32_t const key = ec_prepare_wait_(&r->notEmpty);
+        if ((n = ring_try_take_(r, out, max, shares)) > 0) {
+            ec_cancel_wait_(&r->notEmpty);
+            break;
+        }
+        if (!deadline) {
+            ec_wait_(&r->notEmpty, key, NULL);
+            continue;
+        }
+        struct timespec const now  = now_();
+        int64_t const         left = ns_between_(&now, deadline);
+        if (left <= 0) {
+            ec_cancel_wait_(&r->notEmpty);
+            return 0;
+        }
+        struct timespec const timeout = {(time_t)(left / NS_PER_S_),
+                                         (long)(left % NS_PER_S_)};
+        ec_wait_(&r->notEmpty, key, &timeout);
+    }
+    ring_notify_not_full_(r);
+    return n;
+}
+
+static bool ring_empty_(Ring const* const r) {
+    return __atomic_load_n(&r->dequeuePos, __ATOMIC_ACQUIRE) ==
+           __atomic_load_n(&r->enqueuePos, __ATOMIC_ACQUIRE);
+}
+
+// either the steque behind the mutex or, if there is one, the ring
 struct QueueTag {
     steque_t        base;
     pthread_mutex_t mutex;
     pthread_cond_t  notEmpty;
+    // base's nodes once they're dequeued, for the next enqueues.  they're
+    // only freed with the queue so once it's been as long as it gets, enqueuing
+    // and dequeuing don't go near malloc and its locks.
+    steque_node_t* freeNodes;
+
+    Ring* ring;
 };
 
+// steque_enqueue, with a free node if there is one
+static void queue_push_(Queue* const q, QueueItem const item) {
+    steque_node_t* node = q->freeNodes;
+    if (node) {
+        q->freeNodes = node->next;
+    } else {
+        node = (steque_node_t*)malloc(sizeof(steque_node_t));
+    }
+    node->item = item;
+    node->next = NULL;
+    if (q->base.back) {
+        q->base.back->next = node;
+    } else {
+        q->base.front = node;
+    }
+    q->base.back = node;
+    ++q->base.N;
+}
+
+// steque_pop, keeping the node
+static QueueItem queue_pop_(Queue* const q) {
+    steque_node_t* const node = q->base.front;
+    q->base.front             = node->next;
+    if (!q->base.front) {
+        q->base.back = NULL;
+    }
+    --q->base.N;
+    node->next   = q->freeNodes;
+    q->freeNodes = node;
+    return node->item;
+}
+
 Queue* queue_create() {
     Queue* out = (Queue*)calloc(1, sizeof(Queue));
     steque_init(&out->base);
     pthread_mutex_init(&out->mutex, NULL);
-    pthread_cond_init(&out->notEmpty, NULL);
+    pthread_condattr_t notEmptyAttr;
+    pthread_condattr_init(&notEmptyAttr);
+    pthread_condattr_setclock(&notEmptyAttr, CLOCK_MONOTONIC);
+    pthread_cond_init(&out->notEmpty, &notEmptyAttr);
+    pthread_condattr_destroy(&notEmptyAttr);
+    return out;
+}
+
+Queue* queue_create_ring(size_t const capacity) {
+    Queue* out = queue_create();
+    out->ring  = ring_create_(capacity);
     return out;
 }
 
@@ -36,9 +516,13 @@ void queue_enqueue_n(Queue* const q, QueueItem* const items, size_t const n) {
     if (n == 0) {
         return;
     }
+    if (q->ring) {
+        ring_enqueue_n_(q->ring, items, n);
+        return;
+    }
     pthread_mutex_lock(&q->mutex);
     for (size_t i = 0; i < n; ++i) {
-        steque_enqueue(&q->base, items[i]);
+        queue_push_(q, items[i]);
     }
     pthread_mutex_unlock(&q->mutex);
     if (n == 1) {
@@ -52,17 +536,70 @@ void queue_enqueue(Queue* const q, QueueItem item) {
     queue_enqueue_n(q, &item, 1);
 }
 
-QueueItem queue_dequeue(Queue* q) {
+// queue_dequeue_n, but only about a shares'th of what's there so that as many
+// takers each get some.  0 if deadline, if it isn't NULL, passes first.
+static size_t queue_dequeue_share_(Queue* const                 q,
+                                   QueueItem* const             out,
+                                   size_t const                 max,
+                                   size_t const                 shares,
+                                   struct timespec const* const deadline) {
+    assert(max > 0);
+    if (q->ring) {
+        return ring_dequeue_n_(q->ring, out, max, shares, deadline);
+    }
     pthread_mutex_lock(&q->mutex);
     while (steque_isempty(&q->base)) {
-        pthread_cond_wait(&q->notEmpty, &q->mutex);
+        if (!deadline) {
+            pthread_cond_wait(&q->notEmpty, &q->mutex);
+        } else if (pthread_cond_timedwait(
+                       &q->notEmpty, &q->mutex, deadline) == ETIMEDOUT &&
+                   steque_isempty(&q->base)) {
+            pthread_mutex_unlock(&q->mutex);
+            return 0;
+        }
     }
-    QueueItem const out = steque_pop(&q->base);
+    size_t const n =
+        share_of_((size_t)steque_size(&q->base), max, shares);
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = queue_pop_(q);
+    }
+    bool const more = !steque_isempty(&q->base);
     pthread_mutex_unlock(&q->mutex);
+    if (more && n > 1) {
+        // somebody woken for what this took can have the rest
+        pthread_cond_signal(&q->notEmpty);
+    }
+    return n;
+}
+
+size_t queue_dequeue_n(Queue* const q, QueueItem* const out, size_t const max) {
+    return queue_dequeue_share_(q, out, max, 1, NULL);
+}
+
+QueueItem queue_dequeue(Queue* q) {
+    QueueItem out = NULL;
+    queue_dequeue_share_(q, &out, 1, 1, NULL);
     return out;
 }
 
+// queue_dequeue without the waiting, false if it's empty
+static bool queue_try_dequeue_(Queue* const q, QueueItem* const out) {
+    if (q->ring) {
+        return ring_try_dequeue_(q->ring, out);
+    }
+    pthread_mutex_lock(&q->mutex);
+    bool const found = !steque_isempty(&q->base);
+    if (found) {
+        *out = queue_pop_(q);
+    }
+    pthread_mutex_unlock(&q->mutex);
+    return found;
+}
+
 bool queue_empty(Queue const* q) {
+    if (q->ring) {
+        return ring_empty_(q->ring);
+    }
     pthread_mutex_lock((pthread_mutex_t*)&q->mutex);
     bool const out = steque_isempty((steque_t*)&q->base);
     pthread_mutex_unlock((pthread_mutex_t*)&q->mutex);
@@ -70,8 +607,16 @@ bool queue_empty(Queue const* q) {
 }
 
 void queue_destroy(Queue* q) {
+    if (q->ring) {
+        ring_destroy_(q->ring);
+    }
     pthread_mutex_lock(&q->mutex);
     steque_destroy(&q->base);
+    while (q->freeNodes) {
+        steque_node_t* const node = q->freeNodes;
+        q->freeNodes              = node->next;
+        free(node);
+    }
     pthread_cond_destroy(&q->notEmpty);
     pthread_mutex_unlock(&q->mutex);
     pthread_mutex_destroy(&q->mutex);
@@ -82,10 +627,95 @@ void queue_destroy(Queue* q) {
 // Worker Pool
 /////////////////////////////////////////////////////////////
 
+// a Chase-Lev deque.  the owner pushes and takes at the bottom, everybody else
+// steals from the top.  it's a fixed size, the owner puts what doesn't fit in
+// the pool's queue.
+#define WP_DEQUE_SIZE_ 1024
+
+typedef struct {
+    intptr_t top;
+    char     topPad[CACHE_LINE_ - sizeof(intptr_t)];
+    intptr_t bottom;
+    char     bottomPad[CACHE_LINE_ - sizeof(intptr_t)];
+    WpTask   tasks[WP_DEQUE_SIZE_];
+} WpDeque;
+
+static WpTask* deque_slot_(WpDeque* const d, intptr_t const i) {
+    return d->tasks + (i & (WP_DEQUE_SIZE_ - 1));
+}
+
+// the owner's, false if it's full
+static bool deque_push_(WpDeque* const d, WpTask const task) {
+    intptr_t const b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED);
+    intptr_t const t = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+    if (b - t >= WP_DEQUE_SIZE_) {
+        return false;
+    }
+    __atomic_store_n(deque_slot_(d, b), task, __ATOMIC_RELAXED);
+    __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+// the owner's, the newest task.  false if it's empty.
+static bool deque_take_(WpDeque* const d, WpTask* const out) {
+    intptr_t const b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED) - 1;
+    __atomic_store_n(&d->bottom, b, __ATOMIC_RELAXED);
+    // the thieves have to see bottom's gone down before we look at top
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    intptr_t t = __atomic_load_n(&d->top, __ATOMIC_RELAXED);
+    if (t > b) {
+        __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+        return false;
+    }
+    *out = __atomic_load_n(deque_slot_(d, b), __ATOMIC_RELAXED);
+    if (t < b) {
+        return true;
+    }
+    // the last one, race the thieves for it
+    bool const won = __atomic_compare_exchange_n(
+        &d->top, &t, t + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+    __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+    return won;
+}
+
+// anybody's, the oldest task.  1 if it got one, 0 if it's empty and -1 if
+// somebody else got there first.
+static int deque_steal_(WpDeque* const d, WpTask* const out) {
+    intptr_t t = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    intptr_t const b = __atomic_load_n(&d->bottom, __ATOMIC_ACQUIRE);
+    if (t >= b) {
+        return 0;
+    }
+    WpTask const task = __atomic_load_n(deque_slot_(d, t), __ATOMIC_RELAXED);
+    if (!__atomic_compare_exchange_n(
+            &d->top, &t, t + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+        return -1;
+    }
+    *out = task;
+    return 1;
+}
+
 typedef struct {
-    WpWork work;
-    void*  workerData;
-    Queue* queue;
+    WpWork      work;
+    WpWorkBatch workBatch;
+    void*       workerData;
+    Queue*      queue;
+    WorkerPool* pool;
+    size_t      index;
+
+    // WpOptions's maxBatch and room for that many tasks, when it's more than 1
+    // or the pool's elastic
+    size_t  maxBatch;
+    WpTask* batch;
+
+    // WpWorkStealing's
+    WpDeque* deque;
+
+    // it has its workerData and a thread to join.  for an elastic pool it
+    // might not be running, then its data's for the next worker started.
+    bool started;
+    bool running;
 } WpWorker;
 
 static void* const worker_pill_ = (void*)UINTPTR_MAX;
@@ -100,8 +730,20 @@ static void worker_init_(WpWorker*    worker,
     worker->queue      = queue;
 }
 
+static void worker_do_tasks_(WpWorker* const worker,
+                             WpTask* const   tasks,
+                             size_t const    numTasks) {
+    if (worker->workBatch) {
+        worker->workBatch(tasks, numTasks, worker->workerData);
+        return;
+    }
+    for (size_t i = 0; i < numTasks; ++i) {
+        worker->work(tasks[i], worker->workerData);
+    }
+}
+
 static void worker_do_task_(WpWorker* const worker, WpTask task) {
-    worker->work(task, worker->workerData);
+    worker_do_tasks_(worker, &task, 1);
 }
 
 static void* worker_work_(void* worker_) {
@@ -119,52 +761,401 @@ struct WorkerPoolTag {
 
     Queue*     queue;
     pthread_t* threads;
+
+    // WpWorkStealing's.  queue is the injector, for tasks from outside the
+    // pool and what doesn't fit in a deque.  injected counts what's in it so
+    // idle workers don't lock it to find it empty.
+    bool          stealing;
+    pthread_key_t self;
+    EventCount    idle;
+    size_t        injected;
+
+    // elastic's.  workers and threads have room for maxWorkers, numWorkers
+    // of them running.  elasticMutex is held to start or stop one, and for
+    // stats.  added and started count the tasks for the watcher.
+    bool               elastic;
+    size_t             maxWorkers;
+    size_t             minWorkers;
+    int64_t            waitTargetNs;
+    int64_t            idleTimeoutNs;
+    void*              (*workerMain)(void*);
+    WpCreateWorkerData createWorkerData;
+    void*              globalData;
+    pthread_mutex_t    elasticMutex;
+    pthread_cond_t     watcherWake;
+    pthread_t          watcher;
+    bool               finishing;
+    size_t             added;
+    size_t             started;
+    WpStats            stats;
 };
 
+// the next task for a work stealing worker: its own newest, the injector's
+// oldest or another worker's oldest, in that order.  false if there isn't
+// one.
+static bool worker_find_task_(WpWorker* const worker, WpTask* const out) {
+    WorkerPool* const wp = worker->pool;
+    if (deque_take_(worker->deque, out)) {
+        return true;
+    }
+    if (__atomic_load_n(&wp->injected, __ATOMIC_ACQUIRE) > 0 &&
+        queue_try_dequeue_(wp->queue, out)) {
+        __atomic_fetch_sub(&wp->injected, 1, __ATOMIC_RELAXED);
+        return true;
+    }
+    // starting after this worker, so they don't all go for the same one
+    for (size_t i = 1; i < wp->numWorkers; ++i) {
+        WpWorker* const victim =
+            wp->workers + (worker->index + i) % wp->numWorkers;
+        int stolen = 0;
+        while ((stolen = deque_steal_(victim->deque, out)) < 0) {
+        }
+        if (stolen) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void* worker_steal_work_(void* worker_) {
+    WpWorker* const   worker = (WpWorker*)worker_;
+    WorkerPool* const wp     = worker->pool;
+    pthread_setspecific(wp->self, worker);
+    for (;;) {
+        WpTask task = NULL;
+        if (!worker_find_task_(worker, &task)) {
+            // only sleep if there's still nothing after saying so
+            uint32_t const key = ec_prepare_wait_(&wp->idle);
+            if (!worker_find_task_(worker, &task)) {
+                ec_wait_(&wp->idle, key, NULL);
+                continue;
+            }
+            ec_cancel_wait_(&wp->idle);
+        }
+        if (task == worker_pill_) {
+            // the pills come last in the injector and the deque's empty
+            break;
+        }
+        worker_do_task_(worker, task);
+    }
+    return NULL;
+}
+
+// stop an elastic pool's worker that's been idle, unless it's down to the
+// least it can have or it's finishing.  true if it's stopped.
+static bool worker_retire_(WpWorker* const worker) {
+    WorkerPool* const wp = worker->pool;
+    pthread_mutex_lock(&wp->elasticMutex);
+    bool const retire = !wp->finishing && wp->numWorkers > wp->minWorkers;
+    if (retire) {
+        worker->running = false;
+        __atomic_store_n(&wp->numWorkers, wp->numWorkers - 1, __ATOMIC_RELAXED);
+        ++wp->stats.retired;
+    }
+    pthread_mutex_unlock(&wp->elasticMutex);
+    return retire;
+}
+
+// worker_work_ a batch at a time.  it takes its share of what's queued, so
+// while there's little each worker still gets some and when there's a lot it
+// takes the lock less often.  an elastic pool's workers work this way, with a
+// batch of 1 if need be, so they can give up waiting.
+static void* worker_work_batches_(void* worker_) {
+    WpWorker* const   worker = (WpWorker*)worker_;
+    WorkerPool* const wp     = worker->pool;
+    WpTask* const     tasks  = worker->batch;
+    for (;;) {
+        struct timespec deadline;
+        if (wp->elastic) {
+            deadline = add_ns_(now_(), wp->idleTimeoutNs);
+        }
+        size_t const n = queue_dequeue_share_(
+            worker->queue,
+            tasks,
+            worker->maxBatch,
+            __atomic_load_n(&wp->numWorkers, __ATOMIC_RELAXED),
+            wp->elastic ? &deadline : NULL);
+        if (n == 0) {
+            // idle for idleTimeoutNs
+            if (worker_retire_(worker)) {
+                break;
+            }
+            continue;
+        }
+        if (wp->elastic) {
+            __atomic_fetch_add(&wp->started, n, __ATOMIC_RELEASE);
+        }
+        size_t numTasks = 0;
+        while (numTasks < n && tasks[numTasks] != worker_pill_) {
+            ++numTasks;
+        }
+        if (numTasks > 0) {
+            worker_do_tasks_(worker, tasks, numTasks);
+        }
+        if (numTasks < n) {
+            // the pills come last, the others are for the other workers
+            queue_enqueue_n(
+                worker->queue, tasks + numTasks + 1, n - numTasks - 1);
+            break;
+        }
+    }
+    return NULL;
+}
+
+// the default for WpOptions's ringCapacity
+#define WP_RING_CAPACITY_ 4096
+
+static Queue* wp_create_queue_(WpOptions const* const options) {
+    if (!options || options->queueKind != WpRingQueue) {
+        return queue_create();
+    }
+    return queue_create_ring(options->ringCapacity ? options->ringCapacity
+                                                   : WP_RING_CAPACITY_);
+}
+
 WorkerPool* wp_start(size_t const       numWorkers,
                      WpWork             work,
                      WpCreateWorkerData createWorkerData,
                      void* const        globalData) {
+    return wp_start_with(NULL, numWorkers, work, createWorkerData, globalData);
+}
+
+// the defaults for WpOptions's queueWaitTargetUs and idleTimeoutUs
+#define WP_WAIT_TARGET_US_  10000
+#define WP_IDLE_TIMEOUT_US_ 1000000
+
+// start worker's thread.  the first time it creates its data, after that it
+// joins the thread that stopped.  an elastic pool's elasticMutex is held.
+static void wp_start_worker_(WorkerPool* const wp, WpWorker* const worker) {
+    if (worker->started) {
+        pthread_join(wp->threads[worker->index], NULL);
+    } else if (wp->createWorkerData) {
+        worker->workerData = wp->createWorkerData(wp->globalData);
+    }
+    worker->started = true;
+    worker->running = true;
+    pthread_create(
+        wp->threads + worker->index, NULL, wp->workerMain, worker);
+}
+
+// an elastic pool's.  every queueWaitTarget it works out how long the queued
+// tasks can expect to wait, Little's law with how many were started since the
+// last time, and starts another worker if it's too long.
+static void* wp_watch_(void* wp_) {
+    WorkerPool* const wp          = (WorkerPool*)wp_;
+    struct timespec   last        = now_();
+    size_t            lastStarted = 0;
+    size_t            lastQueued  = 0;
+    // how long there have been tasks queued and none started, since the
+    // first time it looked.  they might have only just been added then.
+    int64_t stalled = 0;
+    pthread_mutex_lock(&wp->elasticMutex);
+    for (;;) {
+        struct timespec const wake = add_ns_(last, wp->waitTargetNs);
+        pthread_cond_timedwait(&wp->watcherWake, &wp->elasticMutex, &wake);
+        if (wp->finishing) {
+            break;
+        }
+        struct timespec const now     = now_();
+        int64_t const         elapsed = ns_between_(&last, &now);
+        if (elapsed < wp->waitTargetNs) {
+            continue;
+        }
+        // started first, everything started has been added
+        size_t const started = __atomic_load_n(&wp->started, __ATOMIC_ACQUIRE);
+        size_t const queued =
+            __atomic_load_n(&wp->added, __ATOMIC_RELAXED) - started;
+        size_t const departed = started - lastStarted;
+        int64_t      wait     = 0;
+        if (queued > 0 && departed > 0) {
+            stalled = 0;
+            wait    = (int64_t)((double)queued * elapsed / departed);
+        } else if (queued > 0) {
+            stalled = lastQueued > 0 ? stalled + elapsed : 0;
+            wait    = stalled;
+        } else {
+            stalled = 0;
+        }
+        wp->stats.queued      = queued;
+        wp->stats.queueWaitUs = (size_t)(wait / 1000);
+        if (wait > wp->waitTargetNs && wp->numWorkers < wp->maxWorkers) {
+            WpWorker* worker = wp->workers;
+            while (worker->running) {
+                ++worker;
+            }
+            wp_start_worker_(wp, worker);
+            __atomic_store_n(
+                &wp->numWorkers, wp->numWorkers + 1, __ATOMIC_RELAXED);
+            ++wp->stats.spawned;
+        }
+        last        = now;
+        lastStarted = started;
+        lastQueued  = queued;
+    }
+    pthread_mutex_unlock(&wp->elasticMutex);
+    return NULL;
+}
+
+WorkerPool* wp_start_with(WpOptions const* const options,
+                          size_t const           numWorkers,
+                          WpWork                 work,
+                          WpCreateWorkerData     createWorkerData,
+                          void* const            globalData) {
     assert(numWorkers > 0);
     WorkerPool* out = (WorkerPool*)calloc(1, sizeof(WorkerPool));
     out->numWorkers = numWorkers;
-    out->workers    = (WpWorker*)calloc(out->numWorkers, sizeof(WpWorker));
-    out->queue      = queue_create();
-    out->threads    = (pthread_t*)calloc(out->numWorkers, sizeof(pthread_t));
-    for (size_t i = 0; i < out->numWorkers; ++i) {
-        void* const workerData =
-            createWorkerData ? createWorkerData(globalData) : NULL;
-        worker_init_(out->workers + i, work, workerData, out->queue);
-        pthread_create(out->threads + i, NULL, worker_work_, out->workers + i);
+    out->stealing   = options && options->queueKind == WpWorkStealing;
+    out->elastic =
+        options && !out->stealing && options->maxWorkers > numWorkers;
+    out->minWorkers       = numWorkers;
+    out->maxWorkers       = out->elastic ? options->maxWorkers : numWorkers;
+    out->createWorkerData = createWorkerData;
+    out->globalData       = globalData;
+    out->workers = (WpWorker*)calloc(out->maxWorkers, sizeof(WpWorker));
+    out->queue   = wp_create_queue_(options);
+    out->threads = (pthread_t*)calloc(out->maxWorkers, sizeof(pthread_t));
+    if (out->stealing) {
+        pthread_key_create(&out->self, NULL);
+    }
+    size_t maxBatch = options && !out->stealing ? options->maxBatch : 1;
+    if (out->elastic && maxBatch == 0) {
+        maxBatch = 1;
+    }
+    for (size_t i = 0; i < out->maxWorkers; ++i) {
+        WpWorker* const worker = out->workers + i;
+        worker_init_(worker, work, NULL, out->queue);
+        worker->workBatch = options ? options->workBatch : NULL;
+        worker->pool      = out;
+        worker->index     = i;
+        if (maxBatch > 1 || out->elastic) {
+            worker->maxBatch = maxBatch;
+            worker->batch    = (WpTask*)calloc(maxBatch, sizeof(WpTask));
+        }
+        if (out->stealing) {
+            worker->deque = (WpDeque*)calloc(1, sizeof(WpDeque));
+        }
+    }
+    out->workerMain = out->stealing          ? worker_steal_work_
+                      : out->workers[0].batch ? worker_work_batches_
+                                              : worker_work_;
+    if (out->elastic) {
+        out->waitTargetNs = (int64_t)(options->queueWaitTargetUs
+                                          ? options->queueWaitTargetUs
+                                          : WP_WAIT_TARGET_US_) *
+                            1000;
+        out->idleTimeoutNs = (int64_t)(options->idleTimeoutUs
+                                           ? options->idleTimeoutUs
+                                           : WP_IDLE_TIMEOUT_US_) *
+                             1000;
+        pthread_mutex_init(&out->elasticMutex, NULL);
+        pthread_condattr_t watcherWakeAttr;
+        pthread_condattr_init(&watcherWakeAttr);
+        pthread_condattr_setclock(&watcherWakeAttr, CLOCK_MONOTONIC);
+        pthread_cond_init(&out->watcherWake, &watcherWakeAttr);
+        pthread_condattr_destroy(&watcherWakeAttr);
+    }
+    // the thieves look at every worker's deque
+    for (size_t i = 0; i < numWorkers; ++i) {
+        wp_start_worker_(out, out->workers + i);
+    }
+    if (out->elastic) {
+        pthread_create(&out->watcher, NULL, wp_watch_, out);
     }
     return out;
 }
 
+// the worker running on this thread if it's one of wp's
+static WpWorker* wp_self_(WorkerPool* const wp) {
+    return wp->stealing ? (WpWorker*)pthread_getspecific(wp->self) : NULL;
+}
+
+static void wp_push_local_(WorkerPool* const wp,
+                           WpWorker* const   self,
+                           WpTask const      task) {
+    if (!deque_push_(self->deque, task)) {
+        // full, the rest of the pool can have it
+        __atomic_fetch_add(&wp->injected, 1, __ATOMIC_SEQ_CST);
+        queue_enqueue(wp->queue, task);
+    }
+    ec_notify_(&wp->idle, false);
+}
+
 void wp_add_tasks(WorkerPool* const wp,
                   WpTask* const     tasks,
                   size_t const      numTasks) {
+    WpWorker* const self = wp_self_(wp);
+    if (self) {
+        for (size_t i = 0; i < numTasks; ++i) {
+            wp_push_local_(wp, self, tasks[i]);
+        }
+        return;
+    }
+    if (wp->stealing) {
+        // counted first so it's never less than what's there
+        __atomic_fetch_add(&wp->injected, numTasks, __ATOMIC_SEQ_CST);
+    }
+    if (wp->elastic) {
+        __atomic_fetch_add(&wp->added, numTasks, __ATOMIC_RELAXED);
+    }
     queue_enqueue_n(wp->queue, tasks, numTasks);
+    if (wp->stealing) {
+        ec_notify_(&wp->idle, numTasks > 1);
+    }
 }
 
-void wp_add_task(WorkerPool* const wp, WpTask const task) {
-    queue_enqueue(wp->queue, task);
+void wp_add_task(WorkerPool* const wp, WpTask task) {
+    wp_add_tasks(wp, &task, 1);
+}
+
+void wp_stats(WorkerPool* const wp, WpStats* const out) {
+    memset(out, 0, sizeof(WpStats));
+    if (!wp->elastic) {
+        out->numWorkers = wp->numWorkers;
+        return;
+    }
+    pthread_mutex_lock(&wp->elasticMutex);
+    *out            = wp->stats;
+    out->numWorkers = wp->numWorkers;
+    pthread_mutex_unlock(&wp->elasticMutex);
 }
 
 void wp_finish(WorkerPool* const   wp,
                WpDestroyWorkerData destroyWorkerData,
                void*               globalData) {
+    if (wp->elastic) {
+        // no more starting or stopping, numWorkers is what it is
+        pthread_mutex_lock(&wp->elasticMutex);
+        wp->finishing = true;
+        pthread_cond_signal(&wp->watcherWake);
+        pthread_mutex_unlock(&wp->elasticMutex);
+        pthread_join(wp->watcher, NULL);
+    }
     WpTask* pills = (WpTask*)calloc(wp->numWorkers, sizeof(WpTask));
     for (size_t i = 0; i < wp->numWorkers; ++i) {
         pills[i] = worker_pill_;
     }
     wp_add_tasks(wp, pills, wp->numWorkers);
     free(pills);
-    for (size_t i = 0; i < wp->numWorkers; ++i) {
+    for (size_t i = 0; i < wp->maxWorkers; ++i) {
+        if (!wp->workers[i].started) {
+            continue;
+        }
         pthread_join(wp->threads[i], NULL);
         if (destroyWorkerData) {
             destroyWorkerData(wp->workers[i].workerData, globalData);
         }
     }
+    for (size_t i = 0; i < wp->maxWorkers; ++i) {
+        free(wp->workers[i].batch);
+        free(wp->workers[i].deque);
+    }
+    if (wp->stealing) {
+        pthread_key_delete(wp->self);
+    }
+    if (wp->elastic) {
+        pthread_cond_destroy(&wp->watcherWake);
+        pthread_mutex_destroy(&wp->elasticMutex);
+    }
     free(wp->threads);
     free(wp->workers);
     queue_destroy(wp->queue);
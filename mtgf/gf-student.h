@@ -17,9 +17,16 @@ extern "C" {
 typedef struct QueueTag Queue;
 typedef void*           QueueItem;
 
-// create a concurrent queue
+// create a concurrent queue.  it only allocates when it's longer than it's
+// been before.
 Queue* queue_create();
 
+// create a bounded, lock free concurrent queue, a ring of capacity items
+// (rounded up to a power of 2).  enqueuing blocks while it's full.  the other
+// queue_ functions work as they do for queue_create's queue, except that a
+// queue_enqueue_n of more than capacity items isn't atomic.
+Queue* queue_create_ring(size_t capacity);
+
 // atomically push many values onto the queue
 void queue_enqueue_n(Queue*, QueueItem*, size_t numItems);
 
@@ -30,6 +37,10 @@ void queue_enqueue(Queue*, QueueItem);
 // earliest inserted item.
 QueueItem queue_dequeue(Queue*);
 
+// block until an item is available on the queue.  remove up to max of the
+// earliest inserted items into out, in order, and return how many.
+size_t queue_dequeue_n(Queue*, QueueItem* out, size_t max);
+
 // return true if empty
 bool queue_empty(Queue const*);
 
@@ -47,26 +58,93 @@ typedef void*                WpTask;
 typedef void* (*WpCreateWorkerData)(void* globalData);
 typedef void (*WpDestroyWorkerData)(void* workerData, void* globalData);
 typedef void (*WpWork)(WpTask, void* workerData);
+// work on numTasks tasks taken together, see WpOptions
+typedef void (*WpWorkBatch)(WpTask* tasks, size_t numTasks, void* workerData);
+
+// the queue the workers take their tasks from
+typedef enum {
+    // queue_create's, unbounded
+    WpMutexQueue,
+    // queue_create_ring's.  wp_add_task blocks while it's full.
+    WpRingQueue,
+    // a deque for each worker, the others steal from it when they run out.
+    // see wp_add_task.
+    WpWorkStealing,
+} WpQueueKind;
+
+typedef struct {
+    WpQueueKind queueKind;
+    // the capacity of a WpRingQueue, 0 for a default
+    size_t ringCapacity;
+    // take up to this many tasks from the queue at once, fewer when there
+    // aren't that many for each worker.  0 or 1 is one at a time.
+    // WpWorkStealing's workers always take one.
+    size_t maxBatch;
+    // if not NULL, the workers give it the tasks they take together instead of
+    // calling work with each
+    WpWorkBatch workBatch;
+
+    // elastic when it's more than numWorkers, which is then the least there
+    // are.  another worker starts, up to maxWorkers, while tasks wait longer
+    // than queueWaitTargetUs to be started, and workers that have been idle
+    // for idleTimeoutUs stop.  not for WpWorkStealing.
+    size_t maxWorkers;
+    // microseconds, 0 for defaults
+    unsigned queueWaitTargetUs;
+    unsigned idleTimeoutUs;
+} WpOptions;
+
+// what an elastic pool goes by and what it's done about it.  see wp_stats.
+typedef struct {
+    // running now
+    size_t numWorkers;
+    // added but not started yet
+    size_t queued;
+    // how long the queued tasks are expected to wait, queued over how fast
+    // they've been started lately
+    size_t queueWaitUs;
+    // workers started and stopped since wp_start_with, not counting the
+    // first numWorkers
+    size_t spawned;
+    size_t retired;
+} WpStats;
 
 // Start a WorkerPool thread pool with numWorkers.
 // work is the function to apply to each task.  when the Worker Pool is ready,
 // it will invoke work on a task.
 //
 // Each worker can have its own local data.  This is created with
-// createWorkerData and is invoked once, sequentially, for each worker.
+// createWorkerData and is invoked once, sequentially, for each worker.  An
+// elastic pool keeps a stopped worker's data for the next one it starts.
 WorkerPool* wp_start(size_t             numWorkers,
                      WpWork             work,
                      WpCreateWorkerData createWorkerData,
                      void*              globalData);
 
+// wp_start with options.  NULL options are the defaults, what wp_start uses.
+WorkerPool* wp_start_with(WpOptions const*   options,
+                          size_t             numWorkers,
+                          WpWork             work,
+                          WpCreateWorkerData createWorkerData,
+                          void*              globalData);
+
 // Atomically added numTasks to the set of tasks to be done.  Tasks will be
 // *started* in the order in which they were added.
 void wp_add_tasks(WorkerPool* wp, WpTask* tasks, size_t numTasks);
 
 // Add one task to the set of tasks to be done.  Tasks will be
 // *started* in the order in which they were added.
+//
+// With WpWorkStealing that's only true of tasks added from outside the pool.
+// A task its own workers add goes on the adding worker's deque.  The worker
+// starts its newest task first, after its current one, and idle workers steal
+// the oldest.
 void wp_add_task(WorkerPool* wp, WpTask);
 
+// The numbers for an elastic pool, as of the last time it checked them.  A
+// fixed pool only has numWorkers.
+void wp_stats(WorkerPool*, WpStats* out);
+
 // Finish processing all tasks and, destroy worker data with destroyWorkerData
 // (sequentailly) and destroy the WorkerPool
 void wp_finish(WorkerPool*,
@@ -5,6 +5,9 @@
 #ifndef __GF_CLIENT_STUDENT_H__
 #define __GF_CLIENT_STUDENT_H__
 
+#include "gf-student-gflib.h"
+#include "gfclient.h"
+
 #include <sys/types.h>
 
 #include <stddef.h>
@@ -13,6 +16,14 @@
 extern "C" {
 #endif
 
+/////////////////////////////////////////////////////////////
+// GETFILE Client
+/////////////////////////////////////////////////////////////
+
+// speak protocol to the server (see GfProtocol in gf-student-gflib.h).
+// GfTextProtocol, GETFILE, by default.
+void gfc_set_protocol(gfcrequest_t** gfr, GfProtocol protocol);
+
 /////////////////////////////////////////////////////////////
 // Multi Threaded Client
 /////////////////////////////////////////////////////////////
@@ -30,6 +41,10 @@ typedef void (*ReportFcn)(void*,
 // receives to sink. (See sink below).
 //
 // To ask for a file, call mtc_process.  And when done, call mtc_finish.
+//
+// the production build of gfclient_download.c binds the client to the file sink
+// at compile time (see GF_STATIC_DISPATCH there), so the sink must come from
+// fsink_init.
 MultiThreadedClient* mtc_start(char const*    server,
                                unsigned short port,
                                size_t         numThreads,
@@ -2,7 +2,7 @@
 #define _DEFAULT_SOURCE
 #define _POSIX_C_SOURCE 200112L
 
-#include "gfclient.h"
+#include "gfclient-student.h"
 
 #include "gf-student-gflib.h"
 
@@ -34,6 +34,8 @@ struct gfcrequest_t {
     WriteFcn writeFcn;
     void*    writeFcnArg;
 
+    GfProtocol protocol;
+
     // internal state
     // the final status after perform_
     gfstatus_t status;
@@ -91,6 +93,10 @@ void gfc_set_writefunc(gfcrequest_t** gfc, WriteFcn writeFcn) {
     (*gfc)->writeFcn = writeFcn;
 }
 
+void gfc_set_protocol(gfcrequest_t** gfc, GfProtocol protocol) {
+    (*gfc)->protocol = protocol;
+}
+
 // Wrapper around getaddrinfo.  Resolve addrinfo struct for serverName and port
 // using getaddrinfo mainly to support IPv4 and IPv6 plus other functions are
 // deprecated.
@@ -136,10 +142,19 @@ static int create_and_connect_to_socket_(
 // send the request for path to the server on socketId.  Takes a scratch buffer
 // to avoid a bunch of buffers on the stack.
 static ssize_t send_request_(int const         socketId,
+                             GfProtocol const  protocol,
                              char const* const path,
                              uint8_t* const    buffer,
                              size_t const      bufferSize) {
-    RequestGet const request = {.path = path};
+    RequestGet const request = {.path = path, .pathLength = strlen(path)};
+    if (protocol == GfBinaryProtocol) {
+        if (request.pathLength > BINARY_MAX_PATH ||
+            BINARY_HEADER_SIZE + request.pathLength > bufferSize) {
+            return -1;
+        }
+        size_t const n = write_binary_request_get(buffer, &request);
+        return sock_send_all(socketId, buffer, n);
+    }
     ssize_t const n = snprintf_request_get((char*)buffer, bufferSize, &request);
     return sock_send_all(socketId, buffer, n);
 }
@@ -167,7 +182,10 @@ static int read_response_(gfcrequest_t*  gfc,
                           Response*      responseOut,
                           void** const   tailOut,
                           size_t* const  tailSizeOut) {
-    Tokenizer* tok = tok_create();
+    // a response is a handful of tokens, no need to allocate for them.
+    TokenizerStorage storage;
+    Tokenizer* const tok = tok_init(&storage);
+    tok_set_grammar(tok, ResponseGrammar);
     // this whole thing would be a lot cleaner if we didn't have headerFcn or it
     // could be written to incrementally.
     char   header[1024];
@@ -209,10 +227,41 @@ static int read_response_(gfcrequest_t*  gfc,
         gfc->headerFcn(header, numWrittenToHeader, gfc->headerFcnArg);
     }
 EXIT_POINT:
-    tok_destroy(tok);
     return status;
 }
 
+// read_response_ for the binary protocol.  the header's a fixed size, no
+// tokenizing, and it's what headerFcn gets.
+static int read_binary_response_(gfcrequest_t*  gfc,
+                                 int const      socketId,
+                                 uint8_t* const buffer,
+                                 size_t const   bufferSize,
+                                 Response*      responseOut,
+                                 void** const   tailOut,
+                                 size_t* const  tailSizeOut) {
+    size_t  received = 0;
+    ssize_t used     = 0;
+    while ((used = unpack_binary_response(buffer, received, responseOut)) ==
+           0) {
+        ssize_t const numRead =
+            recv(socketId, buffer + received, bufferSize - received, 0);
+        if (numRead <= 0) {
+            // closed before the header was all there, or failed
+            return -1;
+        }
+        received += numRead;
+    }
+    if (used < 0) {
+        return -1;
+    }
+    *tailOut     = buffer + used;
+    *tailSizeOut = received - used;
+    if (gfc->headerFcn) {
+        gfc->headerFcn(buffer, used, gfc->headerFcnArg);
+    }
+    return 0;
+}
+
 // send data to the write fcn provided by the client, since all data that we
 // send to the client goes through here, also update bytesReceived after each
 // successful write.
@@ -264,7 +313,8 @@ static int perform_(gfcrequest_t* gfc) {
 
     // send the request
     uint8_t buffer[1024];
-    if (send_request_(socketId, gfc->path, buffer, sizeof(buffer)) < 0) {
+    if (send_request_(
+            socketId, gfc->protocol, gfc->path, buffer, sizeof(buffer)) < 0) {
         status = -1;
         goto EXIT_POINT;
     }
@@ -273,8 +323,22 @@ static int perform_(gfcrequest_t* gfc) {
     Response response;
     void*    tail     = NULL;
     size_t   tailSize = 0;
-    status            = read_response_(
-        gfc, socketId, buffer, sizeof(buffer), &response, &tail, &tailSize);
+    // the header comes back in the protocol we spoke
+    status = gfc->protocol == GfBinaryProtocol
+                 ? read_binary_response_(gfc,
+                                         socketId,
+                                         buffer,
+                                         sizeof(buffer),
+                                         &response,
+                                         &tail,
+                                         &tailSize)
+                 : read_response_(gfc,
+                                  socketId,
+                                  buffer,
+                                  sizeof(buffer),
+                                  &response,
+                                  &tail,
+                                  &tailSize);
     if (status != 0) {
         gfc->status = GF_INVALID;
         goto EXIT_POINT;
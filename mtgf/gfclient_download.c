@@ -6,6 +6,7 @@
 
 #include <sys/stat.h>
 
+#include <assert.h>
 #include <errno.h>
 #include <getopt.h>
 #include <stdio.h>
@@ -161,6 +162,70 @@ int main(int argc, char** argv) {
 }
 #endif // TEST_MODE
 
+/////////////////////////////////////////////////////////////
+// Dispatch
+/////////////////////////////////////////////////////////////
+
+// like the server's handler (see gfserver_main.c), the production build binds
+// the multi threaded client to the file sink at compile time so every chunk
+// goes straight to fwrite rather than through sink_send -> sendFcn.  TEST_MODE
+// builds keep the function pointers for the mocks.  define GF_STATIC_DISPATCH
+// as 0 or 1 to override.
+#if !defined(GF_STATIC_DISPATCH)
+#if defined(TEST_MODE)
+#define GF_STATIC_DISPATCH 0
+#else
+#define GF_STATIC_DISPATCH 1
+#endif
+#endif
+
+#if GF_STATIC_DISPATCH
+// the file sink, defined below
+static void*   file_sink_start_(void*, char const*);
+static ssize_t file_sink_send_(void*, void*, void const*, size_t);
+static void    file_sink_cancel_(void*, void*);
+static int     file_sink_finish_(void*, void*);
+#endif
+
+static inline void* mtc_sink_start_(Sink* const sink, char const* const path) {
+#if GF_STATIC_DISPATCH
+    (void)sink;
+    return file_sink_start_(NULL, path);
+#else
+    return sink_start(sink, path);
+#endif
+}
+
+static inline ssize_t mtc_sink_send_(Sink* const       sink,
+                                     void* const       session,
+                                     void const* const buffer,
+                                     size_t const      n) {
+#if GF_STATIC_DISPATCH
+    (void)sink;
+    return file_sink_send_(NULL, session, buffer, n);
+#else
+    return sink_send(sink, session, buffer, n);
+#endif
+}
+
+static inline void mtc_sink_cancel_(Sink* const sink, void* const session) {
+#if GF_STATIC_DISPATCH
+    (void)sink;
+    file_sink_cancel_(NULL, session);
+#else
+    sink_cancel(sink, session);
+#endif
+}
+
+static inline int mtc_sink_finish_(Sink* const sink, void* const session) {
+#if GF_STATIC_DISPATCH
+    (void)sink;
+    return file_sink_finish_(NULL, session);
+#else
+    return sink_finish(sink, session);
+#endif
+}
+
 /////////////////////////////////////////////////////////////
 // Multi Threaded Client
 /////////////////////////////////////////////////////////////
@@ -215,7 +280,7 @@ typedef struct {
 // this is the function used as the writefunc in the gfcrequest.
 static void mtc_write_fcn_(void* buffer, size_t const size, void* data_) {
     MtcWriteFcnData* data = (MtcWriteFcnData*)data_;
-    sink_send(data->sink, data->session, buffer, size);
+    mtc_sink_send_(data->sink, data->session, buffer, size);
 }
 
 // this is used with the worker pool to "create" the worker data.  all workers
@@ -241,7 +306,8 @@ static void mtc_do_request_(void* task_, void* workerData_) {
     MtcWorkerData* workerData = (MtcWorkerData*)workerData_;
 
     // start a sink session ready to write
-    void* const sinkSession = sink_start(workerData->sink, task->localPath);
+    void* const sinkSession =
+        mtc_sink_start_(workerData->sink, task->localPath);
     if (!sinkSession) {
         return;
     }
@@ -266,10 +332,10 @@ static void mtc_do_request_(void* task_, void* workerData_) {
                     gfc_get_bytesreceived(&req));
         if (workerData->reportFcn) {
         }
-        sink_cancel(workerData->sink, sinkSession);
+        mtc_sink_cancel_(workerData->sink, sinkSession);
         return;
     }
-    sink_finish(workerData->sink, sinkSession);
+    mtc_sink_finish_(workerData->sink, sinkSession);
     mtc_report_(workerData,
                 true,
                 task->reqPath,
@@ -287,6 +353,10 @@ MultiThreadedClient* mtc_start(char const*    server,
                                void*          reportFcnArg) {
     MultiThreadedClient* out =
         (MultiThreadedClient*)calloc(1, sizeof(MultiThreadedClient));
+#if GF_STATIC_DISPATCH
+    // bound at compile time, anything else would be quietly ignored
+    assert(sink->sendFcn == file_sink_send_);
+#endif
     out->workerData.sink         = sink;
     out->workerData.server       = strdup(server);
     out->workerData.port         = port;
@@ -10,6 +10,7 @@
 #include <stddef.h>
 // gfserver.h not standalone
 
+#include "gf-student.h"
 #include "gfserver.h"
 
 #include <stdbool.h>
@@ -30,6 +31,52 @@ int gfserver_listen(gfserver_t**);
 // get the port of the server
 unsigned short gfserver_port(gfserver_t**);
 
+// sends of at least threshold bytes go out with MSG_ZEROCOPY so the kernel pins
+// the handler's buffer instead of copying it.  0 (the default) turns it off.
+// falls back to regular sends where the platform or socket doesn't support it
+// and for the rest of a connection once the kernel reports that it copied
+// anyway (as it always does over loopback).
+void gfserver_set_zerocopy_threshold(gfserver_t**, size_t threshold);
+
+// called once the kernel is done with a buffer passed to gfs_send.
+typedef void (*SendReleaseFcn)(void const* data, void* releaseArg);
+
+// by default gfs_send returns once the kernel is done with data, which for a
+// zero copy send is when the client has acknowledged it.  with a release
+// function gfs_send returns as soon as data is queued and calls release(data,
+// releaseArg), possibly from a later gfs_send or as the connection closes, when
+// the handler may reuse or free it.  a plain send releases it before it
+// returns.  data is never released if the connection fails while the kernel
+// still holds it.
+void gfserver_set_send_release_fcn(gfserver_t**,
+                                   SendReleaseFcn,
+                                   void* releaseArg);
+
+// how gfserver_serve waits for connections and reads request headers.
+typedef enum {
+    // select on the listening socket and read each header in turn.  default.
+    SelectServerBackend,
+    // io_uring: a multishot accept and the headers of many connections read at
+    // once into registered buffers.  falls back to select where io_uring (or
+    // the features it needs) isn't available.
+    IoUringServerBackend,
+} ServerBackend;
+
+void gfserver_set_backend(gfserver_t**, ServerBackend);
+
+// the backend in use.  once serving starts, this is SelectServerBackend if
+// io_uring was asked for but isn't available.
+ServerBackend gfserver_backend(gfserver_t**);
+
+// defined in gf-student.h
+struct ResponseHeaderTag;
+
+// like gfs_sendheader but sends a header that's already been serialized (see
+// ResponseHeader in gf-student.h), e.g., one cached with the content.  the
+// status and size come from the header.
+ssize_t gfs_sendheader_prepared(gfcontext_t**,
+                                struct ResponseHeaderTag const* header);
+
 // destroy server
 void gfserver_destroy(gfserver_t**);
 
@@ -46,10 +93,32 @@ typedef struct SourceTag               Source;
 // MultiThreadedHandler may be unit tested without firing up a server.
 //
 // Source is the provider of file content.
+//
+// the production build of gfserver_main.c binds the handler to the native
+// client and the content source at compile time (see GF_STATIC_DISPATCH there),
+// so there handlerClient must come from hc_init_native and source from
+// content_source_init.
 MultiThreadedHandler* mth_start(size_t         numThreads,
                                 HandlerClient* handlerClient,
                                 Source*        source);
 
+// mth_start with the options for its WorkerPool, see wp_start_with.
+MultiThreadedHandler* mth_start_with(WpOptions const* poolOptions,
+                                     size_t           numThreads,
+                                     HandlerClient*   handlerClient,
+                                     Source*          source);
+
+// share reads between requests for the same file that are in flight at the same
+// time.  the file is read once, in chunks, and every chunk is sent to each of
+// the requests.  a request can join a read in progress as long as no more than
+// window bytes have been read, it catches up from the start of the file, after
+// that it starts a read of its own.  window also limits how far the fastest
+// request can get ahead of the slowest, except that a worker with more of a
+// batch (see WpOptions) still to send doesn't wait on it.  0 (the default)
+// turns sharing off and every request reads on its own.  call before the first
+// mth_process.
+void mth_share_reads(MultiThreadedHandler*, size_t window);
+
 // process a single request.  The request is not necessarily processed before
 // calls to mth_process return.  See mth_finish below.
 void mth_process(MultiThreadedHandler* mtc,
@@ -79,6 +148,10 @@ typedef ssize_t (*HcSendHeader)(gfcontext_t**,
 typedef ssize_t (*HcSend)(gfcontext_t**, void const* data, size_t size, void*);
 // see abort in HandlerClient
 typedef void (*HcAbort)(gfcontext_t**, void*);
+// see sendPreparedHeader in HandlerClient
+typedef ssize_t (*HcSendPreparedHeader)(gfcontext_t**,
+                                        struct ResponseHeaderTag const*,
+                                        void*);
 
 struct HandlerClientTag {
     // send a header to the client.  if status != GF_OK, expect the client to
@@ -90,6 +163,9 @@ struct HandlerClientTag {
     HcSend send;
     // abort the session, taking ownership of the context.
     HcAbort abort;
+    // optional.  like sendHeader but with a header that's already serialized.
+    // hc_send_prepared_header falls back to sendHeader if this is NULL.
+    HcSendPreparedHeader sendPreparedHeader;
     // client-specific data.
     void* clientData;
 };
@@ -112,6 +188,15 @@ ssize_t hc_send(HandlerClient*, gfcontext_t**, void const* data, size_t size);
 // convenience call to abort passing along the clientData as well.
 void hc_abort(HandlerClient*, gfcontext_t**);
 
+// set the optional sendPreparedHeader.  hc_initialize leaves it NULL.
+void hc_set_send_prepared_header(HandlerClient*, HcSendPreparedHeader);
+
+// send an OK header that's already serialized.  calls sendPreparedHeader if
+// the client has one, otherwise calls sendHeader with the header's size.
+ssize_t hc_send_prepared_header(HandlerClient*,
+                                gfcontext_t**,
+                                struct ResponseHeaderTag const* header);
+
 // initialize a HandlerClient that calls the actual gfs_sendheader, gfs_send,
 // and gfs_abort.
 void hc_init_native(HandlerClient* client);
@@ -132,6 +217,10 @@ typedef ssize_t (*SourceReadFcn)(void*  sourceData,
 // See Source below.
 typedef int (*SourceFinishFcn)(void* sourceData, void* sessionData);
 
+// See Source below.
+typedef struct ResponseHeaderTag const* (*SourceHeaderFcn)(void* sourceData,
+                                                           void* sessionData);
+
 /*!
  Source is an abstraction of a data source
  */
@@ -163,6 +252,14 @@ struct SourceTag {
     // source_finish is a convenience call to this function.
     SourceFinishFcn finishFcn;
 
+    // header = source->headerFcn(source->sourceData, session)
+    // optional.  returns the serialized OK header for the session's file if
+    // the source has one ready (and NULL if it doesn't).  the header must stay
+    // valid at least until the session finishes.
+    //
+    // source_header is a convenience call to this function.
+    SourceHeaderFcn headerFcn;
+
     // client data.
     void* sourceData;
 };
@@ -183,6 +280,13 @@ ssize_t source_read(Source* source, void*, void*, size_t);
 // finish a session, see finishFcn in Source above
 int source_finish(Source* source, void*);
 
+// set the optional headerFcn.  source_initialize leaves it NULL.
+void source_set_header_fcn(Source* source, SourceHeaderFcn);
+
+// the prepared header for a session, see headerFcn in Source above.  NULL if
+// the source doesn't have a headerFcn.
+struct ResponseHeaderTag const* source_header(Source* source, void*);
+
 // Initialize a source to read data from the content oracle.  See content.h.
 void content_source_init(Source*);
 
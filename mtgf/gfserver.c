@@ -1,4 +1,6 @@
 #define _POSIX_C_SOURCE 200112L
+// syscall and mmap flags for io_uring
+#define _DEFAULT_SOURCE
 
 #include <sys/types.h>
 
@@ -23,6 +25,16 @@
 #include <string.h>
 #include <unistd.h>
 
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#define GF_HAVE_IO_URING 1
+#endif
+#endif
+
 // name this type
 typedef gfh_error_t (*HandlerFcn)(gfcontext_t**, char const*, void*);
 
@@ -40,6 +52,15 @@ struct gfserver_t {
 
     size_t maxPending; // the maximum pending connections
 
+    // sends of at least this many bytes use MSG_ZEROCOPY.  0 turns it off.
+    size_t zerocopyThreshold;
+
+    SendReleaseFcn sendReleaseFcn;    // gives gfs_send's buffers back
+    void*          sendReleaseFcnArg; // and its arg
+
+    // how we wait for connections and read headers
+    ServerBackend backend;
+
     // some internal data
 
     Tokenizer*     tokenizer; // used to tokenize headers
@@ -77,6 +98,8 @@ gfserver_t* gfserver_create() {
     // internal data
     out->timeout   = make_timeval_(1000);
     out->tokenizer = tok_create();
+    tok_set_slices(out->tokenizer, true);
+    tok_set_grammar(out->tokenizer, RequestGrammar);
 
     // network data
     out->socketId = -1;
@@ -115,6 +138,25 @@ void gfserver_set_maxpending(gfserver_t** gfs, int maxPending) {
     (*gfs)->maxPending = maxPending;
 }
 
+void gfserver_set_zerocopy_threshold(gfserver_t** gfs, size_t threshold) {
+    (*gfs)->zerocopyThreshold = threshold;
+}
+
+void gfserver_set_send_release_fcn(gfserver_t** const   gfs,
+                                    SendReleaseFcn const sendReleaseFcn,
+                                    void* const          releaseArg) {
+    (*gfs)->sendReleaseFcn    = sendReleaseFcn;
+    (*gfs)->sendReleaseFcnArg = releaseArg;
+}
+
+void gfserver_set_backend(gfserver_t** gfs, ServerBackend backend) {
+    (*gfs)->backend = backend;
+}
+
+ServerBackend gfserver_backend(gfserver_t** gfs) {
+    return (*gfs)->backend;
+}
+
 //////////////////////////////////////////////////////////
 // start listening
 //////////////////////////////////////////////////////////
@@ -254,27 +296,39 @@ static void shutdown_(int const      acceptedSocketId,
     close(acceptedSocketId);
 }
 
-// send the serialized version of Response to the client.  the buffer is
-// provided just as a scratch to avoid each of these functions shoving a buffer
-// on the stack.
-static ssize_t send_response_(int const             acceptedSocketId,
-                              Response const* const response,
-                              uint8_t* const        buffer,
-                              size_t const          bufferSize) {
-    int const numWritten =
-        snprintf_response((char*)buffer, bufferSize, response);
-    assert(numWritten < bufferSize - 1);
-    return sock_send_all(acceptedSocketId, buffer, (size_t)numWritten);
+// send an already serialized header to the client.
+static ssize_t send_header_(int const                   acceptedSocketId,
+                            ResponseHeader const* const header) {
+    return sock_send_all(
+        acceptedSocketId, (uint8_t const*)header->text, header->size);
+}
+
+// send a binary response header to the client.
+static ssize_t send_binary_header_(int const            acceptedSocketId,
+                                   ResponseStatus const status,
+                                   size_t const         size) {
+    Response const response = {.status = status, .size = size};
+    uint8_t        header[BINARY_HEADER_SIZE];
+    write_binary_response(header, &response);
+    return sock_send_all(acceptedSocketId, header, sizeof(header));
 }
 
-// send an error response to the client and shut down the socket.
+// send an error response to the client, in its protocol, and shut down the
+// socket.  the buffer is provided just as a scratch for shutting down to avoid
+// each of these functions shoving a buffer on the stack.
 static ssize_t send_error_and_shutdown_(int const            acceptedSocketId,
+                                        GfProtocol const     protocol,
                                         ResponseStatus const error,
                                         uint8_t* const       buffer,
                                         size_t               bufferSize) {
-    Response const response = {.status = error};
-    ssize_t const  out =
-        send_response_(acceptedSocketId, &response, buffer, bufferSize);
+    ssize_t out = 0;
+    if (protocol == GfBinaryProtocol) {
+        out = send_binary_header_(acceptedSocketId, error, 0);
+    } else {
+        ResponseHeader const* const header = response_header_static(error);
+        assert(header);
+        out = send_header_(acceptedSocketId, header);
+    }
     shutdown_(acceptedSocketId, buffer, bufferSize);
     return out;
 }
@@ -282,63 +336,683 @@ static ssize_t send_error_and_shutdown_(int const            acceptedSocketId,
 // create a context ready to pass to the handler.
 // the created context will own the connection and handle closing it when the
 // time comes.
-static gfcontext_t* ctx_create_(int acceptedSocketId);
+static gfcontext_t* ctx_create_(gfserver_t const* gfs,
+                                int               acceptedSocketId,
+                                GfProtocol        protocol);
 
 // once we're connected and know what file we're requesting, create a context
 // and call the handler.
 static gfh_error_t call_handler_(gfserver_t* const gfs,
                                  int const         acceptedSocketId,
+                                 GfProtocol const  protocol,
                                  char const* const path) {
     // create a context
-    gfcontext_t* ctx = ctx_create_(acceptedSocketId);
+    gfcontext_t* ctx = ctx_create_(gfs, acceptedSocketId, protocol);
     // and call the handler
     return gfs->handlerFcn(&ctx, path, gfs->handlerFcnArg);
 }
 
+// the header has been read into tokenizer (or reading failed).
+// 1) if there's a problem, respond with invalid or error
+// 2) if no problem, create a context and call the handler.
+// readFailed: recv failed.  trailing: there was data after the header.
+static int dispatch_request_(gfserver_t* const gfs,
+                             int const         acceptedSocketId,
+                             Tokenizer* const  tokenizer,
+                             bool const        readFailed,
+                             bool const        trailing) {
+    uint8_t buffer[1024];
+    // something bad happened, tell the client so.
+    if (readFailed || !gfs->handlerFcn) {
+        send_error_and_shutdown_(acceptedSocketId,
+                                 GfTextProtocol,
+                                 ErrorResponse,
+                                 buffer,
+                                 sizeof(buffer));
+        return -1;
+    }
+    // determine the request
+    RequestGet request;
+    if (trailing || unpack_request_get(tokenizer, &request) != 0) {
+        // malformed request, respond invalid and shutdown.
+        send_error_and_shutdown_(acceptedSocketId,
+                                 GfTextProtocol,
+                                 InvalidResponse,
+                                 buffer,
+                                 sizeof(buffer));
+        return -1;
+    }
+
+    // the path is either in our receive buffer or copied and null terminated by
+    // the tokenizer.  either way the character after it is the one that ended
+    // it, so it can be terminated in place instead of copied.
+    ((char*)request.path)[request.pathLength] = '\0';
+    if (call_handler_(gfs, acceptedSocketId, GfTextProtocol, request.path) !=
+        GF_OK) {
+        // what am I supposed to do with this error?
+    }
+    return 0;
+}
+
+// dispatch_request_ for a binary request, the received bytes in buffer.  no
+// tokenizer, the request is right there.
+static int dispatch_binary_request_(gfserver_t* const gfs,
+                                    int const         acceptedSocketId,
+                                    uint8_t* const    buffer,
+                                    size_t const      received,
+                                    bool const        readFailed) {
+    uint8_t scratch[1024];
+    if (readFailed || !gfs->handlerFcn) {
+        send_error_and_shutdown_(acceptedSocketId,
+                                 GfBinaryProtocol,
+                                 ErrorResponse,
+                                 scratch,
+                                 sizeof(scratch));
+        return -1;
+    }
+    RequestGet    request;
+    ssize_t const used = unpack_binary_request_get(buffer, received, &request);
+    // cut short, malformed or followed by something
+    if (used <= 0 || (size_t)used != received) {
+        send_error_and_shutdown_(acceptedSocketId,
+                                 GfBinaryProtocol,
+                                 InvalidResponse,
+                                 scratch,
+                                 sizeof(scratch));
+        return -1;
+    }
+    // the path's at the end of what was received and BINARY_MAX_PATH leaves
+    // room to terminate it.
+    buffer[used] = '\0';
+    if (call_handler_(gfs, acceptedSocketId, GfBinaryProtocol, request.path) !=
+        GF_OK) {
+        // what am I supposed to do with this error?
+    }
+    return 0;
+}
+
+// the rest of handle_connection_ for a connection whose first received bytes
+// are a binary header.  reads until the request's all there.
+static int handle_binary_connection_(gfserver_t* const gfs,
+                                     int const         acceptedSocketId,
+                                     uint8_t* const    buffer,
+                                     size_t const      bufferSize,
+                                     size_t            received) {
+    RequestGet request;
+    ssize_t    numRead = 0;
+    while (unpack_binary_request_get(buffer, received, &request) == 0 &&
+           received < bufferSize) {
+        numRead =
+            recv(acceptedSocketId, buffer + received, bufferSize - received, 0);
+        if (numRead <= 0) {
+            break;
+        }
+        received += numRead;
+    }
+    return dispatch_binary_request_(
+        gfs, acceptedSocketId, buffer, received, numRead < 0);
+}
+
+// the room left for the next read of a header into a buffer of bufferSize
+// that already holds *received bytes of it.  the tokenizer's path token can
+// point into what's already there (see tok_set_slices) so reads go after it
+// until the buffer's full.  then the tokenizer gets its own copy and the buffer
+// starts over.
+static size_t header_space_(Tokenizer* const tokenizer,
+                            size_t* const    received,
+                            size_t const     bufferSize) {
+    if (*received == bufferSize) {
+        tok_copy_slices(tokenizer);
+        *received = 0;
+    }
+    return bufferSize - *received;
+}
+
 // do the main conneciton handling
 // 1) reads the request header
-// 2) if there's a problem, respond with invalid or error
-// 3) if no problem, create a context and call the handler.
+// 2) dispatch it
 static int handle_connection_(gfserver_t* const gfs,
                               int const         acceptedSocketId) {
     ssize_t numRead      = 0;
     ssize_t numProcessed = 0;
+    size_t  received     = 0;
     uint8_t buffer[1024];
     // reset tokenizer and read and tokenize as we go.
     tok_reset(gfs->tokenizer);
     // very important to check that the tokenizer isn't done before trying to
     // read.
-    while (!tok_done(gfs->tokenizer) && !tok_invalid(gfs->tokenizer) &&
-           (numRead = recv(acceptedSocketId, buffer, sizeof(buffer), 0)) > 0) {
-        numProcessed = tok_process(gfs->tokenizer, (char*)buffer, numRead);
+    while (!tok_done(gfs->tokenizer) && !tok_invalid(gfs->tokenizer)) {
+        size_t const space =
+            header_space_(gfs->tokenizer, &received, sizeof(buffer));
+        numRead = recv(acceptedSocketId, buffer + received, space, 0);
+        if (numRead <= 0) {
+            break;
+        }
+        // nothing's been read before, the first byte says which protocol
+        if (received == 0 && numProcessed == 0 &&
+            is_binary_header(buffer, (size_t)numRead)) {
+            return handle_binary_connection_(
+                gfs, acceptedSocketId, buffer, sizeof(buffer), numRead);
+        }
+        numProcessed =
+            tok_process(gfs->tokenizer, (char*)buffer + received, numRead);
+        received += numRead;
     }
-    // something bad happened, tell the client so.
-    if (numRead < 0 || !gfs->handlerFcn) {
-        send_error_and_shutdown_(
-            acceptedSocketId, ErrorResponse, buffer, sizeof(buffer));
+    return dispatch_request_(gfs,
+                             acceptedSocketId,
+                             gfs->tokenizer,
+                             numRead < 0,
+                             numProcessed < numRead);
+}
+
+//////////////////////////////////////////////////////////
+// io_uring
+//////////////////////////////////////////////////////////
+
+// a bare bones io_uring (no liburing).  with it the server keeps one multishot
+// accept armed on the listening socket (registered as a fixed file) and reads
+// the headers of many connections at once, each into its own slice of a
+// registered buffer, so one slow client doesn't hold up the rest.  once a
+// header is in, the connection goes to the handler just like with select.
+// while every slot is busy the accept is cancelled, new connections wait in
+// the listen backlog, and it's rearmed when a slot frees up.
+
+#if defined(GF_HAVE_IO_URING)
+
+// connections that can be reading their headers at once
+#define URING_NUM_SLOTS 64
+// size of each connection's header buffer
+#define URING_SLOT_SIZE 1024
+// user_data of the accept and its cancel, slots use their index
+#define URING_ACCEPT_DATA UINT64_MAX
+#define URING_CANCEL_DATA (UINT64_MAX - 1)
+
+typedef struct {
+    int ringFd;
+
+    // submission queue
+    unsigned*            sqHead;
+    unsigned*            sqTail;
+    unsigned*            sqArray;
+    unsigned             sqMask;
+    unsigned             sqEntries;
+    unsigned             sqLocalTail; // filled in but not yet submitted
+    struct io_uring_sqe* sqes;
+
+    // completion queue
+    unsigned*            cqHead;
+    unsigned*            cqTail;
+    unsigned             cqMask;
+    struct io_uring_cqe* cqes;
+
+    // mappings
+    void*  ringMem;
+    size_t ringMemSize;
+    void*  sqeMem;
+    size_t sqeMemSize;
+} Uring;
+
+// a connection reading its header
+typedef struct {
+    int        socketId; // -1 if the slot's free
+    Tokenizer* tokenizer;
+    size_t     received; // bytes of header in the slot's buffer
+    // set by the first read.  binary requests skip the tokenizer.
+    bool       firstRead;
+    GfProtocol protocol;
+} UringSlot;
+
+typedef struct {
+    Uring     ring;
+    UringSlot slots[URING_NUM_SLOTS];
+    // one registered buffer, URING_SLOT_SIZE for each slot
+    uint8_t* buffers;
+
+    // armed is set from arming the accept until its last completion.  paused
+    // is set while every slot is busy.  pending holds the connections that
+    // were accepted anyway, before the cancel got there, oldest first.
+    bool   armed;
+    bool   paused;
+    int*   pending;
+    size_t numPending;
+    size_t pendingCapacity;
+} UringServer;
+
+static int uring_setup_(Uring* const ring, unsigned const entries) {
+    memset(ring, 0, sizeof(Uring));
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring->ringFd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (ring->ringFd < 0) {
         return -1;
     }
-    // determine the request
-    RequestGet request;
-    if (numProcessed < numRead ||
-        unpack_request_get(gfs->tokenizer, &request) != 0) {
-        // malformed request, respond invalid and shutdown.
-        send_error_and_shutdown_(
-            acceptedSocketId, InvalidResponse, buffer, sizeof(buffer));
+    // need one mmap for both rings and waiting with a timeout (5.11)
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP) ||
+        !(params.features & IORING_FEAT_EXT_ARG)) {
+        close(ring->ringFd);
+        return -1;
+    }
+    size_t const sqSize =
+        params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    size_t const cqSize =
+        params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ring->ringMemSize = sqSize > cqSize ? sqSize : cqSize;
+    ring->ringMem     = mmap(NULL,
+                         ring->ringMemSize,
+                         PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE,
+                         ring->ringFd,
+                         IORING_OFF_SQ_RING);
+    ring->sqeMemSize  = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqeMem      = mmap(NULL,
+                        ring->sqeMemSize,
+                        PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE,
+                        ring->ringFd,
+                        IORING_OFF_SQES);
+    if (ring->ringMem == MAP_FAILED || ring->sqeMem == MAP_FAILED) {
+        if (ring->ringMem != MAP_FAILED) {
+            munmap(ring->ringMem, ring->ringMemSize);
+        }
+        if (ring->sqeMem != MAP_FAILED) {
+            munmap(ring->sqeMem, ring->sqeMemSize);
+        }
+        close(ring->ringFd);
         return -1;
     }
+    uint8_t* const mem = (uint8_t*)ring->ringMem;
+    ring->sqHead       = (unsigned*)(mem + params.sq_off.head);
+    ring->sqTail       = (unsigned*)(mem + params.sq_off.tail);
+    ring->sqArray      = (unsigned*)(mem + params.sq_off.array);
+    ring->sqMask       = *(unsigned*)(mem + params.sq_off.ring_mask);
+    ring->sqEntries    = params.sq_entries;
+    ring->sqLocalTail  = *ring->sqTail;
+    ring->sqes         = (struct io_uring_sqe*)ring->sqeMem;
+    ring->cqHead       = (unsigned*)(mem + params.cq_off.head);
+    ring->cqTail       = (unsigned*)(mem + params.cq_off.tail);
+    ring->cqMask       = *(unsigned*)(mem + params.cq_off.ring_mask);
+    ring->cqes         = (struct io_uring_cqe*)(mem + params.cq_off.cqes);
+    return 0;
+}
 
-    if (call_handler_(gfs, acceptedSocketId, request.path) != GF_OK) {
-        // what am I supposed to do with this error?
+static void uring_destroy_(Uring* const ring) {
+    munmap(ring->sqeMem, ring->sqeMemSize);
+    munmap(ring->ringMem, ring->ringMemSize);
+    // closing the ring cancels anything still in flight
+    close(ring->ringFd);
+}
+
+static int uring_register_(Uring* const ring,
+                           unsigned     opcode,
+                           void* const  arg,
+                           unsigned     numArgs) {
+    return (int)syscall(
+        __NR_io_uring_register, ring->ringFd, opcode, arg, numArgs);
+}
+
+// the next free sqe, zeroed.  NULL if the submission queue is full.
+static struct io_uring_sqe* uring_get_sqe_(Uring* const ring) {
+    unsigned const head = __atomic_load_n(ring->sqHead, __ATOMIC_ACQUIRE);
+    if (ring->sqLocalTail - head >= ring->sqEntries) {
+        return NULL;
+    }
+    unsigned const             index = ring->sqLocalTail & ring->sqMask;
+    struct io_uring_sqe* const sqe   = ring->sqes + index;
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+    ring->sqArray[index] = index;
+    ++ring->sqLocalTail;
+    return sqe;
+}
+
+// submit everything from uring_get_sqe_ and wait up to timeout for at least
+// one completion.  returns -1 on failure.
+static int uring_submit_and_wait_(Uring* const                ring,
+                                  struct timeval const* const timeout) {
+    unsigned const toSubmit = ring->sqLocalTail - *ring->sqTail;
+    __atomic_store_n(ring->sqTail, ring->sqLocalTail, __ATOMIC_RELEASE);
+
+    struct __kernel_timespec ts;
+    memset(&ts, 0, sizeof(ts));
+    ts.tv_sec  = timeout->tv_sec;
+    ts.tv_nsec = timeout->tv_usec * 1000;
+    struct io_uring_getevents_arg arg;
+    memset(&arg, 0, sizeof(arg));
+    arg.ts = (uint64_t)(uintptr_t)&ts;
+    if (syscall(__NR_io_uring_enter,
+                ring->ringFd,
+                toSubmit,
+                1,
+                IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+                &arg,
+                sizeof(arg)) < 0 &&
+        errno != ETIME && errno != EINTR && errno != EBUSY) {
+        return -1;
     }
     return 0;
 }
 
-static void serve_(gfserver_t* const gfs) {
-    // get into listening mode if we're not there already
-    if (!listening_(gfs) && listen_(gfs) == -1) {
+// pop the next completion into *cqe.  returns false if there isn't one.
+static bool uring_pop_cqe_(Uring* const ring, struct io_uring_cqe* const cqe) {
+    unsigned const head = *ring->cqHead;
+    if (head == __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    *cqe = ring->cqes[head & ring->cqMask];
+    __atomic_store_n(ring->cqHead, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+// arm the multishot accept on the listening socket, fixed file 0
+static int uring_accept_(UringServer* const us) {
+    struct io_uring_sqe* const sqe = uring_get_sqe_(&us->ring);
+    if (!sqe) {
+        return -1;
+    }
+    sqe->opcode    = IORING_OP_ACCEPT;
+    sqe->fd        = 0;
+    sqe->flags     = IOSQE_FIXED_FILE;
+    sqe->ioprio    = IORING_ACCEPT_MULTISHOT;
+    sqe->user_data = URING_ACCEPT_DATA;
+    us->armed      = true;
+    return 0;
+}
+
+// cancel the multishot accept.  its last completion says when it's gone.
+static int uring_cancel_accept_(UringServer* const us) {
+    struct io_uring_sqe* const sqe = uring_get_sqe_(&us->ring);
+    if (!sqe) {
+        return -1;
+    }
+    sqe->opcode    = IORING_OP_ASYNC_CANCEL;
+    sqe->addr      = URING_ACCEPT_DATA;
+    sqe->user_data = URING_CANCEL_DATA;
+    return 0;
+}
+
+// read the next piece of slot's header into its registered buffer
+static int uring_read_(UringServer* const us, size_t const slot) {
+    struct io_uring_sqe* const sqe = uring_get_sqe_(&us->ring);
+    if (!sqe) {
+        return -1;
+    }
+    UringSlot* const s = us->slots + slot;
+    size_t const     space =
+        header_space_(s->tokenizer, &s->received, URING_SLOT_SIZE);
+    uint8_t* const buffer = us->buffers + slot * URING_SLOT_SIZE + s->received;
+    sqe->opcode           = IORING_OP_READ_FIXED;
+    sqe->fd               = s->socketId;
+    sqe->addr             = (uint64_t)(uintptr_t)buffer;
+    sqe->len              = space;
+    sqe->buf_index        = 0;
+    sqe->user_data        = slot;
+    return 0;
+}
+
+// the ring lets go of its requests (and the files they hold) lazily once it's
+// closed, which would keep the listening socket, and the port, alive for a
+// while after the server's gone.  so cancel the accept, wait for it to finish,
+// and drop the registered listening socket before closing up.
+static void uring_stop_accepting_(UringServer* const us) {
+    if (!us->armed) {
+        uring_register_(&us->ring, IORING_UNREGISTER_FILES, NULL, 0);
+        return;
+    }
+    if (uring_cancel_accept_(us) != 0) {
+        return;
+    }
+
+    struct timeval const timeout = {.tv_sec = 0, .tv_usec = 100000};
+    for (int tries = 0; tries < 10; ++tries) {
+        if (uring_submit_and_wait_(&us->ring, &timeout) != 0) {
+            return;
+        }
+        struct io_uring_cqe cqe;
+        while (uring_pop_cqe_(&us->ring, &cqe)) {
+            if (cqe.user_data != URING_ACCEPT_DATA) {
+                continue;
+            }
+            if (cqe.res >= 0) {
+                // snuck in before the cancel
+                close(cqe.res);
+            }
+            if (!(cqe.flags & IORING_CQE_F_MORE)) {
+                uring_register_(&us->ring, IORING_UNREGISTER_FILES, NULL, 0);
+                return;
+            }
+        }
+    }
+}
+
+static void uring_server_destroy_(UringServer* const us) {
+    uring_destroy_(&us->ring);
+    for (size_t i = 0; i < URING_NUM_SLOTS; ++i) {
+        if (us->slots[i].socketId != -1) {
+            close(us->slots[i].socketId);
+        }
+        tok_destroy(us->slots[i].tokenizer);
+    }
+    for (size_t i = 0; i < us->numPending; ++i) {
+        close(us->pending[i]);
+    }
+    free(us->pending);
+    free(us->buffers);
+}
+
+static int uring_server_init_(UringServer* const us, gfserver_t* const gfs) {
+    memset(us, 0, sizeof(UringServer));
+    if (uring_setup_(&us->ring, 2 * URING_NUM_SLOTS) != 0) {
+        return -1;
+    }
+    us->buffers = (uint8_t*)calloc(URING_NUM_SLOTS, URING_SLOT_SIZE);
+    for (size_t i = 0; i < URING_NUM_SLOTS; ++i) {
+        us->slots[i].socketId  = -1;
+        us->slots[i].tokenizer = tok_create();
+        tok_set_slices(us->slots[i].tokenizer, true);
+        tok_set_grammar(us->slots[i].tokenizer, RequestGrammar);
+    }
+    struct iovec const buffers = {
+        .iov_base = us->buffers, .iov_len = URING_NUM_SLOTS * URING_SLOT_SIZE};
+    if (uring_register_(&us->ring,
+                        IORING_REGISTER_BUFFERS,
+                        (void*)&buffers,
+                        1) != 0 ||
+        uring_register_(
+            &us->ring, IORING_REGISTER_FILES, &gfs->socketId, 1) != 0 ||
+        uring_accept_(us) != 0) {
+        uring_server_destroy_(us);
+        return -1;
+    }
+    return 0;
+}
+
+// start reading acceptedSocketId's header into slot.  -1 if the read can't be
+// queued.
+static int uring_start_slot_(UringServer* const us,
+                             size_t const       slot,
+                             int const          acceptedSocketId) {
+    UringSlot* const s = us->slots + slot;
+    s->socketId        = acceptedSocketId;
+    s->received        = 0;
+    s->firstRead       = true;
+    s->protocol        = GfTextProtocol;
+    tok_reset(s->tokenizer);
+    if (uring_read_(us, slot) != 0) {
+        s->socketId = -1;
+        return -1;
+    }
+    return 0;
+}
+
+// a new connection.  start reading its header, or if every slot is busy keep
+// it for later and stop accepting more.
+static void uring_handle_accept_(UringServer* const us,
+                                 int const          acceptedSocketId) {
+    for (size_t i = 0; i < URING_NUM_SLOTS; ++i) {
+        if (us->slots[i].socketId == -1) {
+            if (uring_start_slot_(us, i, acceptedSocketId) != 0) {
+                close(acceptedSocketId);
+            }
+            return;
+        }
+    }
+    if (us->numPending == us->pendingCapacity) {
+        size_t const capacity =
+            us->pendingCapacity ? 2 * us->pendingCapacity : 8;
+        void* const  pending  = realloc(us->pending, capacity * sizeof(int));
+        if (!pending) {
+            close(acceptedSocketId);
+            return;
+        }
+        us->pending         = (int*)pending;
+        us->pendingCapacity = capacity;
+    }
+    us->pending[us->numPending++] = acceptedSocketId;
+    if (!us->paused && uring_cancel_accept_(us) == 0) {
+        us->paused = true;
+    }
+}
+
+// slot's connection has gone to the handler.  give the slot to the oldest
+// pending connection, or start accepting again.
+static void uring_slot_freed_(UringServer* const us, size_t const slot) {
+    while (us->numPending > 0) {
+        int const acceptedSocketId = us->pending[0];
+        memmove(us->pending, us->pending + 1, --us->numPending * sizeof(int));
+        if (uring_start_slot_(us, slot, acceptedSocketId) == 0) {
+            return;
+        }
+        close(acceptedSocketId);
+    }
+    if (us->paused) {
+        us->paused = false;
+        // otherwise the cancel hasn't finished it yet, see serve_uring_
+        if (!us->armed) {
+            uring_accept_(us);
+        }
+    }
+}
+
+// numRead bytes of a binary request arrived for slot (or the read failed)
+static void uring_handle_binary_read_(UringServer* const us,
+                                      gfserver_t* const  gfs,
+                                      size_t const       slot,
+                                      int const          numRead) {
+    UringSlot* const s      = us->slots + slot;
+    uint8_t* const   buffer = us->buffers + slot * URING_SLOT_SIZE;
+    RequestGet       request;
+    if (numRead > 0) {
+        s->received += numRead;
+        if (unpack_binary_request_get(buffer, s->received, &request) == 0 &&
+            s->received < URING_SLOT_SIZE && uring_read_(us, slot) == 0) {
+            // need more
+            return;
+        }
+    }
+    int const acceptedSocketId = s->socketId;
+    s->socketId                = -1;
+    dispatch_binary_request_(
+        gfs, acceptedSocketId, buffer, s->received, numRead < 0);
+    uring_slot_freed_(us, slot);
+}
+
+// numRead bytes of header arrived for slot (or the read failed)
+static void uring_handle_read_(UringServer* const us,
+                               gfserver_t* const  gfs,
+                               size_t const       slot,
+                               int const          numRead) {
+    UringSlot* const s            = us->slots + slot;
+    ssize_t          numProcessed = 0;
+    // the first byte says which protocol
+    if (s->firstRead && numRead > 0 &&
+        is_binary_header(us->buffers + slot * URING_SLOT_SIZE, numRead)) {
+        s->protocol = GfBinaryProtocol;
+    }
+    s->firstRead = false;
+    if (s->protocol == GfBinaryProtocol) {
+        uring_handle_binary_read_(us, gfs, slot, numRead);
         return;
     }
+    if (numRead > 0) {
+        numProcessed = tok_process(
+            s->tokenizer,
+            (char*)us->buffers + slot * URING_SLOT_SIZE + s->received,
+            (size_t)numRead);
+        s->received += numRead;
+        if (!tok_done(s->tokenizer) && !tok_invalid(s->tokenizer) &&
+            uring_read_(us, slot) == 0) {
+            // need more
+            return;
+        }
+    }
+    int const acceptedSocketId = s->socketId;
+    s->socketId                = -1;
+    dispatch_request_(gfs,
+                      acceptedSocketId,
+                      s->tokenizer,
+                      numRead < 0,
+                      numProcessed < numRead);
+    uring_slot_freed_(us, slot);
+}
+
+// serve with io_uring.  returns -1 if io_uring isn't available (before
+// serving anything).
+static int serve_uring_(gfserver_t* const gfs) {
+    UringServer us;
+    if (uring_server_init_(&us, gfs) != 0) {
+        return -1;
+    }
+    int  status   = 0;
+    bool accepted = false;
+    while (continue_(gfs)) {
+        if (uring_submit_and_wait_(&us.ring, &gfs->timeout) != 0) {
+            break;
+        }
+        struct io_uring_cqe cqe;
+        // at most a read for each slot, the accept and its cancel are queued
+        // for each wait, so the submission queue can't fill up
+        while (uring_pop_cqe_(&us.ring, &cqe)) {
+            if (cqe.user_data == URING_CANCEL_DATA) {
+                continue;
+            }
+            if (cqe.user_data != URING_ACCEPT_DATA) {
+                uring_handle_read_(&us, gfs, (size_t)cqe.user_data, cqe.res);
+                continue;
+            }
+            if (cqe.res >= 0) {
+                accepted = true;
+                uring_handle_accept_(&us, cqe.res);
+            } else if (cqe.res == -EINVAL && !accepted) {
+                // no multishot accept (before 5.19)
+                status = -1;
+                goto EXIT_POINT;
+            }
+            if (cqe.flags & IORING_CQE_F_MORE) {
+                continue;
+            }
+            // multishot stops on errors and cancels, rearm it unless it was
+            // paused
+            us.armed = false;
+            if (!us.paused && uring_accept_(&us) != 0) {
+                goto EXIT_POINT;
+            }
+        }
+    }
+    uring_stop_accepting_(&us);
+EXIT_POINT:
+    uring_server_destroy_(&us);
+    return status;
+}
+
+#else
+
+static int serve_uring_(gfserver_t* const gfs) {
+    (void)gfs;
+    return -1;
+}
+
+#endif
+
+static void serve_select_(gfserver_t* const gfs) {
     while (continue_(gfs)) {
         // wait for a connection
         if (!select_(gfs)) {
@@ -359,6 +1033,19 @@ static void serve_(gfserver_t* const gfs) {
     }
 }
 
+static void serve_(gfserver_t* const gfs) {
+    // get into listening mode if we're not there already
+    if (!listening_(gfs) && listen_(gfs) == -1) {
+        return;
+    }
+    if (gfs->backend == IoUringServerBackend && serve_uring_(gfs) == 0) {
+        return;
+    }
+    // fall back to select
+    gfs->backend = SelectServerBackend;
+    serve_select_(gfs);
+}
+
 void gfserver_serve(gfserver_t** gfs) {
     serve_(*gfs);
 }
@@ -387,6 +1074,19 @@ struct gfcontext_t {
     ssize_t expectSent;
     size_t  sentSoFar;
 
+    // sends of at least this many bytes use MSG_ZEROCOPY.  0 if zero copy is
+    // off for this connection.
+    size_t zerocopyThreshold;
+    // tracks the zero copy sends until the kernel's done with them.  NULL
+    // until the first one.
+    ZerocopySends* zerocopy;
+
+    SendReleaseFcn sendReleaseFcn;    // gives gfs_send's buffers back
+    void*          sendReleaseFcnArg; // and its arg
+
+    // what the client spoke, and so what its response header has to be
+    GfProtocol protocol;
+
     // scratch buffer
     uint8_t buffer[1024];
 };
@@ -407,9 +1107,19 @@ ResponseStatus gfstatus_to_response_status_(gfstatus_t const in) {
     return UnknownResponse;
 }
 
-static gfcontext_t* ctx_create_(int const acceptedSocketId) {
-    gfcontext_t* out      = (gfcontext_t*)calloc(1, sizeof(gfcontext_t));
-    out->acceptedSocketId = acceptedSocketId;
+static gfcontext_t* ctx_create_(gfserver_t const* const gfs,
+                                int const               acceptedSocketId,
+                                GfProtocol const        protocol) {
+    gfcontext_t* out       = (gfcontext_t*)calloc(1, sizeof(gfcontext_t));
+    out->acceptedSocketId  = acceptedSocketId;
+    out->protocol          = protocol;
+    out->sendReleaseFcn    = gfs->sendReleaseFcn;
+    out->sendReleaseFcnArg = gfs->sendReleaseFcnArg;
+    // only bother if the socket will take it.
+    if (gfs->zerocopyThreshold > 0 &&
+        sock_enable_zerocopy(acceptedSocketId) == 0) {
+        out->zerocopyThreshold = gfs->zerocopyThreshold;
+    }
     // initially the context doesn't know how much its gonna send.
     // the handler needs to call send_header first
     out->expectSent = -1;
@@ -421,33 +1131,63 @@ static void ctx_destroy_(gfcontext_t* ctx) {
     free(ctx);
 }
 
+// shudown the connection and destroy the context
+static gfcontext_t* ctx_shutdown_and_destroy_(gfcontext_t* const ctx) {
+    // the kernel has to be done with the handler's buffers before we go.  if
+    // the connection failed it may never be, and they stay pinned.
+    zc_destroy(ctx->zerocopy);
+    shutdown_(ctx->acceptedSocketId, ctx->buffer, sizeof(ctx->buffer));
+    ctx_destroy_(ctx);
+    return NULL;
+}
+
+// the header for response has been sent, get ready to send the file.
+static gfcontext_t* ctx_header_sent_(gfcontext_t* const    ctx,
+                                     Response const* const response) {
+    if (response->status != OkResponse || response->size == 0) {
+        // something wrong or nothing to send.  close things down.
+        return ctx_shutdown_and_destroy_(ctx);
+    }
+    // initialize what we're going to send and get ready
+    ctx->expectSent = (ssize_t)response->size;
+    ctx->sentSoFar  = 0;
+    return ctx;
+}
+
+static gfcontext_t* ctx_send_prepared_header_(
+    gfcontext_t* const          ctx,
+    ResponseHeader const* const header,
+    ssize_t* const              out) {
+    *out = ctx->protocol == GfBinaryProtocol
+               ? send_binary_header_(ctx->acceptedSocketId,
+                                     header->response.status,
+                                     header->response.size)
+               : send_header_(ctx->acceptedSocketId, header);
+    return ctx_header_sent_(ctx, &header->response);
+}
+
 static gfcontext_t* ctx_send_header_(gfcontext_t* const ctx,
                                      gfstatus_t const   status,
                                      size_t const       fileLen,
                                      ssize_t* const     out) {
     ResponseStatus const rstatus = gfstatus_to_response_status_(status);
     assert(rstatus != UnknownResponse);
+    if (ctx->protocol == GfBinaryProtocol) {
+        Response const response = {
+            .status = rstatus, .size = rstatus == OkResponse ? fileLen : 0};
+        *out = send_binary_header_(
+            ctx->acceptedSocketId, response.status, response.size);
+        return ctx_header_sent_(ctx, &response);
+    }
     if (rstatus != OkResponse) {
-        // something wrong.  send an error and close things down.
-        *out = send_error_and_shutdown_(
-            ctx->acceptedSocketId, rstatus, ctx->buffer, sizeof(ctx->buffer));
-        ctx_destroy_(ctx);
-        return NULL;
+        // errors never change, use the prebuilt ones
+        return ctx_send_prepared_header_(
+            ctx, response_header_static(rstatus), out);
     }
+    ResponseHeader header;
     Response const response = {.status = OkResponse, .size = fileLen};
-    *out                    = send_response_(
-        ctx->acceptedSocketId, &response, ctx->buffer, sizeof(ctx->buffer));
-    // initialize what we're going to send and get ready
-    ctx->expectSent = (ssize_t)fileLen;
-    ctx->sentSoFar  = 0;
-    return ctx;
-}
-
-// shudown the connection and destroy the context
-static gfcontext_t* ctx_shutdown_and_destroy_(gfcontext_t* const ctx) {
-    shutdown_(ctx->acceptedSocketId, ctx->buffer, sizeof(ctx->buffer));
-    ctx_destroy_(ctx);
-    return NULL;
+    response_header_init(&header, &response);
+    return ctx_send_prepared_header_(ctx, &header, out);
 }
 
 static gfcontext_t* ctx_send_(gfcontext_t* const ctx,
@@ -459,8 +1199,37 @@ static gfcontext_t* ctx_send_(gfcontext_t* const ctx,
     assert(ctx->expectSent >= 0);
     assert(ctx->sentSoFar + num <= (size_t)ctx->expectSent);
 
-    // send the data.
-    *numSent = sock_send_all(ctx->acceptedSocketId, buffer, num);
+    // give back the buffers of earlier sends that the kernel's done with
+    if (ctx->zerocopy) {
+        zc_reap(ctx->zerocopy, false);
+        if (zc_copied(ctx->zerocopy)) {
+            // the kernel copied anyway (e.g., loopback) so zero copy is pure
+            // overhead for this connection.  stop using it.
+            ctx->zerocopyThreshold = 0;
+        }
+    }
+
+    // send the data.  big sends go zero copy, if it's on.
+    if (ctx->zerocopyThreshold > 0 && num >= ctx->zerocopyThreshold) {
+        if (!ctx->zerocopy) {
+            ctx->zerocopy = zc_create(ctx->acceptedSocketId);
+        }
+        *numSent = zc_send(ctx->zerocopy,
+                           buffer,
+                           num,
+                           ctx->sendReleaseFcn,
+                           ctx->sendReleaseFcnArg);
+        if (!ctx->sendReleaseFcn && zc_reap(ctx->zerocopy, true) != 0) {
+            // the handler gets buffer back when we return, so it has to be
+            // free by then.
+            *numSent = -1;
+        }
+    } else {
+        *numSent = sock_send_all(ctx->acceptedSocketId, buffer, num);
+        if (ctx->sendReleaseFcn) {
+            ctx->sendReleaseFcn(buffer, ctx->sendReleaseFcnArg);
+        }
+    }
     if (*numSent == (ssize_t)num) {
         // successful send, update data sent
         ctx->sentSoFar += *numSent;
@@ -494,3 +1263,10 @@ ssize_t gfs_sendheader(gfcontext_t** const ctx,
     *ctx        = ctx_send_header_(*ctx, status, fileLen, &out);
     return out;
 }
+
+ssize_t gfs_sendheader_prepared(gfcontext_t** const         ctx,
+                                ResponseHeader const* const header) {
+    ssize_t out = 0;
+    *ctx        = ctx_send_prepared_header_(*ctx, header, &out);
+    return out;
+}
@@ -1,13 +1,13 @@
 #define _POSIX_C_SOURCE 200809L
 #include "content.h"
+#include "gf-student-gflib.h"
 #include "gf-student.h"
 #include "gfserver-student.h"
 
-#include <sys/stat.h>
-
 #include <assert.h>
 #include <errno.h>
 #include <getopt.h>
+#include <pthread.h>
 #include <signal.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -27,7 +27,20 @@
     "(Default: content.txt\n"                                                 \
     "  -p [listen_port]    Listen port (Default: 56726)\n"                    \
     "  -d [delay]          Delay in content_get, default 0, range 0-5000000 " \
-    "(microseconds)\n "
+    "(microseconds)\n"                                                        \
+    "  -z [threshold]      Send chunks of at least threshold bytes with "     \
+    "MSG_ZEROCOPY (Default: 0, off)\n"                                        \
+    "  -w [window]         Concurrent requests for the same file share "      \
+    "reads while no more than window bytes have been read (Default: "         \
+    "1048576, 0 is off)\n"                                                    \
+    "  -u                  Accept and read headers with io_uring, falls "     \
+    "back to select if it's not available\n"                                  \
+    "  -r [capacity]       Workers take requests from a lock free ring of "   \
+    "capacity requests (Default: 0, a queue behind a mutex)\n"               \
+    "  -b [batch]          Workers take up to batch requests at a time and "  \
+    "look them all up before sending (Default: 1)\n"                         \
+    "  -e [max_threads]    Start nthreads, add up to max_threads while "      \
+    "requests wait and stop them again when they're idle (Default: 0, off)\n"
 
 /* OPTIONS DESCRIPTOR ====================================================== */
 static struct option gLongOptions[] = {
@@ -36,6 +49,12 @@ static struct option gLongOptions[] = {
     {"nthreads", required_argument, NULL, 't'},
     {"port", required_argument, NULL, 'p'},
     {"content", required_argument, NULL, 'm'},
+    {"zerocopy", required_argument, NULL, 'z'},
+    {"window", required_argument, NULL, 'w'},
+    {"io-uring", no_argument, NULL, 'u'},
+    {"ring", required_argument, NULL, 'r'},
+    {"batch", required_argument, NULL, 'b'},
+    {"elastic", required_argument, NULL, 'e'},
     {NULL, 0, NULL, 0}};
 
 extern unsigned long int content_delay;
@@ -55,6 +74,10 @@ int main(int argc, char** argv) {
     int            nthreads    = 16;
     unsigned short port        = 56726;
     int            option_char = 0;
+    size_t         zerocopy    = 0;
+    size_t         window      = 1024 * 1024;
+    ServerBackend  backend     = SelectServerBackend;
+    WpOptions      poolOptions = {WpMutexQueue, 0};
 
     setbuf(stdout, NULL);
 
@@ -69,8 +92,11 @@ int main(int argc, char** argv) {
     }
 
     // Parse and set command line arguments
-    while ((option_char = getopt_long(
-                argc, argv, "p:d:rhm:t:", gLongOptions, NULL)) != -1) {
+    while ((option_char = getopt_long(argc,
+                                      argv,
+                                      "p:d:r:b:e:hm:t:z:w:u",
+                                      gLongOptions,
+                                      NULL)) != -1) {
         switch (option_char) {
         case 'h': /* help */
             fprintf(stdout, "%s", USAGE);
@@ -88,6 +114,27 @@ int main(int argc, char** argv) {
         case 'm': /* file-path */
             content_map = optarg;
             break;
+        case 'z': /* zerocopy */
+            zerocopy = (size_t)strtoul(optarg, NULL, 10);
+            break;
+        case 'w': /* window */
+            window = (size_t)strtoul(optarg, NULL, 10);
+            break;
+        case 'u': /* io-uring */
+            backend = IoUringServerBackend;
+            break;
+        case 'r': /* ring */
+            poolOptions.ringCapacity = (size_t)strtoul(optarg, NULL, 10);
+            poolOptions.queueKind    = poolOptions.ringCapacity > 0
+                                           ? WpRingQueue
+                                           : WpMutexQueue;
+            break;
+        case 'b': /* batch */
+            poolOptions.maxBatch = (size_t)strtoul(optarg, NULL, 10);
+            break;
+        case 'e': /* elastic */
+            poolOptions.maxWorkers = (size_t)strtoul(optarg, NULL, 10);
+            break;
         default:
             fprintf(stderr, "%s", USAGE);
             exit(1);
@@ -115,6 +162,8 @@ int main(int argc, char** argv) {
     // Setting options
     gfserver_set_port(&gfs, port);
     gfserver_set_maxpending(&gfs, 24);
+    gfserver_set_zerocopy_threshold(&gfs, zerocopy);
+    gfserver_set_backend(&gfs, backend);
 
     // setup the source to get file content from get_content.
     Source source;
@@ -126,7 +175,8 @@ int main(int argc, char** argv) {
 
     // start the handler
     MultiThreadedHandler* handler =
-        mth_start(nthreads, &handlerClient, &source);
+        mth_start_with(&poolOptions, nthreads, &handlerClient, &source);
+    mth_share_reads(handler, window);
 
     // cause gfs_handler knows to call a MutiThreadedHandler, but it needs to
     // know which one.
@@ -146,6 +196,422 @@ int main(int argc, char** argv) {
 }
 #endif
 
+/////////////////////////////////////////////////////////////
+// Dispatch
+/////////////////////////////////////////////////////////////
+
+// the production build binds the multi threaded handler to the native
+// HandlerClient and the content Source at compile time.  each chunk then goes
+// straight to gfs_send and pread instead of through hc_send -> client->send ->
+// hc_native_send_ and source_read -> readFcn, and the compiler can inline the
+// parts that live in this file.  TEST_MODE builds keep the function pointers so
+// the tests can plug in mocks.  define GF_STATIC_DISPATCH as 0 or 1 to
+// override.  test/download_system.pl runs the production build and
+// bench/bDispatch.cpp times the two against each other.
+#if !defined(GF_STATIC_DISPATCH)
+#if defined(TEST_MODE)
+#define GF_STATIC_DISPATCH 0
+#else
+#define GF_STATIC_DISPATCH 1
+#endif
+#endif
+
+#if GF_STATIC_DISPATCH
+// the natives, defined below
+static ssize_t hc_native_send_(gfcontext_t**, void const*, size_t, void*);
+static void*   content_source_start_(void*, char const*, size_t*);
+static ssize_t content_source_read_(void*, void*, void*, size_t);
+static int     content_source_finish_(void*, void*);
+static ResponseHeader const* content_source_header_(void*, void*);
+#endif
+
+static inline ssize_t mth_hc_send_header_(HandlerClient* const client,
+                                          gfcontext_t** const  ctx,
+                                          gfstatus_t const     status,
+                                          size_t const         fileLen) {
+#if GF_STATIC_DISPATCH
+    (void)client;
+    return gfs_sendheader(ctx, status, fileLen);
+#else
+    return hc_send_header(client, ctx, status, fileLen);
+#endif
+}
+
+static inline ssize_t mth_hc_send_prepared_header_(
+    HandlerClient* const        client,
+    gfcontext_t** const         ctx,
+    ResponseHeader const* const header) {
+#if GF_STATIC_DISPATCH
+    (void)client;
+    return gfs_sendheader_prepared(ctx, header);
+#else
+    return hc_send_prepared_header(client, ctx, header);
+#endif
+}
+
+static inline ssize_t mth_hc_send_(HandlerClient* const client,
+                                   gfcontext_t** const  ctx,
+                                   void const* const    data,
+                                   size_t const         size) {
+#if GF_STATIC_DISPATCH
+    (void)client;
+    return gfs_send(ctx, data, size);
+#else
+    return hc_send(client, ctx, data, size);
+#endif
+}
+
+static inline void mth_hc_abort_(HandlerClient* const client,
+                                 gfcontext_t** const  ctx) {
+#if GF_STATIC_DISPATCH
+    (void)client;
+    gfs_abort(ctx);
+#else
+    hc_abort(client, ctx);
+#endif
+}
+
+static inline void* mth_source_start_(Source* const     source,
+                                      char const* const path,
+                                      size_t* const     size) {
+#if GF_STATIC_DISPATCH
+    (void)source;
+    return content_source_start_(NULL, path, size);
+#else
+    return source_start(source, path, size);
+#endif
+}
+
+static inline ssize_t mth_source_read_(Source* const source,
+                                       void* const   session,
+                                       void* const   buffer,
+                                       size_t const  n) {
+#if GF_STATIC_DISPATCH
+    (void)source;
+    return content_source_read_(NULL, session, buffer, n);
+#else
+    return source_read(source, session, buffer, n);
+#endif
+}
+
+static inline int mth_source_finish_(Source* const source,
+                                     void* const   session) {
+#if GF_STATIC_DISPATCH
+    (void)source;
+    return content_source_finish_(NULL, session);
+#else
+    return source_finish(source, session);
+#endif
+}
+
+static inline ResponseHeader const* mth_source_header_(Source* const source,
+                                                       void* const session) {
+#if GF_STATIC_DISPATCH
+    (void)source;
+    return content_source_header_(NULL, session);
+#else
+    return source_header(source, session);
+#endif
+}
+
+/////////////////////////////////////////////////////////////
+// Shared Reads
+/////////////////////////////////////////////////////////////
+
+// when requests for the same path are in flight at the same time, they share
+// one read of the file.  whichever attached worker needs the next chunk first
+// reads it and every attached worker sends it to its own connection.  a request
+// can attach to a stream as long as the stream still holds the file from the
+// beginning (the window), after that new requests start their own stream.
+
+// size of the chunks read by a shared stream
+enum { SharedChunkSize = 64 * 1024 };
+
+typedef struct {
+    // the stream holds a reference while it's joinable and every attached
+    // worker that hasn't sent the chunk yet holds one.
+    size_t  refCount;
+    size_t  size;
+    uint8_t data[];
+} SharedChunk;
+
+typedef struct SharedReadTag SharedRead;
+
+struct SharedReadTag {
+    // the next stream in SharedReads, only touched with the SharedReads mutex
+    SharedRead* next;
+    char*       path;
+
+    // everything below is guarded by mutex.  changed is signaled whenever a
+    // chunk is read or released or the stream starts or fails.
+    pthread_mutex_t mutex;
+    pthread_cond_t  changed;
+
+    size_t numAttached; // workers using this stream
+    bool   started;     // source_start has returned
+    bool   joinable;    // in SharedReads, so more workers can attach
+    bool   reading;     // a worker is reading the next chunk
+    bool   failed;      // source_start or source_read failed
+    void*  session;     // the one source session
+    size_t size;        // and the size of the file
+
+    ResponseHeader const* header; // the source's prepared header, if any
+
+    SharedChunk** chunks;    // numChunks of them.  NULL once released.
+    size_t        numChunks; // the total needed to hold size
+    size_t        numRead;   // chunks read so far
+    size_t        numLive;   // chunks read but not released yet
+};
+
+// all of the joinable streams.
+typedef struct {
+    pthread_mutex_t mutex;
+    SharedRead*     streams;
+    // the size of the window in chunks.  0 means don't share reads.
+    size_t windowChunks;
+} SharedReads;
+
+static void shared_reads_init_(SharedReads* const reads) {
+    memset(reads, 0, sizeof(SharedReads));
+    pthread_mutex_init(&reads->mutex, NULL);
+}
+
+static void shared_reads_destroy_(SharedReads* const reads) {
+    assert(!reads->streams);
+    pthread_mutex_destroy(&reads->mutex);
+}
+
+// drop a reference to the index'th chunk.  stream->mutex must be held.
+static void shared_release_locked_(SharedRead* const stream,
+                                   size_t const      index) {
+    SharedChunk* const chunk = stream->chunks[index];
+    assert(chunk && chunk->refCount > 0);
+    if (--chunk->refCount == 0) {
+        free(chunk);
+        stream->chunks[index] = NULL;
+        --stream->numLive;
+        pthread_cond_broadcast(&stream->changed);
+    }
+}
+
+// take stream out of reads so no more workers attach to it, and drop the
+// references the stream held to keep the window around.  both reads->mutex and
+// stream->mutex must be held.
+static void shared_unjoin_locked_(SharedReads* const reads,
+                                  SharedRead* const  stream) {
+    if (!stream->joinable) {
+        return;
+    }
+    SharedRead** link = &reads->streams;
+    while (*link != stream) {
+        link = &(*link)->next;
+    }
+    *link            = stream->next;
+    stream->next     = NULL;
+    stream->joinable = false;
+    // while joinable nothing has been released
+    for (size_t i = 0; i < stream->numRead; ++i) {
+        shared_release_locked_(stream, i);
+    }
+}
+
+// attach to the stream for path, creating and starting one if there isn't one
+// to join.  always succeeds, use shared_wait_started_ to see if the file
+// exists.
+static SharedRead* shared_attach_(SharedReads* const reads,
+                                  Source* const      source,
+                                  char const* const  path) {
+    pthread_mutex_lock(&reads->mutex);
+    SharedRead* stream = reads->streams;
+    while (stream && strcmp(stream->path, path) != 0) {
+        stream = stream->next;
+    }
+    if (stream) {
+        // a joinable stream still has every chunk it's read.  take a
+        // reference to each one as we'll need to send them all.
+        pthread_mutex_lock(&stream->mutex);
+        ++stream->numAttached;
+        for (size_t i = 0; i < stream->numRead; ++i) {
+            ++stream->chunks[i]->refCount;
+        }
+        pthread_mutex_unlock(&stream->mutex);
+        pthread_mutex_unlock(&reads->mutex);
+        return stream;
+    }
+
+    stream = (SharedRead*)calloc(1, sizeof(SharedRead));
+    stream->path = strdup(path);
+    pthread_mutex_init(&stream->mutex, NULL);
+    pthread_cond_init(&stream->changed, NULL);
+    stream->numAttached = 1;
+    stream->joinable    = true;
+    stream->next        = reads->streams;
+    reads->streams      = stream;
+    pthread_mutex_unlock(&reads->mutex);
+
+    // start outside of any lock, content_get can take a while.  anybody that
+    // attaches in the mean time waits in shared_wait_started_.
+    size_t      size    = 0;
+    void* const session = mth_source_start_(source, path, &size);
+
+    pthread_mutex_lock(&stream->mutex);
+    stream->started = true;
+    stream->session = session;
+    stream->failed  = session == NULL;
+    if (session) {
+        stream->header    = mth_source_header_(source, session);
+        stream->size      = size;
+        stream->numChunks = (size + SharedChunkSize - 1) / SharedChunkSize;
+        stream->chunks =
+            (SharedChunk**)calloc(stream->numChunks, sizeof(SharedChunk*));
+    }
+    pthread_cond_broadcast(&stream->changed);
+    pthread_mutex_unlock(&stream->mutex);
+    return stream;
+}
+
+// wait for the stream to start.  returns 0 and sets *size and *header (NULL if
+// the source has none) on success.  returns -1 if the file couldn't be opened.
+static int shared_wait_started_(SharedRead* const            stream,
+                                size_t* const                size,
+                                ResponseHeader const** const header) {
+    pthread_mutex_lock(&stream->mutex);
+    while (!stream->started) {
+        pthread_cond_wait(&stream->changed, &stream->mutex);
+    }
+    int const out = stream->session ? 0 : -1;
+    *size         = stream->size;
+    *header       = stream->header;
+    pthread_mutex_unlock(&stream->mutex);
+    return out;
+}
+
+// read n bytes from the source into a new chunk.  NULL if the read fails or
+// comes up short.
+static SharedChunk* shared_read_chunk_(Source* const source,
+                                       void* const   session,
+                                       size_t const  n) {
+    SharedChunk* chunk = (SharedChunk*)malloc(sizeof(SharedChunk) + n);
+    chunk->refCount    = 0;
+    chunk->size        = n;
+    size_t numRead     = 0;
+    while (numRead < n) {
+        ssize_t const read = mth_source_read_(
+            source, session, chunk->data + numRead, n - numRead);
+        if (read <= 0) {
+            free(chunk);
+            return NULL;
+        }
+        numRead += (size_t)read;
+    }
+    return chunk;
+}
+
+// return the index'th chunk of the stream, reading it if nobody has yet.  the
+// caller holds a reference to it and must give it back with
+// shared_release_.  returns NULL if the stream failed.  pastWindow: read it
+// even if the slowest worker is more than a window behind.  a worker with
+// other requests attached that it hasn't got to yet mustn't wait on the
+// window, they may be what's holding up the stream.
+static SharedChunk* shared_chunk_(SharedReads* const reads,
+                                  Source* const      source,
+                                  SharedRead* const  stream,
+                                  size_t const       index,
+                                  bool const         pastWindow) {
+    assert(index < stream->numChunks);
+    pthread_mutex_lock(&stream->mutex);
+    for (;;) {
+        if (index < stream->numRead) {
+            SharedChunk* const out = stream->chunks[index];
+            pthread_mutex_unlock(&stream->mutex);
+            return out;
+        }
+        if (stream->failed) {
+            pthread_mutex_unlock(&stream->mutex);
+            return NULL;
+        }
+        // read the next chunk unless somebody else is or the slowest worker
+        // is more than a window behind.
+        if (!stream->reading &&
+            (pastWindow || stream->numLive <= reads->windowChunks)) {
+            break;
+        }
+        pthread_cond_wait(&stream->changed, &stream->mutex);
+    }
+    assert(index == stream->numRead);
+    stream->reading = true;
+    pthread_mutex_unlock(&stream->mutex);
+
+    size_t const       offset = index * SharedChunkSize;
+    size_t const       n      = stream->size - offset < SharedChunkSize
+                                    ? stream->size - offset
+                                    : SharedChunkSize;
+    SharedChunk* const chunk  = shared_read_chunk_(source, stream->session, n);
+
+    // once we're past the window or the stream has failed, late comers need
+    // to start their own stream.
+    bool const unjoin = !chunk || index + 1 > reads->windowChunks;
+    if (unjoin) {
+        pthread_mutex_lock(&reads->mutex);
+    }
+    pthread_mutex_lock(&stream->mutex);
+    stream->reading = false;
+    if (chunk) {
+        chunk->refCount = stream->numAttached + (stream->joinable ? 1 : 0);
+        stream->chunks[index] = chunk;
+        ++stream->numRead;
+        ++stream->numLive;
+    } else {
+        stream->failed = true;
+    }
+    if (unjoin) {
+        shared_unjoin_locked_(reads, stream);
+        pthread_mutex_unlock(&reads->mutex);
+    }
+    pthread_cond_broadcast(&stream->changed);
+    pthread_mutex_unlock(&stream->mutex);
+    return chunk;
+}
+
+// give back the reference to the index'th chunk taken by shared_chunk_
+static void shared_release_(SharedRead* const stream, size_t const index) {
+    pthread_mutex_lock(&stream->mutex);
+    shared_release_locked_(stream, index);
+    pthread_mutex_unlock(&stream->mutex);
+}
+
+// detach from the stream.  nextIndex is the first chunk this worker didn't
+// send (and so still has a reference to if it's been read).  the last worker
+// to detach finishes the source session and destroys the stream.
+static void shared_detach_(SharedReads* const reads,
+                           Source* const      source,
+                           SharedRead* const  stream,
+                           size_t const       nextIndex) {
+    pthread_mutex_lock(&reads->mutex);
+    pthread_mutex_lock(&stream->mutex);
+    for (size_t i = nextIndex; i < stream->numRead; ++i) {
+        shared_release_locked_(stream, i);
+    }
+    bool const last = --stream->numAttached == 0;
+    if (last) {
+        shared_unjoin_locked_(reads, stream);
+    }
+    pthread_mutex_unlock(&stream->mutex);
+    pthread_mutex_unlock(&reads->mutex);
+    if (!last) {
+        return;
+    }
+    assert(stream->numLive == 0);
+    if (stream->session) {
+        mth_source_finish_(source, stream->session);
+    }
+    free(stream->chunks);
+    pthread_cond_destroy(&stream->changed);
+    pthread_mutex_destroy(&stream->mutex);
+    free(stream->path);
+    free(stream);
+}
+
 /////////////////////////////////////////////////////////////
 // Multi Threaded Handler
 /////////////////////////////////////////////////////////////
@@ -158,6 +624,8 @@ typedef struct {
     HandlerClient* handlerClient;
     // and the source of files.
     Source* source;
+    // streams shared by requests for the same file
+    SharedReads sharedReads;
 } MthWorkerData;
 
 // an individual task for a worker.  the task takes ownership of the ctx and
@@ -194,67 +662,216 @@ static size_t min_(size_t a, size_t b) {
     return a > b ? b : a;
 }
 
+// send the OK header, the prepared one if the source had one.
+static void mth_send_ok_header_(MthWorkerData* const        workerData,
+                                gfcontext_t** const         ctx,
+                                ResponseHeader const* const header,
+                                size_t const                size) {
+    if (header) {
+        mth_hc_send_prepared_header_(workerData->handlerClient, ctx, header);
+    } else {
+        mth_hc_send_header_(workerData->handlerClient, ctx, GF_OK, size);
+    }
+}
+
 static void* mth_create_worker_data_(void* workerData) {
     // workerData is passed into wp_start as the global data and this just
     // copies that pointer to output
     return workerData;
 }
 
-// where the actual work goes down.  it's passed a task and the worker data.
-static void mth_do_work_(void* task_, void* workerData_) {
-    MthTask*       task       = (MthTask*)task_;
-    MthWorkerData* workerData = (MthWorkerData*)workerData_;
-    // ask the source for the file and get its size
-    size_t size    = 0;
-    void*  session = source_start(workerData->source, task->path, &size);
+// send the chunks of the stream task is attached to, then detach from it and
+// destroy the task.  see shared_chunk_ for pastWindow.
+static void mth_send_shared_(MthTask* const       task,
+                             MthWorkerData* const workerData,
+                             SharedRead* const    stream,
+                             bool const           pastWindow) {
+    SharedReads* const    reads  = &workerData->sharedReads;
+    size_t                size   = 0;
+    size_t                index  = 0;
+    ResponseHeader const* header = NULL;
+    if (shared_wait_started_(stream, &size, &header) != 0) {
+        // something wrong, assume file not found
+        mth_hc_send_header_(
+            workerData->handlerClient, &task->ctx, GF_FILE_NOT_FOUND, size);
+        goto EXIT_POINT;
+    }
+
+    // send the header
+    mth_send_ok_header_(workerData, &task->ctx, header, size);
+
+    for (size_t sent = 0; sent < size; ++index) {
+        SharedChunk const* const chunk =
+            shared_chunk_(reads, workerData->source, stream, index, pastWindow);
+        if (!chunk) {
+            // bad read, abort should take the context here.
+            mth_hc_abort_(workerData->handlerClient, &task->ctx);
+            goto EXIT_POINT;
+        }
+        // send should take the context when we're done
+        mth_hc_send_(
+            workerData->handlerClient, &task->ctx, chunk->data, chunk->size);
+        sent += chunk->size;
+        shared_release_(stream, index);
+    }
+EXIT_POINT:
+    shared_detach_(reads, workerData->source, stream, index);
+    mth_task_destroy_(task);
+}
+
+// mth_do_work_ when reads are shared.  attach to a stream for the file and send
+// its chunks.
+static void mth_do_shared_work_(MthTask* const       task,
+                                MthWorkerData* const workerData) {
+    SharedReads* const reads = &workerData->sharedReads;
+    SharedRead* const  stream =
+        shared_attach_(reads, workerData->source, task->path);
+    mth_send_shared_(task, workerData, stream, false);
+}
+
+// send the file session is for, size bytes, or not found if there isn't one.
+// then finish the session and destroy the task.
+static void mth_send_file_(MthTask* const       task,
+                           MthWorkerData* const workerData,
+                           void* const          session,
+                           size_t const         size) {
     if (!session) {
         // something wrong, assume file not found
-        hc_send_header(
+        mth_hc_send_header_(
             workerData->handlerClient, &task->ctx, GF_FILE_NOT_FOUND, size);
         goto EXIT_POINT;
     }
 
     // send the header
-    hc_send_header(workerData->handlerClient, &task->ctx, GF_OK, size);
+    mth_send_ok_header_(workerData,
+                        &task->ctx,
+                        mth_source_header_(workerData->source, session),
+                        size);
 
     size_t sent = 0;
     while (sent < size) {
         // read some and write some
         uint8_t       buffer[1024];
-        ssize_t const read = source_read(workerData->source,
-                                         session,
-                                         buffer,
-                                         min_(sizeof(buffer), size - sent));
+        ssize_t const read =
+            mth_source_read_(workerData->source,
+                             session,
+                             buffer,
+                             min_(sizeof(buffer), size - sent));
         if (read < 0) {
             // bad read, abort should take the context here.
-            hc_abort(workerData->handlerClient, &task->ctx);
+            mth_hc_abort_(workerData->handlerClient, &task->ctx);
             goto EXIT_POINT;
         }
         // send should take the context when we're done
-        hc_send(workerData->handlerClient, &task->ctx, buffer, (size_t)read);
+        mth_hc_send_(
+            workerData->handlerClient, &task->ctx, buffer, (size_t)read);
         sent += (size_t)read;
     }
 EXIT_POINT:
     if (session) {
         // finish up the source
-        source_finish(workerData->source, session);
+        mth_source_finish_(workerData->source, session);
     }
     // and destroy the task
     mth_task_destroy_(task);
 }
 
+// where the actual work goes down.  it's passed a task and the worker data.
+static void mth_do_work_(void* task_, void* workerData_) {
+    MthTask*       task       = (MthTask*)task_;
+    MthWorkerData* workerData = (MthWorkerData*)workerData_;
+    if (workerData->sharedReads.windowChunks > 0) {
+        mth_do_shared_work_(task, workerData);
+        return;
+    }
+    // ask the source for the file and get its size
+    size_t size    = 0;
+    void*  session = mth_source_start_(workerData->source, task->path, &size);
+    mth_send_file_(task, workerData, session, size);
+}
+
+// the most sessions a batch has started at once
+#define MTH_BATCH_ 16
+
+// mth_do_work_ for tasks taken together.  the lookups all go first so the
+// source can get on with every file before the first is sent.
+static void mth_do_work_batch_(void** tasks_,
+                               size_t const numTasks,
+                               void*        workerData_) {
+    MthTask**      tasks      = (MthTask**)tasks_;
+    MthWorkerData* workerData = (MthWorkerData*)workerData_;
+    if (workerData->sharedReads.windowChunks > 0) {
+        // attaching is the lookup, unless there's a stream to join already
+        for (size_t first = 0; first < numTasks; first += MTH_BATCH_) {
+            size_t const n = min_(numTasks - first, MTH_BATCH_);
+            SharedRead*  streams[MTH_BATCH_];
+            for (size_t i = 0; i < n; ++i) {
+                streams[i] = shared_attach_(&workerData->sharedReads,
+                                            workerData->source,
+                                            tasks[first + i]->path);
+            }
+            for (size_t i = 0; i < n; ++i) {
+                mth_send_shared_(
+                    tasks[first + i], workerData, streams[i], i + 1 < n);
+            }
+        }
+        return;
+    }
+    for (size_t first = 0; first < numTasks; first += MTH_BATCH_) {
+        size_t const n        = min_(numTasks - first, MTH_BATCH_);
+        void*        sessions[MTH_BATCH_];
+        size_t       sizes[MTH_BATCH_];
+        for (size_t i = 0; i < n; ++i) {
+            sizes[i]    = 0;
+            sessions[i] = mth_source_start_(
+                workerData->source, tasks[first + i]->path, sizes + i);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            mth_send_file_(tasks[first + i], workerData, sessions[i], sizes[i]);
+        }
+    }
+}
+
 MultiThreadedHandler* mth_start(size_t         numThreads,
                                 HandlerClient* handlerClient,
                                 Source*        source) {
+    return mth_start_with(NULL, numThreads, handlerClient, source);
+}
+
+MultiThreadedHandler* mth_start_with(WpOptions const* const poolOptions,
+                                     size_t                 numThreads,
+                                     HandlerClient*         handlerClient,
+                                     Source*                source) {
     MultiThreadedHandler* out =
         (MultiThreadedHandler*)calloc(1, sizeof(MultiThreadedHandler));
+#if GF_STATIC_DISPATCH
+    // bound at compile time, anything else would be quietly ignored
+    assert(handlerClient->send == hc_native_send_);
+    assert(source->readFcn == content_source_read_);
+#endif
     out->workerData.handlerClient = handlerClient;
     out->workerData.source        = source;
-    out->pool                     = wp_start(
-        numThreads, mth_do_work_, mth_create_worker_data_, &out->workerData);
+    shared_reads_init_(&out->workerData.sharedReads);
+    WpOptions options = {WpMutexQueue, 0};
+    if (poolOptions) {
+        options = *poolOptions;
+    }
+    if (options.maxBatch > 1) {
+        options.workBatch = mth_do_work_batch_;
+    }
+    out->pool = wp_start_with(&options,
+                              numThreads,
+                              mth_do_work_,
+                              mth_create_worker_data_,
+                              &out->workerData);
     return out;
 }
 
+void mth_share_reads(MultiThreadedHandler* const mtc, size_t const window) {
+    mtc->workerData.sharedReads.windowChunks =
+        (window + SharedChunkSize - 1) / SharedChunkSize;
+}
+
 void mth_process(MultiThreadedHandler* mtc,
                  gfcontext_t**         ctx,
                  char const*           path) {
@@ -264,6 +881,7 @@ void mth_process(MultiThreadedHandler* mtc,
 void mth_finish(MultiThreadedHandler* mtc) {
     // finish up.  there's no worker data to destroy.
     wp_finish(mtc->pool, NULL, NULL);
+    shared_reads_destroy_(&mtc->workerData.sharedReads);
     free(mtc);
 }
 
@@ -276,10 +894,16 @@ void hc_initialize(HandlerClient* client,
                    HcSend         send,
                    HcAbort        abort,
                    void*          clientData) {
-    client->sendHeader = sendHeader;
-    client->send       = send;
-    client->abort      = abort;
-    client->clientData = clientData;
+    client->sendHeader         = sendHeader;
+    client->send               = send;
+    client->abort              = abort;
+    client->sendPreparedHeader = NULL;
+    client->clientData         = clientData;
+}
+
+void hc_set_send_prepared_header(HandlerClient* const client,
+                                 HcSendPreparedHeader sendPreparedHeader) {
+    client->sendPreparedHeader = sendPreparedHeader;
 }
 
 ssize_t hc_send_header(HandlerClient* client,
@@ -300,6 +924,17 @@ void hc_abort(HandlerClient* client, gfcontext_t** ctx) {
     client->abort(ctx, client->clientData);
 }
 
+ssize_t hc_send_prepared_header(HandlerClient* const        client,
+                                gfcontext_t** const         ctx,
+                                ResponseHeader const* const header) {
+    assert(header->response.status == OkResponse);
+    if (client->sendPreparedHeader) {
+        return client->sendPreparedHeader(ctx, header, client->clientData);
+    }
+    return client->sendHeader(
+        ctx, GF_OK, header->response.size, client->clientData);
+}
+
 static ssize_t hc_native_send_header_(gfcontext_t** ctx,
                                       gfstatus_t    status,
                                       size_t        fileLen,
@@ -321,12 +956,21 @@ static void hc_native_abort_(gfcontext_t** ctx, void* clientData) {
     gfs_abort((gfcontext_t**)ctx);
 }
 
+static ssize_t hc_native_send_prepared_header_(
+    gfcontext_t**               ctx,
+    ResponseHeader const* const header,
+    void*                       clientData) {
+    (void)clientData;
+    return gfs_sendheader_prepared(ctx, header);
+}
+
 void hc_init_native(HandlerClient* client) {
     hc_initialize(client,
                   hc_native_send_header_,
                   hc_native_send_,
                   hc_native_abort_,
                   NULL);
+    hc_set_send_prepared_header(client, hc_native_send_prepared_header_);
 }
 
 /////////////////////////////////////////////////////////
@@ -360,31 +1004,43 @@ int source_finish(Source* source, void* session) {
     return source->finishFcn(source->sourceData, session);
 }
 
+void source_set_header_fcn(Source* const source, SourceHeaderFcn headerFcn) {
+    source->headerFcn = headerFcn;
+}
+
+ResponseHeader const* source_header(Source* const source, void* const session) {
+    if (!source->headerFcn) {
+        return NULL;
+    }
+    return source->headerFcn(source->sourceData, session);
+}
+
 // session object used for reading from the content repository, we need to keep
 // up with the fid and where we are (because other requests could be accessing
 // the same file).
 typedef struct {
     int   fid;
     off_t numRead;
+    // serialized when the content was loaded, owned by the content oracle.
+    ResponseHeader const* header;
 } ContentSession;
 
 static void* content_source_start_(void*             sourceData,
                                    char const* const path,
                                    size_t* const     size) {
     (void)sourceData;
-    int fid = content_get(path);
+    ResponseHeader const* header = NULL;
+    int const             fid    = content_get_with_header(path, &header);
     if (fid == -1) {
         return NULL;
     }
-    struct stat st;
-    if (fstat(fid, &st) == -1) {
-        return NULL;
-    }
-    *size = (size_t)st.st_size;
+    // the size was found when the content was loaded
+    *size = header->response.size;
     ContentSession* session =
         (ContentSession*)calloc(1, sizeof(ContentSession));
     session->fid     = fid;
     session->numRead = 0;
+    session->header  = header;
     return session;
 }
 
@@ -409,10 +1065,17 @@ static int content_source_finish_(void* const sourceData,
     return 0;
 }
 
+static ResponseHeader const* content_source_header_(void* const sourceData,
+                                                    void* const sessionData) {
+    (void)sourceData;
+    return ((ContentSession*)sessionData)->header;
+}
+
 void content_source_init(Source* source) {
     source_initialize(source,
                       content_source_start_,
                       content_source_read_,
                       content_source_finish_,
                       NULL);
+    source_set_header_fcn(source, content_source_header_);
 }
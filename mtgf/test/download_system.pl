@@ -0,0 +1,43 @@
+use strict;
+use Cwd qw(abs_path);
+use File::Compare;
+use File::Temp qw(tempdir);
+
+# the production gfserver_main binds its handler to gfserver and the content
+# oracle at compile time (GF_STATIC_DISPATCH), which the unit tests never
+# build.  serve the workload with it and check every file that comes back.
+my $bindir = abs_path(shift(@ARGV));
+my $gfserver = $bindir . '/gfserver_main';
+my $gfclient = $bindir . '/gfclient_download';
+my $workload = abs_path('workload.txt');
+my $root = abs_path('server_root');
+my $port = 56741;
+
+my @errors = ();
+# shared reads (the default) and not, each with and without batches
+for my $options ('', '-b 4', '-w 0', '-w 0 -b 4') {
+    my $pid = fork();
+    if ($pid == 0) {
+        exec("$gfserver -p $port -t 4 $options") or exit(1);
+    }
+    # give it time to listen
+    sleep(1);
+
+    my $dir = tempdir(CLEANUP => 1);
+    my $command = "cd $dir && $gfclient -p $port -w $workload -t 4 -n 32";
+    my $output = `$command`;
+    push @errors, "failed to run $command with server options '$options'" if $?;
+    my $received = () = $output =~ /^received /mg;
+    push @errors, "received $received of 32 with server options '$options'"
+        if $received != 32;
+    for my $path (split(/\n/, `cd $dir && find courses -type f`)) {
+        (my $original = $path) =~ s/-\d+$//;
+        push @errors, "$path differs with server options '$options'"
+            if compare("$dir/$path", "$root/$original") != 0;
+    }
+
+    kill('TERM', $pid);
+    waitpid($pid, 0);
+}
+map { print $_ . "\n" } @errors;
+exit(@errors);
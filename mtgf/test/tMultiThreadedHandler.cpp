@@ -0,0 +1,385 @@
+#include "../gf-student-gflib.h"
+#include "../gfserver-student.h"
+#include "Bytes.hpp"
+#include "random_bytes.hpp"
+#include "random_seed.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+using namespace gf::test;
+
+namespace {
+
+// a Source serving files from memory.  counts what gets read so we can tell if
+// reads are shared.
+class MemorySource {
+  public:
+    struct File {
+        Bytes bytes;
+        // reads past this fail
+        size_t failAt = std::numeric_limits<size_t>::max();
+        // the prepared header, filled in by MemorySource
+        ResponseHeader header = {};
+    };
+
+    using Files = std::unordered_map<std::string, File>;
+
+    explicit MemorySource(Files files, bool holdStarts = false)
+        : files_{prepare_headers_(std::move(files))}
+        , holdStarts_{holdStarts} {
+        source_initialize(&source_, start_, read_, finish_, this);
+    }
+
+    // provide prepared headers through the Source
+    void provide_headers() {
+        source_set_header_fcn(&source_, header_);
+    }
+
+    Source* source() {
+        return &source_;
+    }
+
+    // let any starts that are waiting go
+    void release_starts() {
+        std::unique_lock lk{mtx_};
+        holdStarts_ = false;
+        cv_.notify_all();
+    }
+
+    size_t num_starts() const {
+        return numStarts_;
+    }
+
+    size_t num_bytes_read() const {
+        return numBytesRead_;
+    }
+
+    size_t num_open() const {
+        return numOpen_;
+    }
+
+  private:
+    struct Session {
+        File const* file;
+        size_t      offset;
+    };
+
+    static void* start_(void* self_, char const* const path, size_t* size) {
+        auto& self = *static_cast<MemorySource*>(self_);
+        ++self.numStarts_;
+        {
+            std::unique_lock lk{self.mtx_};
+            self.cv_.wait(lk, [&] { return !self.holdStarts_; });
+        }
+        auto const iter = self.files_.find(path);
+        if (iter == self.files_.end()) {
+            return nullptr;
+        }
+        ++self.numOpen_;
+        *size = iter->second.bytes.size();
+        return new Session{&iter->second, 0};
+    }
+
+    static ssize_t read_(void* self_, void* session_, void* buffer, size_t n) {
+        auto& self    = *static_cast<MemorySource*>(self_);
+        auto& session = *static_cast<Session*>(session_);
+        if (session.offset >= session.file->failAt) {
+            return -1;
+        }
+        // short reads on purpose
+        n = std::min({n,
+                      session.file->bytes.size() - session.offset,
+                      size_t{1000}});
+        memcpy(buffer, session.file->bytes.data() + session.offset, n);
+        session.offset += n;
+        self.numBytesRead_ += n;
+        return static_cast<ssize_t>(n);
+    }
+
+    static ResponseHeader const* header_(void*, void* session) {
+        return &static_cast<Session*>(session)->file->header;
+    }
+
+    static Files prepare_headers_(Files files) {
+        for (auto& [_, file] : files) {
+            Response const response{OkResponse, file.bytes.size()};
+            response_header_init(&file.header, &response);
+        }
+        return files;
+    }
+
+    static int finish_(void* self_, void* session) {
+        --static_cast<MemorySource*>(self_)->numOpen_;
+        delete static_cast<Session*>(session);
+        return 0;
+    }
+
+    Files const             files_;
+    Source                  source_;
+    std::mutex              mtx_;
+    std::condition_variable cv_;
+    bool                    holdStarts_;
+    std::atomic<size_t>     numStarts_    = 0;
+    std::atomic<size_t>     numBytesRead_ = 0;
+    std::atomic<size_t>     numOpen_      = 0;
+};
+
+// what one request got.  a pointer to one of these is used as the context.
+struct Received {
+    std::optional<gfstatus_t> status;
+    Bytes                     bytes;
+    size_t                    size     = 0;
+    bool                      aborted  = false;
+    bool                      prepared = false;
+    // source starts so far when the header was sent, if it's counted
+    size_t startsAtHeader = 0;
+};
+
+Received& received(gfcontext_t** ctx) {
+    return *reinterpret_cast<Received*>(*ctx);
+}
+
+void init(HandlerClient& client) {
+    hc_initialize(
+        &client,
+        [](gfcontext_t** ctx, gfstatus_t status, size_t size, void*) {
+            received(ctx).status = status;
+            received(ctx).size   = size;
+            if (status != GF_OK || size == 0) {
+                *ctx = nullptr;
+            }
+            return ssize_t{0};
+        },
+        [](gfcontext_t** ctx, void const* data_, size_t n, void*) {
+            auto& r    = received(ctx);
+            auto* data = static_cast<std::byte const*>(data_);
+            r.bytes.insert(r.bytes.end(), data, data + n);
+            if (r.bytes.size() == r.size) {
+                *ctx = nullptr;
+            }
+            return static_cast<ssize_t>(n);
+        },
+        [](gfcontext_t** ctx, void*) {
+            received(ctx).aborted = true;
+            *ctx                  = nullptr;
+        },
+        nullptr);
+}
+
+// also take prepared headers
+void init_prepared(HandlerClient& client) {
+    init(client);
+    hc_set_send_prepared_header(
+        &client, [](gfcontext_t** ctx, ResponseHeader const* header, void*) {
+            received(ctx).prepared = true;
+            received(ctx).status   = GF_OK;
+            received(ctx).size     = header->response.size;
+            if (header->response.size == 0) {
+                *ctx = nullptr;
+            }
+            return static_cast<ssize_t>(header->size);
+        });
+}
+
+// run requests for paths through a MultiThreadedHandler
+std::list<Received> process(MultiThreadedHandler*           mth,
+                            std::vector<std::string> const& paths) {
+    std::list<Received> out;
+    for (auto const& path : paths) {
+        auto* ctx = reinterpret_cast<gfcontext_t*>(&out.emplace_back());
+        mth_process(mth, &ctx, path.c_str());
+    }
+    return out;
+}
+} // namespace
+
+TEST(MultiThreadedHandler, SharedReadsReadOnce) {
+    std::mt19937  gen{random_seed()};
+    Bytes const   bytes = random_bytes(gen, 1024 * 1024);
+    MemorySource  source{{{"/popular", {.bytes = bytes}}}, true};
+    HandlerClient client;
+    size_t const  numRequests = 16;
+    init(client);
+
+    auto* mth = mth_start(numRequests, &client, source.source());
+    mth_share_reads(mth, bytes.size());
+    auto const received =
+        process(mth, std::vector<std::string>(numRequests, "/popular"));
+    // give every worker time to attach while the first one is starting
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    source.release_starts();
+    mth_finish(mth);
+
+    for (auto const& r : received) {
+        EXPECT_EQ(r.status, GF_OK);
+        EXPECT_FALSE(r.aborted);
+        EXPECT_EQ(r.bytes, bytes);
+    }
+    EXPECT_EQ(source.num_starts(), 1);
+    EXPECT_EQ(source.num_bytes_read(), bytes.size());
+    EXPECT_EQ(source.num_open(), 0);
+}
+
+TEST(MultiThreadedHandler, Random) {
+    std::mt19937             gen{random_seed()};
+    MemorySource::Files      files;
+    std::vector<std::string> paths;
+    for (size_t const size :
+         {0, 1, 1000, 64 * 1024, 64 * 1024 + 1, 200 * 1000, 1024 * 1024}) {
+        auto const path = "/file" + std::to_string(size);
+        files.emplace(path, MemorySource::File{random_bytes(gen, size)});
+        paths.push_back(path);
+    }
+    // fails after the first couple of chunks
+    files.emplace(
+        "/bad",
+        MemorySource::File{random_bytes(gen, 1024 * 1024), 200 * 1000});
+    paths.push_back("/bad");
+    paths.push_back("/notfound");
+
+    for (size_t const window : {0, 1, 128 * 1024, 4 * 1024 * 1024}) {
+        for (size_t const numThreads : {1, 4, 16}) {
+            // more than MTH_BATCH_ at once too
+            for (size_t const maxBatch : {1, 20}) {
+                std::vector<std::string>              requests;
+                std::uniform_int_distribution<size_t> dist{0, paths.size() - 1};
+                for (size_t i = 0; i < 256; ++i) {
+                    requests.push_back(paths[dist(gen)]);
+                }
+
+                MemorySource  source{files};
+                HandlerClient client;
+                init(client);
+                WpOptions const poolOptions{WpMutexQueue, 0, maxBatch, nullptr};
+                auto*           mth = mth_start_with(
+                    &poolOptions, numThreads, &client, source.source());
+                mth_share_reads(mth, window);
+                auto const received = process(mth, requests);
+                mth_finish(mth);
+
+                EXPECT_EQ(source.num_open(), 0);
+                auto iter = received.begin();
+                for (auto const& path : requests) {
+                    auto const& r = *iter++;
+                    auto const  f = files.find(path);
+                    if (f == files.end()) {
+                        EXPECT_EQ(r.status, GF_FILE_NOT_FOUND) << path;
+                    } else if (path == "/bad") {
+                        EXPECT_EQ(r.status, GF_OK);
+                        EXPECT_TRUE(r.aborted);
+                    } else {
+                        EXPECT_EQ(r.status, GF_OK) << path;
+                        EXPECT_FALSE(r.aborted) << path;
+                        EXPECT_EQ(r.bytes, f->second.bytes) << path;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(MultiThreadedHandler, BatchesLookUpFirstWithSharedReads) {
+    std::mt19937             gen{random_seed()};
+    MemorySource::Files      files;
+    std::vector<std::string> requests;
+    for (size_t i = 0; i < 4; ++i) {
+        auto const path = "/file" + std::to_string(i);
+        files.emplace(path, MemorySource::File{random_bytes(gen, 1000)});
+        requests.push_back(path);
+    }
+    MemorySource  source{files, true};
+    HandlerClient client;
+    init(client);
+    client.clientData = &source;
+    client.sendHeader = [](gfcontext_t** ctx,
+                           gfstatus_t    status,
+                           size_t        size,
+                           void*         source) {
+        received(ctx).startsAtHeader =
+            static_cast<MemorySource*>(source)->num_starts();
+        received(ctx).status = status;
+        received(ctx).size   = size;
+        return ssize_t{0};
+    };
+
+    WpOptions const poolOptions{WpMutexQueue, 0, requests.size(), nullptr};
+    auto* mth = mth_start_with(&poolOptions, 1, &client, source.source());
+    mth_share_reads(mth, 1024 * 1024);
+    // the one worker is held up on the first so the rest queue up and it takes
+    // them together
+    auto const first = process(mth, {requests[0]});
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    auto const received = process(mth, requests);
+    source.release_starts();
+    mth_finish(mth);
+
+    EXPECT_EQ(first.front().bytes, files.at(requests[0]).bytes);
+    auto iter = received.begin();
+    for (auto const& path : requests) {
+        auto const& r = *iter++;
+        EXPECT_EQ(r.bytes, files.at(path).bytes) << path;
+        // the batch's starts all came before its first header
+        EXPECT_EQ(r.startsAtHeader, 1 + requests.size()) << path;
+    }
+}
+
+TEST(MultiThreadedHandler, PreparedHeaders) {
+    std::mt19937             gen{random_seed()};
+    MemorySource::Files      files;
+    std::vector<std::string> requests;
+    for (size_t const size : {0, 1, 1000, 200 * 1000}) {
+        auto const path = "/file" + std::to_string(size);
+        files.emplace(path, MemorySource::File{random_bytes(gen, size)});
+        requests.push_back(path);
+        requests.push_back(path);
+    }
+    requests.push_back("/notfound");
+
+    for (size_t const window : {0, 1024 * 1024}) {
+        // the client and the source both have to be on board
+        for (bool const clientPrepared : {false, true}) {
+            for (bool const sourcePrepared : {false, true}) {
+                MemorySource source{files};
+                if (sourcePrepared) {
+                    source.provide_headers();
+                }
+                HandlerClient client;
+                if (clientPrepared) {
+                    init_prepared(client);
+                } else {
+                    init(client);
+                }
+                auto* mth = mth_start(4, &client, source.source());
+                mth_share_reads(mth, window);
+                auto const received = process(mth, requests);
+                mth_finish(mth);
+
+                auto iter = received.begin();
+                for (auto const& path : requests) {
+                    auto const& r = *iter++;
+                    auto const  f = files.find(path);
+                    if (f == files.end()) {
+                        EXPECT_EQ(r.status, GF_FILE_NOT_FOUND);
+                        EXPECT_FALSE(r.prepared);
+                        continue;
+                    }
+                    EXPECT_EQ(r.prepared, clientPrepared && sourcePrepared);
+                    EXPECT_EQ(r.status, GF_OK);
+                    EXPECT_EQ(r.size, f->second.bytes.size());
+                    EXPECT_EQ(r.bytes, f->second.bytes);
+                }
+            }
+        }
+    }
+}
@@ -3,6 +3,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
 #include <atomic>
 #include <barrier>
 #include <iterator>
@@ -19,13 +23,25 @@ struct QueueDestroyer {
 
 using QueuePtr = std::unique_ptr<Queue, QueueDestroyer>;
 
-QueuePtr create_queue() {
-    return QueuePtr{queue_create()};
+enum class Kind { Mutex, Ring };
+
+Kind const kinds[] = {Kind::Mutex, Kind::Ring};
+
+std::ostream& operator<<(std::ostream& stream, Kind const kind) {
+    return stream << (kind == Kind::Ring ? "ring" : "mutex");
+}
+
+// the ring's small by default so it fills up
+QueuePtr create_queue(Kind const kind, size_t const ringCapacity = 64) {
+    return QueuePtr{kind == Kind::Ring ? queue_create_ring(ringCapacity)
+                                       : queue_create()};
 }
 } // namespace
 
 TEST(Queue, CreateDestroy) {
-    auto q = create_queue();
+    for (auto const kind : kinds) {
+        auto q = create_queue(kind);
+    }
 }
 
 namespace {
@@ -56,88 +72,257 @@ auto ints(int const low, int const high) {
 } // namespace
 
 TEST(Queue, SingleThreadedFifo) {
-    auto       q  = create_queue();
     auto const in = ints(-1028, 1028);
-    for (auto const i : in) {
-        queue_enqueue(q.get(), to_ptr(i));
-    }
-    std::vector<int> out;
-    while (!queue_empty(q.get())) {
-        out.push_back(to_int(queue_dequeue(q.get())));
+    for (auto const kind : kinds) {
+        // room for everything, nothing's taking them out
+        auto q = create_queue(kind, in.size());
+        for (auto const i : in) {
+            queue_enqueue(q.get(), to_ptr(i));
+        }
+        std::vector<int> out;
+        while (!queue_empty(q.get())) {
+            out.push_back(to_int(queue_dequeue(q.get())));
+        }
+        EXPECT_EQ(in, out) << kind;
     }
-    EXPECT_EQ(in, out);
 }
 
 TEST(Queue, ConcurrentOneThread) {
-    auto             q  = create_queue();
-    auto             in = ints(-1028, 1028);
-    std::vector<int> out;
+    auto const in = ints(-1028, 1028);
+    for (auto const kind : kinds) {
+        auto             q = create_queue(kind);
+        std::vector<int> out;
 
-    std::thread t{[&q, &out, &in] {
-        while (out.size() < in.size()) {
-            out.push_back(to_int(queue_dequeue(q.get())));
+        std::thread t{[&q, &out, &in] {
+            while (out.size() < in.size()) {
+                out.push_back(to_int(queue_dequeue(q.get())));
+            }
+        }};
+        for (auto const i : in) {
+            queue_enqueue(q.get(), to_ptr(i));
         }
-    }};
-    for (auto const i : in) {
-        queue_enqueue(q.get(), to_ptr(i));
+        t.join();
+        EXPECT_EQ(in, out) << kind;
     }
-    t.join();
-    EXPECT_EQ(in, out);
 }
 
 TEST(Queue, ManyReadersManyWriters) {
-    auto             q  = create_queue();
-    int const        n  = 1024 * 128;
-    auto const       in = ints(-n, n);
-    std::vector<int> out;
+    int const  n  = 1024 * 128;
+    auto const in = ints(-n, n);
 
-    for (size_t numReaders : {1, 2, 64}) {
-        for (size_t numWriters : {1, 2, 64}) {
-            static int const pill = std::numeric_limits<int>::max();
-            std::barrier     readerBarrier{static_cast<ptrdiff_t>(numReaders)};
-            std::vector<std::thread>      readers;
-            std::vector<std::vector<int>> bins;
-            bins.reserve(numReaders);
-            while (readers.size() < numReaders) {
-                bins.emplace_back();
-                auto& bin = bins.back();
-                readers.emplace_back([&bin, &readerBarrier, &q] {
-                    readerBarrier.arrive_and_wait();
-                    int item = pill;
-                    // keep going until the poisoned pill
-                    while ((item = to_int(queue_dequeue(q.get()))) != pill) {
-                        bin.push_back(item);
-                    }
-                });
+    for (auto const kind : kinds) {
+        auto q = create_queue(kind);
+        for (size_t numReaders : {1, 2, 64}) {
+            for (size_t numWriters : {1, 2, 64}) {
+                static int const pill = std::numeric_limits<int>::max();
+                std::barrier     readerBarrier{
+                    static_cast<ptrdiff_t>(numReaders)};
+                std::vector<std::thread>      readers;
+                std::vector<std::vector<int>> bins;
+                bins.reserve(numReaders);
+                while (readers.size() < numReaders) {
+                    bins.emplace_back();
+                    auto& bin = bins.back();
+                    readers.emplace_back([&bin, &readerBarrier, &q] {
+                        readerBarrier.arrive_and_wait();
+                        int item = pill;
+                        // keep going until the poisoned pill
+                        while ((item = to_int(queue_dequeue(q.get()))) !=
+                               pill) {
+                            bin.push_back(item);
+                        }
+                    });
+                }
+
+                std::barrier writerBarrier{static_cast<ptrdiff_t>(numWriters)};
+                std::vector<std::thread> writers;
+                std::atomic<size_t>      numWritten{0};
+                while (writers.size() < numWriters) {
+                    writers.emplace_back(
+                        [&in, &numWritten, &writerBarrier, &q] {
+                            writerBarrier.arrive_and_wait();
+                            // claim an index before writing it
+                            for (size_t i = 0;
+                                 (i = numWritten++) < in.size();) {
+                                queue_enqueue(q.get(), to_ptr(in[i]));
+                            }
+                        });
+                }
+                // join the writers
+                std::ranges::for_each(writers, &std::thread::join);
+                {
+                    std::vector<QueueItem> pills(numReaders, to_ptr(pill));
+                    assert(pills.size() == numReaders);
+                    queue_enqueue_n(q.get(), pills.data(), pills.size());
+                }
+                // join the readers
+
+                std::ranges::for_each(readers, &std::thread::join);
+
+                std::vector<int> all;
+                std::ranges::copy(bins | std::views::join,
+                                  std::back_inserter(all));
+                std::ranges::sort(all);
+                EXPECT_THAT(all, testing::ElementsAreArray(in))
+                    << kind << " " << numReaders << ":" << numWriters;
+            }
+        }
+    }
+}
+
+TEST(Queue, BatchesStayTogether) {
+    // writer, batch and position in the batch
+    auto const item = [](int const writer, int const batch, int const i) {
+        return (writer << 24) | (batch << 8) | i;
+    };
+    int const numWriters = 4;
+    int const numBatches = 1000;
+    for (auto const kind : kinds) {
+        auto                     q = create_queue(kind);
+        std::vector<std::thread> writers;
+        int                      expected = 0;
+        for (int w = 0; w < numWriters; ++w) {
+            std::vector<std::vector<QueueItem>> batches;
+            for (int b = 0; b < numBatches; ++b) {
+                // up to the ring's capacity
+                batches.emplace_back();
+                for (int i = 0; i < 1 + (b * 7 + w) % 64; ++i) {
+                    batches.back().push_back(to_ptr(item(w, b, i)));
+                }
+                expected += static_cast<int>(batches.back().size());
             }
+            writers.emplace_back([&q, batches = std::move(batches)]() mutable {
+                for (auto& batch : batches) {
+                    queue_enqueue_n(q.get(), batch.data(), batch.size());
+                }
+            });
+        }
+        // take everything so the writers finish, whatever happens
+        int previous = -1;
+        int split    = 0;
+        for (int n = 0; n < expected; ++n) {
+            int const current = to_int(queue_dequeue(q.get()));
+            // the rest of a batch follows what came before it
+            if ((current & 0xff) && current - 1 != previous) {
+                ++split;
+            }
+            previous = current;
+        }
+        std::ranges::for_each(writers, &std::thread::join);
+        EXPECT_EQ(split, 0) << kind;
+        EXPECT_TRUE(queue_empty(q.get())) << kind;
+    }
+}
+
+TEST(Queue, DequeueNTakesWhatsThere) {
+    auto const in = ints(0, 99);
+    for (auto const kind : kinds) {
+        auto q = create_queue(kind, in.size());
+        for (auto const i : in) {
+            queue_enqueue(q.get(), to_ptr(i));
+        }
+        std::vector<int> out;
+        std::vector<QueueItem> batch(16);
+        while (!queue_empty(q.get())) {
+            size_t const n =
+                queue_dequeue_n(q.get(), batch.data(), batch.size());
+            // all there is up to the max
+            EXPECT_EQ(n, std::min(batch.size(), in.size() - out.size()))
+                << kind;
+            std::ranges::transform(
+                batch | std::views::take(n), std::back_inserter(out), to_int);
+        }
+        EXPECT_EQ(in, out) << kind;
+    }
+}
 
-            std::barrier writerBarrier{static_cast<ptrdiff_t>(numWriters)};
-            std::vector<std::thread> writers;
-            std::atomic<size_t>      numWritten{0};
-            while (writers.size() < numWriters) {
-                writers.emplace_back([&in, &numWritten, &writerBarrier, &q] {
-                    writerBarrier.arrive_and_wait();
-                    while (numWritten < in.size()) {
-                        queue_enqueue(q.get(), to_ptr(in[numWritten++]));
+TEST(Queue, DequeueNManyReaders) {
+    static int const pill = -1;
+    int const        n    = 1024 * 64;
+    auto const       in   = ints(0, n - 1);
+    for (auto const kind : kinds) {
+        for (size_t numReaders : {1, 2, 64}) {
+            auto                          q = create_queue(kind);
+            std::vector<std::thread>      readers;
+            std::vector<std::vector<int>> bins(numReaders);
+            for (auto& bin : bins) {
+                readers.emplace_back([&bin, &q] {
+                    std::vector<QueueItem> batch(16);
+                    for (;;) {
+                        size_t const taken = queue_dequeue_n(
+                            q.get(), batch.data(), batch.size());
+                        auto const first = batch.begin();
+                        auto const pills = std::find_if(
+                            first, first + taken, [](QueueItem const item) {
+                                return to_int(item) == pill;
+                            });
+                        std::transform(
+                            first, pills, std::back_inserter(bin), to_int);
+                        if (pills != first + taken) {
+                            // the pills come last, one each
+                            queue_enqueue_n(q.get(),
+                                            &*pills + 1,
+                                            first + taken - pills - 1);
+                            break;
+                        }
                     }
                 });
             }
-            // join the writers
-            std::ranges::for_each(writers, &std::thread::join);
-            {
-                std::vector<QueueItem> pills(numReaders, to_ptr(pill));
-                assert(pills.size() == numReaders);
-                queue_enqueue_n(q.get(), pills.data(), pills.size());
+            for (size_t i = 0; i < in.size(); i += 3) {
+                // batches of 3, less at the end
+                std::vector<QueueItem> batch;
+                for (size_t j = i; j < std::min(i + 3, in.size()); ++j) {
+                    batch.push_back(to_ptr(in[j]));
+                }
+                queue_enqueue_n(q.get(), batch.data(), batch.size());
             }
-            // join the readers
-
+            std::vector<QueueItem> pills(numReaders, to_ptr(pill));
+            queue_enqueue_n(q.get(), pills.data(), pills.size());
             std::ranges::for_each(readers, &std::thread::join);
 
             std::vector<int> all;
-            std::ranges::copy(bins | std::views::join, std::back_inserter(all));
+            for (auto const& bin : bins) {
+                // each reader's in the order they went in
+                EXPECT_TRUE(std::ranges::is_sorted(bin)) << kind;
+                std::ranges::copy(bin, std::back_inserter(all));
+            }
             std::ranges::sort(all);
-            EXPECT_THAT(all, testing::ElementsAreArray(in))
-                << numReaders << ":" << numWriters;
+            EXPECT_EQ(all, in) << kind << " " << numReaders;
+            EXPECT_TRUE(queue_empty(q.get())) << kind;
+        }
+    }
+}
+
+TEST(Queue, SteadyStateDoesntAllocate) {
+#if defined(__GLIBC__)
+    // the bytes this thread's arena has handed out
+    auto const allocated = [] { return mallinfo2().uordblks; };
+    int const  n         = 1024;
+    for (auto const kind : kinds) {
+        auto q = create_queue(kind, n);
+        // as long as it gets
+        for (int i = 0; i < n; ++i) {
+            queue_enqueue(q.get(), to_ptr(i));
+        }
+        while (!queue_empty(q.get())) {
+            queue_dequeue(q.get());
+        }
+
+        std::vector<QueueItem> batch(16, to_ptr(0));
+        auto const             before = allocated();
+        for (int i = 0; i < n; ++i) {
+            queue_enqueue(q.get(), to_ptr(i));
+        }
+        // a malloc for each would show here
+        EXPECT_EQ(allocated(), before) << kind;
+        while (!queue_empty(q.get())) {
+            queue_dequeue_n(q.get(), batch.data(), batch.size());
         }
+        queue_enqueue_n(q.get(), batch.data(), batch.size());
+        queue_dequeue(q.get());
+        EXPECT_EQ(allocated(), before) << kind;
     }
+#else
+    GTEST_SKIP() << "counts with glibc's mallinfo2";
+#endif
 }
@@ -3,8 +3,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
 #include <iterator>
 #include <ranges>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -39,47 +42,340 @@ auto ints(int const n) {
 } // namespace
 
 TEST(WorkerPool, Cascading) {
-    for (size_t numWorkers1 : {1, 2, 64}) {
-        for (size_t numWorkers2 : {1, 2, 64}) {
-            using Bin         = std::vector<int>;
-            WorkerPool* pool2 = wp_start(
-                numWorkers2,
-                [](void* value, void* bin_) {
-                    auto* bin = reinterpret_cast<Bin*>(bin_);
-                    bin->emplace_back(to_int(value));
-                },
-                [](void*) -> void* { return new Bin{}; },
-                NULL);
+    // the ring small enough to fill up
+    for (WpOptions const options : {WpOptions{WpMutexQueue, 0},
+                                    WpOptions{WpRingQueue, 64},
+                                    WpOptions{WpWorkStealing, 0}}) {
+        for (size_t numWorkers1 : {1, 2, 64}) {
+            for (size_t numWorkers2 : {1, 2, 64}) {
+                using Bin         = std::vector<int>;
+                WorkerPool* pool2 = wp_start_with(
+                    &options,
+                    numWorkers2,
+                    [](void* value, void* bin_) {
+                        auto* bin = reinterpret_cast<Bin*>(bin_);
+                        bin->emplace_back(to_int(value));
+                    },
+                    [](void*) -> void* { return new Bin{}; },
+                    NULL);
 
-            WorkerPool* pool1 = wp_start(
-                numWorkers1,
-                [](void* value, void* pool_) {
-                    auto* pool = reinterpret_cast<WorkerPool*>(pool_);
-                    wp_add_task(pool, value);
-                },
-                [](void* pool_) { return pool_; },
-                pool2);
+                WorkerPool* pool1 = wp_start_with(
+                    &options,
+                    numWorkers1,
+                    [](void* value, void* pool_) {
+                        auto* pool = reinterpret_cast<WorkerPool*>(pool_);
+                        wp_add_task(pool, value);
+                    },
+                    [](void* pool_) { return pool_; },
+                    pool2);
+
+                auto const in = ints(1024 * 128);
+                for (auto const i : in) {
+                    wp_add_task(pool1, to_ptr(i));
+                }
+                wp_finish(pool1, NULL, NULL);
+
+                std::vector<int> all;
+                wp_finish(
+                    pool2,
+                    [](void* bin_, void* all_) {
+                        auto* const bin = reinterpret_cast<Bin*>(bin_);
+                        auto* const all =
+                            reinterpret_cast<std::vector<int>*>(all_);
+                        all->insert(all->end(), bin->begin(), bin->end());
+                        delete bin;
+                    },
+                    &all);
+
+                std::ranges::sort(all);
+                EXPECT_THAT(all, testing::ElementsAreArray(in))
+                    << options.queueKind << " " << numWorkers1 << ":"
+                    << numWorkers2;
+            }
+        }
+    }
+}
+
+namespace {
+// tasks that add tasks to their own pool, a binary tree of them
+struct Tree {
+    WorkerPool*      pool = nullptr;
+    std::atomic<int> unfinished{0};
+    std::atomic<int> leaves{0};
+};
+
+void grow_(void* depth_, void* tree_) {
+    auto* const tree  = reinterpret_cast<Tree*>(tree_);
+    int const   depth = to_int(depth_);
+    if (depth == 0) {
+        ++tree->leaves;
+    } else {
+        tree->unfinished += 2;
+        WpTask children[] = {to_ptr(depth - 1), to_ptr(depth - 1)};
+        wp_add_tasks(tree->pool, children, 2);
+    }
+    --tree->unfinished;
+}
+} // namespace
+
+TEST(WorkerPool, TasksAddTasks) {
+    int const depth = 14;
+    // a full ring would block the workers that empty it
+    for (WpOptions const options : {WpOptions{WpMutexQueue, 0},
+                                    WpOptions{WpRingQueue, 2 << depth},
+                                    WpOptions{WpWorkStealing, 0}}) {
+        for (size_t numWorkers : {1, 2, 64}) {
+            Tree tree;
+            tree.pool = wp_start_with(&options,
+                                      numWorkers,
+                                      grow_,
+                                      [](void* t) { return t; },
+                                      &tree);
+            tree.unfinished = 1;
+            wp_add_task(tree.pool, to_ptr(depth));
+            // wp_finish only waits for what's been added so far
+            while (tree.unfinished > 0) {
+                std::this_thread::yield();
+            }
+            wp_finish(tree.pool, NULL, NULL);
+            EXPECT_EQ(tree.leaves, 1 << depth)
+                << options.queueKind << " " << numWorkers;
+        }
+    }
+}
+
+namespace {
+// one task that adds more than fit in its worker's deque (WP_DEQUE_SIZE_, 1024)
+// and then waits for them, so the rest go to the injector and the other
+// workers have to steal the ones in the deque.
+int const fanOutTasks = 4 * 1024;
+
+struct FanOut {
+    WorkerPool*      pool = nullptr;
+    std::atomic<int> done{0};
+};
+
+// what a worker ran
+struct Ran {
+    FanOut*          fanOut = nullptr;
+    std::vector<int> items;
+    bool             fanned = false;
+};
+
+void fan_out_(WpTask const task, void* ran_) {
+    auto* const ran    = reinterpret_cast<Ran*>(ran_);
+    auto* const fanOut = ran->fanOut;
+    if (int const value = to_int(task); value >= 0) {
+        ran->items.push_back(value);
+        ++fanOut->done;
+        return;
+    }
+    ran->fanned = true;
+    for (int i = 0; i < fanOutTasks; ++i) {
+        wp_add_task(fanOut->pool, to_ptr(i));
+    }
+    // give up eventually so a pool that doesn't steal fails instead of hanging
+    auto const deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (fanOut->done < fanOutTasks &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+} // namespace
+
+TEST(WorkerPool, OverflowsAndSteals) {
+    WpOptions const options{WpWorkStealing, 0};
+    for (size_t numWorkers : {2, 4, 64}) {
+        FanOut fanOut;
+        fanOut.pool = wp_start_with(
+            &options,
+            numWorkers,
+            fan_out_,
+            [](void* fanOut_) -> void* {
+                return new Ran{.fanOut = reinterpret_cast<FanOut*>(fanOut_)};
+            },
+            &fanOut);
+        wp_add_task(fanOut.pool, to_ptr(-1));
+        // wp_finish only waits for what's been added so far
+        while (fanOut.done < fanOutTasks) {
+            std::this_thread::yield();
+        }
+        std::vector<Ran*> workers;
+        wp_finish(
+            fanOut.pool,
+            [](void* ran_, void* workers_) {
+                reinterpret_cast<std::vector<Ran*>*>(workers_)->push_back(
+                    reinterpret_cast<Ran*>(ran_));
+            },
+            &workers);
+
+        std::vector<int> all;
+        size_t           fanned = 0;
+        for (Ran* const ran : workers) {
+            if (ran->fanned) {
+                ++fanned;
+                // it was waiting the whole time, the others took everything
+                EXPECT_THAT(ran->items, testing::IsEmpty()) << numWorkers;
+            }
+            all.insert(all.end(), ran->items.begin(), ran->items.end());
+            delete ran;
+        }
+        EXPECT_EQ(fanned, 1u) << numWorkers;
+        std::ranges::sort(all);
+        EXPECT_THAT(all, testing::ElementsAreArray(ints(0, fanOutTasks - 1)))
+            << numWorkers;
+    }
+}
+
+namespace {
+// what a worker took
+struct Batches {
+    std::vector<int> items;
+    size_t           largest = 0;
+    bool             inOrder = true;
+};
 
-            auto const in = ints(1024 * 128);
-            for (auto const i : in) {
-                wp_add_task(pool1, to_ptr(i));
+void take_batch_(WpTask* const tasks, size_t const n, void* batches_) {
+    auto* const batches = reinterpret_cast<Batches*>(batches_);
+    batches->largest    = std::max(batches->largest, n);
+    for (size_t i = 0; i < n; ++i) {
+        // one thread added them in order
+        batches->inOrder = batches->inOrder &&
+                           (i == 0 || to_int(tasks[i - 1]) < to_int(tasks[i]));
+        batches->items.push_back(to_int(tasks[i]));
+    }
+}
+
+void take_one_(WpTask const task, void* batches) {
+    take_batch_(const_cast<WpTask*>(&task), 1, batches);
+}
+} // namespace
+
+TEST(WorkerPool, Batches) {
+    size_t const maxBatch = 8;
+    for (WpOptions const options :
+         {WpOptions{WpMutexQueue, 0, maxBatch, take_batch_},
+          WpOptions{WpRingQueue, 64, maxBatch, take_batch_},
+          WpOptions{WpMutexQueue, 0, maxBatch, nullptr}}) {
+        for (size_t numWorkers : {1, 2, 64}) {
+            WorkerPool* const pool = wp_start_with(
+                &options,
+                numWorkers,
+                take_one_,
+                [](void*) -> void* { return new Batches{}; },
+                NULL);
+            auto const in = ints(1024 * 16);
+            for (size_t i = 0; i < in.size(); i += 5) {
+                std::vector<WpTask> tasks;
+                for (size_t j = i; j < std::min(i + 5, in.size()); ++j) {
+                    tasks.push_back(to_ptr(in[j]));
+                }
+                wp_add_tasks(pool, tasks.data(), tasks.size());
             }
-            wp_finish(pool1, NULL, NULL);
 
-            std::vector<int> all;
+            Batches all;
             wp_finish(
-                pool2,
-                [](void* bin_, void* all_) {
-                    auto* const bin = reinterpret_cast<Bin*>(bin_);
-                    auto* const all = reinterpret_cast<std::vector<int>*>(all_);
-                    all->insert(all->end(), bin->begin(), bin->end());
-                    delete bin;
+                pool,
+                [](void* batches_, void* all_) {
+                    auto* const batches = reinterpret_cast<Batches*>(batches_);
+                    auto* const all     = reinterpret_cast<Batches*>(all_);
+                    all->items.insert(all->items.end(),
+                                      batches->items.begin(),
+                                      batches->items.end());
+                    all->largest = std::max(all->largest, batches->largest);
+                    all->inOrder = all->inOrder && batches->inOrder;
+                    delete batches;
                 },
                 &all);
 
-            std::ranges::sort(all);
-            EXPECT_THAT(all, testing::ElementsAreArray(in))
-                << numWorkers1 << ":" << numWorkers2;
+            std::ranges::sort(all.items);
+            EXPECT_THAT(all.items, testing::ElementsAreArray(in))
+                << options.queueKind << " " << numWorkers;
+            EXPECT_LE(all.largest, maxBatch);
+            EXPECT_TRUE(all.inOrder);
+        }
+    }
+}
+
+namespace {
+struct Elastic {
+    std::atomic<int> done{0};
+    std::atomic<int> created{0};
+    std::atomic<int> destroyed{0};
+};
+
+// waiting on something, like a slow content_get
+void nap_(WpTask, void* elastic_) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{2});
+    ++reinterpret_cast<Elastic*>(elastic_)->done;
+}
+} // namespace
+
+TEST(WorkerPool, ElasticGrowsAndShrinks) {
+    for (WpQueueKind const kind : {WpMutexQueue, WpRingQueue}) {
+        size_t const    maxWorkers = 8;
+        WpOptions const options{.queueKind         = kind,
+                                .maxWorkers        = maxWorkers,
+                                .queueWaitTargetUs = 1000,
+                                .idleTimeoutUs     = 20 * 1000};
+        Elastic         elastic;
+        WorkerPool*     pool = wp_start_with(
+            &options,
+            1,
+            nap_,
+            [](void* elastic_) -> void* {
+                ++reinterpret_cast<Elastic*>(elastic_)->created;
+                return elastic_;
+            },
+            &elastic);
+
+        int const numTasks = 500;
+        for (int i = 0; i < numTasks; ++i) {
+            wp_add_task(pool, to_ptr(i));
+        }
+        // one worker would take a second
+        WpStats stats{};
+        while (elastic.done < numTasks) {
+            wp_stats(pool, &stats);
+            if (stats.numWorkers == maxWorkers) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+        EXPECT_EQ(stats.numWorkers, maxWorkers) << kind;
+        EXPECT_EQ(stats.spawned, maxWorkers - 1) << kind;
+
+        // back down to the one once they've had nothing to do for a while
+        while (elastic.done < numTasks) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+        for (int i = 0; i < 1000 && stats.numWorkers > 1; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            wp_stats(pool, &stats);
+        }
+        EXPECT_EQ(stats.numWorkers, 1u) << kind;
+        EXPECT_EQ(stats.retired, maxWorkers - 1) << kind;
+        EXPECT_EQ(stats.queued, 0u) << kind;
+
+        // and up again, with the data the stopped ones left
+        for (int i = 0; i < numTasks; ++i) {
+            wp_add_task(pool, to_ptr(i));
+        }
+        // wp_finish stops it growing
+        while (elastic.done < 2 * numTasks) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
         }
+        wp_stats(pool, &stats);
+        EXPECT_GT(stats.spawned, maxWorkers - 1) << kind;
+        wp_finish(
+            pool,
+            [](void* elastic_, void*) {
+                ++reinterpret_cast<Elastic*>(elastic_)->destroyed;
+            },
+            NULL);
+        EXPECT_EQ(elastic.done, 2 * numTasks) << kind;
+        EXPECT_LE(elastic.created, static_cast<int>(maxWorkers)) << kind;
+        EXPECT_EQ(elastic.destroyed, elastic.created) << kind;
     }
 }